@@ -0,0 +1,77 @@
+#include "pch.h"
+
+#include "ComActiveSet.h"
+
+#include <algorithm>
+
+void ActiveVertexSet::init(const std::vector<int> &adjOffset, const std::vector<int> &adjVert, double badQuality)
+{
+    vertNum_ = adjOffset.empty() ? 0 : static_cast<int>(adjOffset.size()) - 1;
+    badQuality_ = badQuality;
+    adjOffset_ = &adjOffset;
+    adjVert_ = &adjVert;
+    quality_.assign(vertNum_, 0.);
+    fixed_.assign(vertNum_, 0);
+    active_.reset(new std::atomic<unsigned char>[vertNum_]);
+    for (int v = 0; v < vertNum_; ++v)
+        active_[v].store(0, std::memory_order_relaxed);
+}
+
+void ActiveVertexSet::seed(const std::vector<double> &vertQuality, const std::vector<char> *fixed)
+{
+    for (int v = 0; v < vertNum_; ++v)
+    {
+        quality_[v] = vertQuality[v];
+        fixed_[v] = fixed ? (*fixed)[v] : 0;
+        active_[v].store((!fixed_[v] && quality_[v] < badQuality_) ? 1 : 0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<int> ActiveVertexSet::nextPass()
+{
+    std::vector<int> verts;
+    for (int v = 0; v < vertNum_; ++v)
+    {
+        if (active_[v].exchange(0, std::memory_order_relaxed))
+            verts.push_back(v);
+    }
+    std::sort(verts.begin(), verts.end(), [this](int a, int b) {
+        if (quality_[a] != quality_[b])
+            return quality_[a] < quality_[b];
+        return a < b; // 质量相同按编号排序，保证结果可重复
+    });
+    return verts;
+}
+
+void ActiveVertexSet::report(int v, double displacement, double epsX, double quality)
+{
+    quality_[v] = quality;
+    if (displacement > epsX)
+    {
+        activate(v);
+        for (int i = (*adjOffset_)[v]; i < (*adjOffset_)[v + 1]; ++i)
+            activate((*adjVert_)[i]);
+    }
+    // 位移不超过 epsX_ 视为已收敛：即使仍为劣质也不再自行激活，等待相邻顶点移动后再处理
+}
+
+void ActiveVertexSet::updateQuality(int v, double quality)
+{
+    quality_[v] = quality;
+    if (quality < badQuality_)
+        activate(v);
+}
+
+void ActiveVertexSet::activate(int v)
+{
+    if (!fixed_[v])
+        active_[v].store(1, std::memory_order_relaxed);
+}
+
+int ActiveVertexSet::activeNum() const
+{
+    int num = 0;
+    for (int v = 0; v < vertNum_; ++v)
+        num += active_[v].load(std::memory_order_relaxed) ? 1 : 0;
+    return num;
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComActiveSet.h
+// 摘    要：网格光滑活动集，跳过已收敛与质量良好的顶点，按最差质量优先排序
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMACTIVESET_H_
+#define EMMPMESH_COMMON_COMACTIVESET_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// 活动顶点集合
+// 顶点在以下情况被标记为活动：关联单元最差质量低于阈值；或其自身 / 相邻顶点的位移超过 epsX_。
+// 每次连续迭代（ConsecuIterNum_）只处理活动顶点，处理后清除标记，因此后续迭代规模迅速缩小
+class ActiveVertexSet
+{
+public:
+    ActiveVertexSet() = default;
+
+    /************************************************************************
+    * 功能描述：初始化，adjOffset / adjVert 为顶点邻接关系的 CSR 存储，
+    *           顶点 v 的相邻顶点为 adjVert[adjOffset[v], adjOffset[v+1])
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void init(const std::vector<int> &adjOffset, const std::vector<int> &adjVert, double badQuality);
+
+    /************************************************************************
+    * 功能描述：按每个顶点关联单元的最差质量初始化活动标记，低于阈值的顶点被激活；
+    *           fixed 非空时，fixed[v] 为真的顶点（如模型点）始终不激活
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void seed(const std::vector<double> &vertQuality, const std::vector<char> *fixed = nullptr);
+
+    /************************************************************************
+    * 功能描述：取出当前所有活动顶点，按关联单元最差质量升序（最差优先）排列，并清除其活动标记
+    * 返回值：std::vector<int> - 本次迭代需要优化的顶点
+    * 作者：邓龙威
+    /************************************************************************/
+    std::vector<int> nextPass();
+
+    /************************************************************************
+    * 功能描述：报告顶点 v 的优化结果（可多线程调用，每个顶点只由一个线程报告）。
+    *           位移超过 epsX 时激活 v 及其相邻顶点；否则视为已收敛，不再激活
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void report(int v, double displacement, double epsX, double quality);
+
+    /************************************************************************
+    * 功能描述：更新顶点 v 的关联单元最差质量（例如相邻顶点移动后重新计算），低于阈值时激活
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void updateQuality(int v, double quality);
+
+    /************************************************************************
+    * 功能描述：强制激活顶点 v
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void activate(int v);
+
+    int vertNum() const { return vertNum_; }
+    int activeNum() const;
+
+private:
+    int vertNum_ = 0;                                      // 顶点个数
+    double badQuality_ = 0.;                               // 劣质阈值（badRegionQuality_）
+    const std::vector<int> *adjOffset_ = nullptr;          // 邻接 CSR 偏移
+    const std::vector<int> *adjVert_ = nullptr;            // 邻接 CSR 顶点
+    std::vector<double> quality_;                          // 顶点关联单元最差质量
+    std::vector<char> fixed_;                              // 不参与优化的顶点
+    std::unique_ptr<std::atomic<unsigned char>[]> active_; // 活动标记
+};
+
+#endif // EMMPMESH_COMMON_COMACTIVESET_H_
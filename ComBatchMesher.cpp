@@ -0,0 +1,268 @@
+#include "pch.h"
+
+#include "ComBatchMesher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+
+int BatchMesher::parseManifest(const std::string &filePath, std::vector<BatchJob> &jobs)
+{
+    std::ifstream file(filePath);
+    if (!file.is_open())
+        return 1;
+
+    std::filesystem::path base = std::filesystem::path(filePath).parent_path();
+    auto resolve = [&base](const std::string &p) {
+        if (p.empty() || p == "-")
+            return std::string();
+        std::filesystem::path path(p);
+        return path.is_relative() ? (base / path).string() : p;
+    };
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        std::string fields[4];
+        int fieldNum = 0;
+        while (fieldNum < 4 && iss >> std::quoted(fields[fieldNum]))
+            ++fieldNum;
+        if (fieldNum == 0 || fields[0][0] == '#')
+            continue;
+
+        BatchJob job;
+        job.jobID_ = static_cast<int>(jobs.size());
+        job.modelFile_ = resolve(fields[0]);
+        job.configFile_ = resolve(fields[1]);
+        job.outputFile_ = resolve(fields[2]);
+        if (fieldNum == 4)
+        {
+            char *end = nullptr;
+            job.weight_ = std::strtod(fields[3].c_str(), &end);
+            if (end == fields[3].c_str() || *end != '\0')
+                return 2;
+        }
+        jobs.push_back(job);
+    }
+    return 0;
+}
+
+std::vector<BatchJobResult> BatchMesher::run(const std::vector<BatchJob> &jobs, const ComBatchRun &runFunc)
+{
+    auto batchStart = std::chrono::steady_clock::now();
+    auto since = [&batchStart](std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration<double>(t - batchStart).count();
+    };
+
+    int jobNum = static_cast<int>(jobs.size());
+    jobs_ = jobs;
+    results_.assign(jobNum, BatchJobResult{});
+    summary_ = BatchSummary{};
+
+    WorkStealPool pool(opts_.threadNum_);
+    int threadNum = pool.threadNum();
+    summary_.jobNum_ = jobNum;
+    summary_.threadNum_ = threadNum;
+
+    // 工作量：未给出时取模型文件大小，文件不存在时为 1
+    double totalWeight = 0.;
+    for (int i = 0; i < jobNum; ++i)
+    {
+        double w = jobs[i].weight_;
+        if (w <= 0.)
+        {
+            std::error_code ec;
+            auto size = std::filesystem::file_size(jobs[i].modelFile_, ec);
+            w = ec ? 1. : std::max(1., static_cast<double>(size));
+        }
+        results_[i].jobID_ = jobs[i].jobID_;
+        results_[i].weight_ = w;
+        totalWeight += w;
+    }
+
+    // 1. 并行读取各不相同的配置文件
+    std::map<std::string, std::unique_ptr<ComOptionsManager>> managers;
+    std::map<std::string, int> configStatus;
+    for (const auto &job : jobs)
+        managers.emplace(job.configFile_, nullptr);
+    std::vector<std::string> configFiles;
+    for (auto &kv : managers)
+    {
+        kv.second = std::make_unique<ComOptionsManager>();
+        configFiles.push_back(kv.first);
+    }
+    std::vector<int> loadStatus(configFiles.size(), 0);
+    pool.parallelFor(0, static_cast<int>(configFiles.size()), threadNum, [&](int, int first, int last) {
+        for (int i = first; i < last; ++i)
+        {
+            if (configFiles[i].empty())
+                continue;
+            // 配置值格式错误时 loadFromFile 内的 std::stoi / std::stod 抛出异常，按读取失败处理
+            try
+            {
+                loadStatus[i] = managers.at(configFiles[i])->loadFromFile(configFiles[i]);
+            }
+            catch (...)
+            {
+                loadStatus[i] = -1;
+            }
+        }
+    });
+    for (size_t i = 0; i < configFiles.size(); ++i)
+    {
+        configStatus[configFiles[i]] = loadStatus[i];
+        if (!configFiles[i].empty())
+            ++summary_.configNum_;
+    }
+    summary_.configSeconds_ = since(std::chrono::steady_clock::now());
+
+    // 2. 大作业分配并行度，小作业按工作量降序装包
+    std::vector<int> order(jobNum);
+    for (int i = 0; i < jobNum; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [this](int a, int b) { return results_[a].weight_ > results_[b].weight_; });
+
+    double share = jobNum > 0 ? totalWeight / threadNum : 1.;
+    int maxJobThreadNum = opts_.maxJobThreadNum_ > 0 ? std::min(opts_.maxJobThreadNum_, threadNum) : threadNum;
+    double packCapacity = std::max(0., opts_.packRatio_) * share;
+    std::vector<int> largeJobs;
+    std::vector<std::vector<int>> packs;
+    double packWeight = 0.;
+    for (int i : order)
+    {
+        double w = results_[i].weight_;
+        if (threadNum > 1 && w >= opts_.largeJobRatio_ * share)
+        {
+            int grant = static_cast<int>(std::lround(w / share));
+            results_[i].threadNum_ = std::max(2, std::min(maxJobThreadNum, grant));
+            largeJobs.push_back(i);
+            continue;
+        }
+        if (packs.empty() || packWeight + w > packCapacity)
+        {
+            packs.emplace_back();
+            packWeight = 0.;
+        }
+        results_[i].pack_ = static_cast<int>(packs.size()) - 1;
+        packs.back().push_back(i);
+        packWeight += w;
+    }
+    summary_.largeJobNum_ = static_cast<int>(largeJobs.size());
+    summary_.packNum_ = static_cast<int>(packs.size());
+
+    auto runJob = [&](int i) {
+        BatchJobResult &r = results_[i];
+        r.worker_ = pool.workerIndex();
+        auto start = std::chrono::steady_clock::now();
+        r.startSeconds_ = since(start);
+        if (configStatus.at(jobs[i].configFile_) != 0)
+        {
+            r.status_ = -1;
+            return;
+        }
+        BatchJobContext ctx;
+        ctx.pool_ = &pool;
+        ctx.threadNum_ = r.threadNum_;
+        try
+        {
+            r.status_ = runFunc(jobs[i], *managers.at(jobs[i].configFile_), ctx);
+        }
+        catch (...)
+        {
+            r.status_ = -2;
+        }
+        r.runSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // 3. 大作业先提交，小作业包随后，空闲线程窃取
+    for (int i : largeJobs)
+        pool.submit([&runJob, i] { runJob(i); });
+    for (const auto &pack : packs)
+    {
+        pool.submit([&runJob, &pack] {
+            for (int i : pack)
+                runJob(i);
+        });
+    }
+    pool.wait();
+
+    summary_.wallSeconds_ = since(std::chrono::steady_clock::now());
+    summary_.stealNum_ = pool.stealNum();
+    for (const auto &r : results_)
+    {
+        if (r.status_ == 0)
+            ++summary_.okNum_;
+        else
+            ++summary_.failNum_;
+        summary_.busySeconds_ += r.runSeconds_;
+        summary_.timeHist_.add(static_cast<long long>(r.runSeconds_ * 1e3));
+    }
+    if (summary_.wallSeconds_ > 0.)
+    {
+        summary_.jobsPerSecond_ = summary_.okNum_ / summary_.wallSeconds_;
+        summary_.weightPerSecond_ = totalWeight / summary_.wallSeconds_;
+    }
+    return results_;
+}
+
+std::string BatchMesher::jobToString(const BatchJob &job, const BatchJobResult &result, LogFileFormat format)
+{
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"job", ComTelemetryValue(result.jobID_)},
+        {"model", job.modelFile_},
+        {"status", ComTelemetryValue(result.status_)},
+        {"threads", ComTelemetryValue(result.threadNum_)},
+        {"worker", ComTelemetryValue(result.worker_)},
+        {"pack", ComTelemetryValue(result.pack_)},
+        {"weight", ComTelemetryValue(result.weight_)},
+        {"start", ComTelemetryValue(result.startSeconds_)},
+        {"seconds", ComTelemetryValue(result.runSeconds_)},
+    };
+    return ComTelemetryFields(fields, format);
+}
+
+std::string BatchMesher::summaryToString(const BatchSummary &summary, LogFileFormat format)
+{
+    double utilization = summary.wallSeconds_ > 0. && summary.threadNum_ > 0
+                             ? summary.busySeconds_ / (summary.wallSeconds_ * summary.threadNum_)
+                             : 0.;
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"jobs", ComTelemetryValue(summary.jobNum_)},
+        {"ok", ComTelemetryValue(summary.okNum_)},
+        {"failed", ComTelemetryValue(summary.failNum_)},
+        {"threads", ComTelemetryValue(summary.threadNum_)},
+        {"largeJobs", ComTelemetryValue(summary.largeJobNum_)},
+        {"packs", ComTelemetryValue(summary.packNum_)},
+        {"configs", ComTelemetryValue(summary.configNum_)},
+        {"configSeconds", ComTelemetryValue(summary.configSeconds_)},
+        {"wallSeconds", ComTelemetryValue(summary.wallSeconds_)},
+        {"busySeconds", ComTelemetryValue(summary.busySeconds_)},
+        {"jobsPerSec", ComTelemetryValue(summary.jobsPerSecond_)},
+        {"weightPerSec", ComTelemetryValue(summary.weightPerSecond_)},
+        {"utilization", ComTelemetryValue(utilization)},
+        {"ms.p50", ComTelemetryValue(summary.timeHist_.quantile(0.5))},
+        {"ms.p99", ComTelemetryValue(summary.timeHist_.quantile(0.99))},
+        {"steals", ComTelemetryValue(summary.stealNum_)},
+    };
+    return ComTelemetryFields(fields, format);
+}
+
+int BatchMesher::writeReport(const std::string &filePath, LogFileFormat format) const
+{
+    std::ofstream file(filePath);
+    if (!file.is_open())
+        return 1;
+    for (size_t i = 0; i < results_.size(); ++i)
+        file << jobToString(jobs_[i], results_[i], format) << "\n";
+    file << summaryToString(summary_, format) << "\n";
+    return file.good() ? 0 : 1;
+}
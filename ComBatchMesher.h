@@ -0,0 +1,137 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComBatchMesher.h
+// 摘    要：批量网格生成：读取作业清单（模型文件、配置文件、输出文件），在一个共享的工作窃取线程池上
+//           调度全部作业，大作业获得作业内并行度，小作业按工作量打包执行，输出每个作业的耗时与吞吐量汇总
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMBATCHMESHER_H_
+#define EMMPMESH_COMMON_COMBATCHMESHER_H_
+
+#include "ComOptionsManager.h"
+#include "ComOptiTelemetry.h"
+#include "ComThreadPool.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// 一个网格生成作业
+struct BatchJob
+{
+    int jobID_ = -1;         // 作业编号（清单中的序号）
+    std::string modelFile_;  // 模型文件
+    std::string configFile_; // 配置文件，为空时使用默认选项
+    std::string outputFile_; // 输出网格文件，为空时由生成回调决定
+    double weight_ = 0.;     // 估计工作量，<= 0 时取模型文件大小（字节）
+};
+
+// 批处理控制参数
+struct BatchMesherOptions
+{
+    int threadNum_ = 0;         // 共享线程池线程数，<= 0 时使用硬件并发数
+    double largeJobRatio_ = 1.; // 工作量不小于 largeJobRatio_ × 每线程平均工作量的作业为大作业，获得作业内并行度
+    int maxJobThreadNum_ = 0;   // 大作业的最大并行度，<= 0 时为线程数
+    double packRatio_ = 0.25;   // 小作业打包：每包工作量不超过 packRatio_ × 每线程平均工作量（至少一个作业）
+};
+
+// 作业执行环境：生成回调应以 threadNum_ 代替选项中的线程数，并通过 parallelFor 使用共享线程池
+struct BatchJobContext
+{
+    WorkStealPool *pool_ = nullptr; // 共享线程池
+    int threadNum_ = 1;             // 分配给本作业的并行度
+
+    /************************************************************************
+    * 功能描述：在共享线程池中以 threadNum_ 块并行执行循环，func 与 ComParallelFor 相同
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void parallelFor(int begin, int end, const std::function<void(int, int, int)> &func) const
+    {
+        pool_->parallelFor(begin, end, threadNum_, func);
+    }
+};
+
+// 网格生成回调：以 manager 中的选项生成 job 的网格，返回 0 表示成功；抛出的异常只使本作业失败
+using ComBatchRun = std::function<int(const BatchJob &job, const ComOptionsManager &manager, const BatchJobContext &ctx)>;
+
+// 单个作业的执行结果
+struct BatchJobResult
+{
+    int jobID_ = -1;           // 作业编号
+    int status_ = 0;           // 生成回调返回值，0 表示成功；-1 表示配置文件读取失败，未执行；-2 表示生成回调抛出异常
+    int threadNum_ = 1;        // 分配的作业内并行度
+    int worker_ = -1;          // 执行作业的工作线程
+    int pack_ = -1;            // 所在小作业包，大作业为 -1
+    double weight_ = 0.;       // 工作量
+    double startSeconds_ = 0.; // 开始时刻（秒，相对于批处理开始）
+    double runSeconds_ = 0.;   // 生成耗时（秒）
+};
+
+// 批处理汇总
+struct BatchSummary
+{
+    int jobNum_ = 0;              // 作业个数
+    int okNum_ = 0;               // 成功个数
+    int failNum_ = 0;             // 失败个数
+    int largeJobNum_ = 0;         // 大作业个数
+    int packNum_ = 0;             // 小作业包个数
+    int configNum_ = 0;           // 读取的配置文件个数（相同配置文件只读取一次）
+    int threadNum_ = 0;           // 线程池线程数
+    double configSeconds_ = 0.;   // 读取配置文件耗时（秒）
+    double wallSeconds_ = 0.;     // 总耗时（秒）
+    double busySeconds_ = 0.;     // 各作业生成耗时之和（秒）
+    double jobsPerSecond_ = 0.;   // 作业吞吐量
+    double weightPerSecond_ = 0.; // 工作量吞吐量
+    long long stealNum_ = 0;      // 线程池窃取次数
+    Log2Histogram timeHist_;      // 作业耗时分布（毫秒）
+};
+
+// 批量网格生成器
+class BatchMesher
+{
+public:
+    explicit BatchMesher(const BatchMesherOptions &opts) : opts_(opts) {}
+
+    /************************************************************************
+    * 功能描述：读取作业清单。每个非空行为一个作业：模型文件 [配置文件 [输出文件 [工作量]]]，
+    *           以空白分隔，含空格的路径可加双引号，"-" 表示该项为空；'#' 开头的行为注释。
+    *           相对路径相对于清单文件所在目录
+    * 返回值：0 表示成功，非 0 表示失败（1-文件无法打开，2-工作量格式错误）
+    * 作者：邓龙威
+    /************************************************************************/
+    static int parseManifest(const std::string &filePath, std::vector<BatchJob> &jobs);
+
+    /************************************************************************
+    * 功能描述：执行全部作业。
+    *           1. 并行读取各不相同的配置文件，相同配置文件的作业共享同一个 ComOptionsManager；
+    *           2. 作业按工作量降序，大作业的并行度为 min(maxJobThreadNum_, round(工作量 / 每线程平均工作量))，
+    *              每个大作业一个任务；其余作业依次装入小作业包，每包一个任务，包内串行执行；
+    *           3. 大作业先于小作业包提交，空闲线程从其他线程窃取任务
+    * 返回值：std::vector<BatchJobResult> - 与 jobs 一一对应
+    * 作者：邓龙威
+    /************************************************************************/
+    std::vector<BatchJobResult> run(const std::vector<BatchJob> &jobs, const ComBatchRun &runFunc);
+
+    const BatchSummary &summary() const { return summary_; }
+
+    /************************************************************************
+    * 功能描述：写出每个作业一行的耗时记录，最后一行为吞吐量汇总
+    * 返回值：0 表示成功，非 0 表示失败
+    * 作者：邓龙威
+    /************************************************************************/
+    int writeReport(const std::string &filePath, LogFileFormat format) const;
+
+    static std::string jobToString(const BatchJob &job, const BatchJobResult &result, LogFileFormat format);
+    static std::string summaryToString(const BatchSummary &summary, LogFileFormat format);
+
+private:
+    BatchMesherOptions opts_;             // 控制参数
+    std::vector<BatchJob> jobs_;          // 最近一次执行的作业
+    std::vector<BatchJobResult> results_; // 最近一次执行的结果
+    BatchSummary summary_;                // 最近一次执行的汇总
+};
+
+#endif // EMMPMESH_COMMON_COMBATCHMESHER_H_
@@ -0,0 +1,80 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComBinaryIO.h
+// 摘    要：缓存文件共用的二进制读写与 FNV-1a 散列：带长度前缀的数组读写，
+//           以及用于缓存指纹的链式 FNV-1a 64 位散列
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMBINARYIO_H_
+#define EMMPMESH_COMMON_COMBINARYIO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// FNV-1a 64 位散列的初始值
+inline constexpr uint64_t ComFnvOffset = 14695981039346656037ULL;
+
+/************************************************************************
+* 功能描述：FNV-1a 64 位散列，h 为上一段数据的散列值（链式调用）
+* 返回值：uint64_t
+* 作者：邓龙威
+/************************************************************************/
+inline uint64_t ComFnv1a(const void *data, size_t size, uint64_t h = ComFnvOffset)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// 按对象表示散列单个平凡类型的值
+template <typename T>
+uint64_t ComFnvValue(const T &v, uint64_t h = ComFnvOffset)
+{
+    return ComFnv1a(&v, sizeof(v), h);
+}
+
+/************************************************************************
+* 功能描述：写入数组：元素个数（uint64_t）后接按内存表示存储的元素，T 须为平凡类型
+* 返回值：无，写入失败由 file 的状态反映
+* 作者：邓龙威
+/************************************************************************/
+template <typename T>
+void ComWriteArray(std::ofstream &file, const std::vector<T> &v)
+{
+    uint64_t n = v.size();
+    file.write(reinterpret_cast<const char *>(&n), sizeof(n));
+    if (n > 0)
+        file.write(reinterpret_cast<const char *>(v.data()), static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+/************************************************************************
+* 功能描述：读取 ComWriteArray 写入的数组。元素总字节数超过文件剩余字节数时视为损坏，
+*           在分配内存之前返回，损坏的长度前缀不会导致巨大的分配
+* 返回值：bool - 是否读取成功
+* 作者：邓龙威
+/************************************************************************/
+template <typename T>
+bool ComReadArray(std::ifstream &file, std::vector<T> &v)
+{
+    uint64_t n = 0;
+    if (!file.read(reinterpret_cast<char *>(&n), sizeof(n)))
+        return false;
+    std::streamoff pos = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+    file.seekg(pos);
+    if (pos < 0 || end < pos || !file || n > static_cast<uint64_t>(end - pos) / sizeof(T))
+        return false;
+    v.resize(static_cast<size_t>(n));
+    return n == 0 || static_cast<bool>(file.read(reinterpret_cast<char *>(v.data()), static_cast<std::streamsize>(n * sizeof(T))));
+}
+
+#endif // EMMPMESH_COMMON_COMBINARYIO_H_
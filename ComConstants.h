@@ -16,6 +16,7 @@
 #include <map>
 
 #define STRLEN 512
+// 数值容差。方向、外接圆 / 外接球等几何判断不以 ZERO_* 判零，使用 ComPredicates.h 中的鲁棒谓词
 #define ZERO_1 1.0e-1
 #define ZERO_2 1.0e-2
 #define ZERO_3 1.0e-3
@@ -264,19 +265,29 @@ struct ModelFileOptions
 // 自适应网格选项
 struct AdaptiveMeshOptions
 {
-    double sampleSize_ = 0.1;          // 采样尺寸
+    double sampleSize_ = 0.1;          // 采样尺寸：尺寸场构建时按该边长的网格抽稀采样点，<= 0 时不抽稀
     double curvatureAngle_ = 20;       // 曲率角度（度）
     double minSize_ = 1.;              // 最小网格尺寸
     double maxSize_ = 10.;             // 最大网格尺寸
-    double refinementFactor_ = 0.5;    // 细化因子
-    double ratioFactor_ = 1.35;        // 比率因子
+    double refinementFactor_ = 0.5;    // 细化因子：尺寸场八叉树叶子边长不超过局部尺寸的该倍数
+    double ratioFactor_ = 1.35;        // 比率因子：相邻尺寸的梯度上限 h_j <= h_i + (ratioFactor_-1)·d_ij，<= 1 时不做梯度控制
     int selfAdaption_ = 0;             // 自适应标志：0-禁用，1-启用
     double highCurvatureSampling_ = 0; // 高曲率采样密度
+    int octreeMaxDepth_ = 12;          // 八叉树最大深度
+    int sizingThreadNum_ = 0;          // 尺寸场构建线程数，<= 0 时使用硬件并发数
+    std::string sizingCacheFile_;      // 尺寸场缓存文件（见 SizingOctree::loadOrBuild），非空时优先加载，不一致时重新构建并保存
 };
 
 // 线网格生成选项
 struct EdgeMeshGenerationOptions
 {
+    int tableSegmentNum_ = 16;       // 弧长表初始分段数（参数等分）
+    int maxTableSegmentNum_ = 4096;  // 弧长表最大分段数
+    double tableTolerance_ = 1e-6;   // 弧长表分段的相对误差（相对于模型边长度）
+    double tableMaxTurnAngle_ = 5.;  // 弧长表相邻采样点切向最大夹角（度），超过时继续细分
+    bool curvatureSizing_ = true;    // 节点尺寸同时受曲率尺寸（ComCurvatureSize）限制
+    int minSegmentNum_ = 1;          // 每条模型边的最少线网格个数
+    int threadNum_ = 0;              // 模型边并行离散线程数（ComEdgeMesh.h），<= 0 时使用硬件并发数，1 为串行
 };
 
 // 面网格生成选项
@@ -285,12 +296,37 @@ struct SurfMeshGenerationOptions
     bool selfAdaption_ = true;     // 自适应曲面网格生成
     bool meshOptimization_ = true; // 网格质量优化（每生成一个模型曲面网格后进行优化）
     bool efficiency_ = true;       // 高效率生成
+    int threadNum_ = 0;            // 模型面并行生成线程数（ComSurfParallel.h），<= 0 时使用硬件并发数，1 为串行
+    bool incremental_ = false;     // 增量生成：按模型边 / 面指纹复用缓存的网格（ComRemeshCache.h）
+    std::string meshCacheDir_;     // 网格缓存目录，增量生成时有效
+};
+
+// Delaunay 逐点插入顺序
+enum class DelaunayInsertOrder
+{
+    INPUT = 0,   // 输入顺序
+    RANDOM = 1,  // 随机顺序
+    HILBERT = 2, // Hilbert 曲线顺序
+    BRIO = 3,    // 有偏随机插入顺序（Biased Randomized Insertion Order），每轮内按 Hilbert 曲线排序
 };
 
 // 体网格生成选项
 struct VolumMeshGenerationOptions
 {
-    bool meshOptimization_ = true; // 网格质量优化（每生成一个模型体网格后进行优化）
+    bool meshOptimization_ = true;                                // 网格质量优化（每生成一个模型体网格后进行优化）
+    int threadNum_ = 0;                                           // 区域分解并行剖分线程数（ComParallelDelaunay.h），<= 0 时使用硬件并发数
+    int partitionNum_ = 0;                                        // 子区域个数，<= 0 时为线程数的 4 倍
+    DelaunayInsertOrder insertOrder_ = DelaunayInsertOrder::BRIO; // 逐点插入顺序
+    unsigned int insertSeed_ = 0;                                 // RANDOM / BRIO 的随机种子
+};
+
+// 生成时间预算选项（ComTimeBudget.h）
+struct MeshTimeBudgetOptions
+{
+    double timeBudget_ = 0.;     // 单个作业的时间预算（秒），<= 0 表示不限制
+    double budgetMargin_ = 0.1;  // 预留比例：按预算的 (1 - budgetMargin_) 选择质量级别
+    bool autoDegrade_ = true;    // 预计超出预算时逐级降低质量级别
+    bool hardDeadline_ = true;   // 超出预算时请求协作式取消，未完成的阶段尽快返回
 };
 
 // 网格生成选项
@@ -300,6 +336,7 @@ struct MeshGenerationOptions
     EdgeMeshGenerationOptions edgeMeshGenerationOptions_;   // 线网格生成选项
     SurfMeshGenerationOptions surfMeshGenerationOptions_;   // 面网格生成选项
     VolumMeshGenerationOptions volumMeshGenerationOptions_; // 体网格生成选项
+    MeshTimeBudgetOptions timeBudgetOptions_;               // 生成时间预算选项
 };
 
 // =============================== 网格优化选项 ===============================
@@ -457,7 +494,30 @@ struct QuasiNewtonOptions
     int maxIter_ = 7;    // 最大迭代次数，设置为 0 则不限制迭代次数
     int varNum_ = 0;     // 变量个数
 
-    int m_ = 5; // L-BFGS 中，历史信息的存储个数，默认为 varNum_ > 5 ? 5 : varNum_
+    int m_ = 5;               // L-BFGS 中，历史信息的存储个数，默认为 varNum_ > 5 ? 5 : varNum_
+    bool warmStart_ = false;  // L-BFGS 是否在同一 patch 的连续迭代（ConsecuIterNum_）之间保留曲率对，默认不保留（每次从单位阵开始）
+
+    LineSearchOptions lineSearchOpti_{}; // 线搜索相关参数
+};
+
+// 带约束优化（MeshSmoothType::MinNLC）相关参数：增广拉格朗日法，内层为带盒约束的投影 L-BFGS
+// 约束 c_i(x) >= 0 主要为单元体积下界，盒约束来自模型（如参数区间），用于代替对数屏障进行网格解缠
+struct MinNLCOptions
+{
+    double rho_ = 10.;          // 初始罚参数
+    double rhoFactor_ = 10.;    // 罚参数放大倍数
+    double rhoDecrease_ = 0.25; // 约束违反量未降至上一外层迭代的 rhoDecrease_ 倍时放大罚参数
+    double rhoMax_ = 1e8;       // 罚参数上限
+    double feasTol_ = 1e-6;     // 约束违反容差，max{-c_i(x)} <= feasTol_ 视为可行
+    double minVolume_ = 1e-3;   // 单元体积约束下界，相对于空腔平均单元体积的比例
+    int outerIter_ = 20;        // 外层（乘子更新）最大迭代次数
+
+    double epsG_ = 1e-8; // 内层投影梯度范数阈值，满足 ||P(X-∇L)-X||<=epsG_ 则停止内层迭代
+    double epsF_ = 0.;   // 内层函数值更新阈值，满足 |L(k+1)-L(k)|<=epsF_*max{|L(k)|,|L(k+1)|,1} 则停止内层迭代
+    double epsX_ = 1e-8; // 内层变量更新阈值，满足 ||X(k+1)-X(k)||<=epsX_ 则停止内层迭代
+    int maxIter_ = 50;   // 内层最大迭代次数，设置为 0 则不限制迭代次数
+    int varNum_ = 0;     // 变量个数
+    int m_ = 5;          // 内层 L-BFGS 历史信息的存储个数
 
     LineSearchOptions lineSearchOpti_{}; // 线搜索相关参数
 };
@@ -471,6 +531,20 @@ struct MeshOptiAlgorithmOptions
     ConjugateGradientOptions cgOptions_{}; // 共轭梯度法相关参数
     bool useQN_ = false;                   // 是否使用拟牛顿法，默认不使用
     QuasiNewtonOptions qnOptions_{};       // 拟牛顿法相关参数
+    MinNLCOptions nlcOptions_{};           // 带约束优化相关参数，smoothType_ 为 MeshSmoothType::MinNLC 时由 ComUntangleCavity 经 MinNLCSolver(const MeshOptiOptions &) 使用
+
+    bool adaptiveSwitch_ = false; // 是否自适应切换算法：从代价最低的已开启算法（GD）开始，下降缓慢时逐级升级到 CG / QN，默认不切换
+    double switchRate_ = 0.05;    // 切换下降率阈值，相对下降 (F(k)-F(k+1))/max{|F(k)|,|F(k+1)|,1} 低于该值视为下降缓慢
+    int switchWindow_ = 2;        // 连续下降缓慢的迭代步数达到该值时升级算法
+};
+
+// 网格拓扑优化相关参数（ComTopoFlip.h）
+struct MeshTopoOptiOptions
+{
+    bool useFlip23_ = true;      // 是否使用 2-3 翻转（面删除）
+    bool useEdgeRemoval_ = true; // 是否使用边删除（环绕 3 个顶点即 3-2 翻转，4 个顶点即 4-4 翻转）
+    int maxEdgeRing_ = 7;        // 边删除允许的最大环绕顶点数，3 表示只做 3-2 翻转，4 表示再加 4-4 翻转
+    double minImprove_ = 1e-3;   // 最差单元质量改善阈值，改善量不超过该值的操作不执行
 };
 
 // 网格质量优化相关参数
@@ -500,14 +574,31 @@ struct MeshOptiOptions
     CalculateWay calculateWay_ = CalculateWay::P_NORM; // 目标函数计算方式，默认使用加权后网格质量函数向量的 p 范数
     double p_ = 2.0;                                   // p 范数的 p 值，默认使用 p=2
     bool meshLegality_ = false;                        // 是否优化时，检查网格合法性，默认不检查。可以在【非网格解缠】环境中开启，避免由于某些网格质量函数导致的网格不合法问题；使用 CalculateWay::P_NORM 时建议开启
+    bool legalityScan_ = false;                        // 是否在优化结束后并行扫描整个网格的合法性（ComScanMeshLegality），用于验证结果，默认不扫描
     bool useLogBarrier_ = false;                       // 是否使用对数屏障函数，默认不使用
     double logBarrier_ = 0.2;                          // 对数屏障函数的系数，默认值为0.2
+    bool incrementalObjective_ = false;                // 是否使用增量目标函数（ComIncObjective.h）：缓存单元项，顶点移动时只更新关联单元的 p 范数项与屏障项，PATCH_REGION / ALL_REGION 收益最大
+    int objectiveRecomputeInterval_ = 64;              // 增量目标函数的精确重算间隔（提交次数），用于限制累积误差，0 表示不定期重算
+    bool autoDiff_ = false;                            // 是否使用前向自动微分（ComDual.h）计算网格质量函数梯度，默认使用解析梯度；未提供解析梯度的质量函数总是使用自动微分
 
     // EMeshOptiSmooth.h
     MeshSmoothType smoothType_ = MeshSmoothType::CONJUGATE_GRADIENT; // 网格优化光滑化方法，默认使用共轭梯度法
     MeshSmoothWay smoothWay_ = MeshSmoothWay::SIGLE_VERT;            // 网格优化光滑化方式，默认一次优化单个顶点
     double badRegionQuality_ = 0.3;                                  // 劣质网格单元质量阈值，默认值为0.3，角度相关则是40°
+    bool paramSmooth_ = false;                                       // 是否在参数空间光滑边界顶点：模型边顶点沿 tParam 一维优化，模型面顶点在局部 (u,v) 切平面二维优化，仅在结束时投影一次
     int ConsecuIterNum_ = 7;                                         // 连续迭代次数，默认值为7
+    int threadNum_ = 0;                                              // 并行优化线程数，0 表示使用硬件并发数；工作空间池按线程数与最大空腔一次性分配
+    bool deterministic_ = false;                                     // 是否使用确定性并行归约（ComReduce.h 的 ComReduceSum / ComReducePowSum / ComReduceQualityStat 与 IncrementalObjective::init(opts) 读取）：目标函数求和、梯度散射与质量统计的结果与线程数无关，逐位一致
+    int multilevelNum_ = 1;                                          // 多层光滑层数（含最细层），由 ComMultilevelSmooth（ComMultilevel.h）读取：大于 1 时先在粗化顶点集上光滑，再将位移插值到细层；1 表示只在最细层光滑。内置的光滑流程不读取该项
+    int multilevelMinVert_ = 1000;                                   // 多层光滑最粗层的最少顶点数，粗化后顶点数少于该值时停止粗化（由 ComMultilevelSmooth 读取）
+    int topoOptiInterval_ = 0;                                       // 拓扑优化与光滑交替进行（ComTopoFlip.h，ComSmoothWithTopoOpti）：每 topoOptiInterval_ 次连续迭代后进行一次并行翻转 / 边删除，0 表示不使用；翻转按调用方传入的 ComTetQuality 回调评价单元，本选项不读取 meshQualityMetric_，调用方应以 meshQualityMetric_[Region] 构造该回调
+    MeshTopoOptiOptions topoOptiOptions_{};                          // 网格拓扑优化相关参数
+    bool localRemesh_ = false;                                       // 光滑结束后仍低于 badRegionQuality_ 的单元簇是否局部重剖分（ComLocalRemesh.h），代替整体重新生成体网格
+    int remeshGrowLayer_ = 1;                                        // 劣质单元向外扩展的层数，扩展后的连通区域即为重剖分空腔
+    int remeshMaxClusterSize_ = 500;                                 // 单个空腔的最多单元个数，超过时跳过该簇
+    bool telemetry_ = false;                                         // 是否记录优化遥测（ComOptiTelemetry.h）：迭代步数、求值次数、线搜索试探次数与停止原因按 LogLevel::Stat 输出，耗时按 LogLevel::Perf 输出（MinNLCSolver::setTelemetry / flushTelemetry）
+    int telemetrySample_ = 64;                                       // 遥测采样间隔：每 telemetrySample_ 次求解计时一次并记录直方图，1 表示每次求解都计时
+    bool activeSet_ = false;                                         // 是否使用活动集：每次连续迭代只优化相邻顶点移动过或关联单元质量低于 badRegionQuality_ 的顶点，最差优先；位移小于 epsX_ 的顶点视为收敛
 
     MeshOptiAlgorithmOptions meshOptiAlgorithmOptions_{}; // 网格质量优化算法相关参数
 };
@@ -734,12 +825,25 @@ struct MeshTetViewIOOptions
     bool outReg_ = true;   // 是否输出体文件
 };
 
+// VTK XML 二进制输出的数据压缩方式
+enum class VTKCompressor
+{
+    NONE = 0, // 不压缩
+    ZLIB = 1, // zlib（vtkZLibDataCompressor），需定义 EMMPMESH_WITH_ZLIB
+    LZ4 = 2,  // LZ4（vtkLZ4DataCompressor），需定义 EMMPMESH_WITH_LZ4
+};
+
 // 网格 VTK 格式输入输出相关参数
 struct MeshVTKIOOptions
 {
     bool xml_ = true;    // VTK 文件类型：true 表示使用 XML 格式（.vtu）；false 表示使用 Legacy 格式（.vtk）
     bool binary_ = true; // VTK 文件格式：true 表示使用二进制格式；false 表示使用 ASCII 格式
 
+    VTKCompressor compressor_ = VTKCompressor::NONE; // XML 二进制输出的分块压缩方式（ComVTUWriter.h），所选压缩库未编译时不压缩（VTUWriteStat::fallback_）
+    int compressLevel_ = 1;                          // 压缩级别：ZLIB 为 1~9，LZ4 为加速因子（>= 1，越大越快、压缩率越低）
+    int blockSize_ = 1 << 20;                        // 压缩块大小（字节，压缩前），按 8 字节对齐，最小 4096
+    int threadNum_ = 0;                              // 并行压缩线程数，<= 0 时使用硬件并发数
+
     // 网格输入
 
     // 网格输出
@@ -837,6 +941,9 @@ enum class LogFileFormat
     Logfmt, // logfmt 格式（严格 key=value 串）
 };
 
+// 日志输出回调：level 为日志级别，message 为 key=value 形式（或按 LogFileFormat 格式化）的消息
+using ComLogSink = std::function<void(LogLevel level, const std::string &message)>;
+
 // 日志文件格式对应扩展名
 inline const char *LogFileFormatExt(LogFileFormat f)
 {
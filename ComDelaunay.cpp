@@ -0,0 +1,480 @@
+#include "pch.h"
+
+#include "ComDelaunay.h"
+#include "ComHilbert.h"
+#include "ComPredicates.h"
+#include "ComTetFace.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+// 选取 4 个不共面的点作为初始四面体：离点 0 最远的点、离两点连线最远的点、离三点平面最远的点
+static bool ComInitialTet(const double *coords, int pointNum, int v[4])
+{
+    if (pointNum < 4)
+        return false;
+    auto dist2 = [coords](int a, int b) {
+        double d = 0.;
+        for (int j = 0; j < 3; ++j)
+            d += (coords[3 * a + j] - coords[3 * b + j]) * (coords[3 * a + j] - coords[3 * b + j]);
+        return d;
+    };
+    auto cross2 = [coords](int a, int b, int c) {
+        const double *pa = coords + 3 * a, *pb = coords + 3 * b, *pc = coords + 3 * c;
+        double u[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+        double w[3] = {pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2]};
+        double n[3] = {u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0]};
+        return n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+    };
+
+    v[0] = 0;
+    v[1] = v[2] = v[3] = -1;
+    double best = 0.;
+    for (int i = 1; i < pointNum; ++i)
+    {
+        double d = dist2(v[0], i);
+        if (d > best)
+        {
+            best = d;
+            v[1] = i;
+        }
+    }
+    if (v[1] < 0)
+        return false;
+    best = 0.;
+    for (int i = 1; i < pointNum; ++i)
+    {
+        double d = cross2(v[0], v[1], i);
+        if (d > best)
+        {
+            best = d;
+            v[2] = i;
+        }
+    }
+    if (v[2] < 0)
+        return false;
+    best = 0.;
+    const double *pa = coords + 3 * v[0], *pb = coords + 3 * v[1], *pc = coords + 3 * v[2];
+    for (int i = 1; i < pointNum; ++i)
+    {
+        double d = std::fabs(ComOrient3dFast(pa, pb, pc, coords + 3 * i));
+        if (d > best)
+        {
+            best = d;
+            v[3] = i;
+        }
+    }
+    // 浮点体积全为 0 时以精确谓词查找
+    for (int i = 0; i < pointNum && (v[3] < 0 || ComOrient3d(pa, pb, pc, coords + 3 * v[3]) == 0); ++i)
+        v[3] = i;
+    int s = ComOrient3d(pa, pb, pc, coords + 3 * v[3]);
+    if (s == 0)
+        return false;
+    if (s < 0)
+        std::swap(v[0], v[1]);
+    return true;
+}
+
+void DelaunayKernel::init(const double *coords, int pointNum, const int *rank)
+{
+    coords_ = coords;
+    pointNum_ = pointNum;
+    rank_ = rank;
+    tv_.clear();
+    tn_.clear();
+    dead_.clear();
+    free_.clear();
+    mark_.clear();
+    gen_ = 0;
+    last_ = 0;
+    vertTet_.assign(pointNum + 1, -1);
+    walkStat_ = DelaunayWalkStat();
+
+    int v[4];
+    if (!ComInitialTet(coords, pointNum, v))
+        return;
+
+    // 单元 0 为初始四面体，单元 1 + k 为其第 k 个面外侧的无穷单元（面反向 + 无穷远点）
+    for (int t = 0; t < 5; ++t)
+        allocTet();
+    std::copy(v, v + 4, tv_.begin());
+    for (int k = 0; k < 4; ++k)
+    {
+        const int *f = ComTetFaceVert[k];
+        int *gv = tv_.data() + 4 * (1 + k);
+        gv[0] = v[f[0]];
+        gv[1] = v[f[2]];
+        gv[2] = v[f[1]];
+        gv[3] = pointNum;
+        tn_[k] = 1 + k;
+        tn_[4 * (1 + k) + 3] = 0;
+        vertTet_[v[k]] = 0;
+    }
+    vertTet_[pointNum] = 1;
+    // 无穷单元之间沿含无穷远点的面相邻
+    for (int a = 1; a < 5; ++a)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            std::array<int, 3> key = ComFaceReverse(ComTetFace(tv_.data() + 4 * a, i));
+            for (int b = 1; b < 5; ++b)
+            {
+                for (int j = 0; j < 3 && b != a; ++j)
+                {
+                    if (ComTetFace(tv_.data() + 4 * b, j) == key)
+                        tn_[4 * a + i] = b;
+                }
+            }
+        }
+    }
+}
+
+int DelaunayKernel::finiteFace(int t) const
+{
+    for (int k = 0; k < 4; ++k)
+    {
+        if (tv_[4 * t + k] == pointNum_)
+            return k;
+    }
+    return -1;
+}
+
+bool DelaunayKernel::conflict(int t, int u) const
+{
+    const int *v = tv_.data() + 4 * t;
+    const double *p = point(u);
+    int k = finiteFace(t);
+    if (k < 0)
+    {
+        int r[5] = {rank(v[0]), rank(v[1]), rank(v[2]), rank(v[3]), rank(u)};
+        return ComInspherePerturbed(point(v[0]), point(v[1]), point(v[2]), point(v[3]), p, r) > 0;
+    }
+
+    // 无穷单元：p 位于凸包面外侧，或与凸包面共面且在其外接圆内
+    const int *f = ComTetFaceVert[k];
+    const double *pa = point(v[f[0]]), *pb = point(v[f[1]]), *pc = point(v[f[2]]);
+    int s = ComOrient3d(pa, pb, pc, p);
+    if (s != 0)
+        return s > 0;
+    // 共面时以内侧相邻单元的对顶点 q 构造球面：该球与凸包面所在平面的交线即外接圆。
+    // 共圆的扰动中以 p 替换 q 的体积恒为 0，结果只取决于面顶点与 p 的 rank，与 q 无关
+    int n = tn_[4 * t + k];
+    const int *nv = tv_.data() + 4 * n;
+    int q = nv[0] + nv[1] + nv[2] + nv[3] - v[f[0]] - v[f[1]] - v[f[2]];
+    int r[5] = {rank(v[f[1]]), rank(v[f[0]]), rank(v[f[2]]), rank(q), rank(u)};
+    return ComInspherePerturbed(pb, pa, pc, point(q), p, r) > 0;
+}
+
+bool DelaunayKernel::visible(int t, int k, int n, const double *p) const
+{
+    const int *v = tv_.data() + 4 * t;
+    const int *f = ComTetFaceVert[k];
+    int face[3] = {v[f[0]], v[f[1]], v[f[2]]};
+    int inf = face[0] == pointNum_ ? 0 : (face[1] == pointNum_ ? 1 : (face[2] == pointNum_ ? 2 : -1));
+    if (inf < 0)
+        return ComOrient3d(point(face[0]), point(face[1]), point(face[2]), p) > 0;
+
+    // 含无穷远点的面 (x, y, ∞)：新凸包面 (x, y, p) 与外侧无穷单元 n 的凸包面 (x, y, z) 须构成凸的
+    // 折角，即以 z 代替无穷远点后体积为负；二者共面时要求 p 与 z 位于边 xy 的两侧
+    const int *nv = tv_.data() + 4 * n;
+    int x = face[(inf + 1) % 3], y = face[(inf + 2) % 3];
+    int z = nv[0] + nv[1] + nv[2] + nv[3] - face[0] - face[1] - face[2];
+    face[inf] = z;
+    int s = ComOrient3d(point(face[0]), point(face[1]), point(face[2]), p);
+    if (s != 0)
+        return s < 0;
+    // 以 n 内侧相邻单元的对顶点 q（不在该平面上）构造过 xy 的横截平面
+    int m = tn_[4 * n + finiteFace(n)];
+    const int *mv = tv_.data() + 4 * m;
+    int q = mv[0] + mv[1] + mv[2] + mv[3] - x - y - z;
+    return ComOrient3d(point(x), point(y), point(q), p) * ComOrient3d(point(x), point(y), point(q), point(z)) < 0;
+}
+
+int DelaunayKernel::allocTet()
+{
+    if (!free_.empty())
+    {
+        int t = free_.back();
+        free_.pop_back();
+        dead_[t] = 0;
+        return t;
+    }
+    int t = static_cast<int>(dead_.size());
+    dead_.push_back(0);
+    mark_.push_back(0);
+    tv_.resize(tv_.size() + 4);
+    tn_.resize(tn_.size() + 4);
+    return t;
+}
+
+int DelaunayKernel::locate(const double *p, int start)
+{
+    int t = start;
+    // 起始面轮换，避免退化位置上的循环行走
+    for (unsigned int step = 0;; ++step)
+    {
+        const int *v = tv_.data() + 4 * t;
+        int next = -1;
+        int inf = finiteFace(t);
+        if (inf >= 0)
+        {
+            // 无穷单元：p 严格位于凸包面外侧时即为所求，否则进入内侧的有限单元
+            const int *f = ComTetFaceVert[inf];
+            if (ComOrient3d(point(v[f[0]]), point(v[f[1]]), point(v[f[2]]), p) <= 0)
+                next = tn_[4 * t + inf];
+        }
+        for (int i = 0; i < 4 && next < 0 && inf < 0; ++i)
+        {
+            int k = (step + i) & 3;
+            const int *f = ComTetFaceVert[k];
+            if (ComOrient3d(point(v[f[0]]), point(v[f[1]]), point(v[f[2]]), p) < 0)
+                next = tn_[4 * t + k];
+        }
+        if (next < 0)
+        {
+            walkStat_.add(static_cast<int>(step));
+            return t;
+        }
+        t = next;
+    }
+}
+
+int DelaunayKernel::insert(int v, int hint)
+{
+    if (dead_.empty())
+        return -1; // 全部点共面，没有初始四面体
+    if (regionID(v) >= 0)
+        return regionID(v); // 初始四面体的顶点
+    const double *p = point(v);
+    int start = hint >= 0 && hint < static_cast<int>(dead_.size()) && !dead_[hint] ? hint : last_;
+    if (dead_[start])
+    {
+        for (start = 0; dead_[start]; ++start)
+        {
+        }
+    }
+    int t0 = locate(p, start);
+    for (int k = 0; k < 4; ++k)
+    {
+        const double *q = point(tv_[4 * t0 + k]);
+        if (q && q[0] == p[0] && q[1] == p[1] && q[2] == p[2])
+            return -1;
+    }
+
+    // 空腔：外接球包含 p 的连通四面体；边界面对 p 不严格可见时也并入空腔，保证星形
+    gen_ += 2;
+    const unsigned int in = gen_, out = gen_ + 1;
+    cavity_.assign(1, t0);
+    mark_[t0] = in;
+    bound_.clear();
+    for (size_t i = 0; i < cavity_.size(); ++i)
+    {
+        int c = cavity_[i];
+        for (int k = 0; k < 4; ++k)
+        {
+            int n = tn_[4 * c + k];
+            if (n >= 0 && mark_[n] == in)
+                continue;
+            const int *f = ComTetFaceVert[k];
+            const int *cv = tv_.data() + 4 * c;
+            if (n >= 0)
+            {
+                if (!visible(c, k, n, p) || (mark_[n] != out && conflict(n, v)))
+                {
+                    mark_[n] = in;
+                    cavity_.push_back(n);
+                    continue;
+                }
+                mark_[n] = out;
+            }
+            bound_.insert(bound_.end(), {c, k, n, -1, cv[f[0]], cv[f[1]], cv[f[2]]});
+        }
+    }
+
+    // 边界面可能因后续并入空腔而失效，重新筛选并记录外侧单元中的面编号
+    size_t boundNum = 0;
+    for (size_t i = 0; i < bound_.size(); i += 7)
+    {
+        int n = bound_[i + 2];
+        if (n >= 0 && mark_[n] == in)
+            continue;
+        if (n >= 0)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                if (tn_[4 * n + j] == bound_[i])
+                    bound_[i + 3] = j;
+            }
+        }
+        std::copy(bound_.begin() + i, bound_.begin() + i + 7, bound_.begin() + boundNum);
+        boundNum += 7;
+    }
+    bound_.resize(boundNum);
+
+    // 由边界面构造新四面体 (f0, f1, f2, v)，面 3 对应空腔外侧
+    for (int c : cavity_)
+    {
+        dead_[c] = 1;
+        free_.push_back(c);
+    }
+
+    side_.clear();
+    int made = -1;
+    for (size_t i = 0; i < boundNum; i += 7)
+    {
+        int t = allocTet();
+        const int *f = bound_.data() + i + 4;
+        int *tv = tv_.data() + 4 * t;
+        tv[0] = f[0];
+        tv[1] = f[1];
+        tv[2] = f[2];
+        tv[3] = v;
+        vertTet_[f[0]] = vertTet_[f[1]] = vertTet_[f[2]] = t;
+        int n = bound_[i + 2];
+        tn_[4 * t + 3] = n;
+        if (n >= 0)
+            tn_[4 * n + bound_[i + 3]] = t;
+        // 面 j（j < 3）包含 v 与另两个面顶点构成的边
+        for (int j = 0; j < 3; ++j)
+        {
+            long long a = f[(j + 1) % 3], b = f[(j + 2) % 3];
+            long long key = std::min(a, b) * (static_cast<long long>(pointNum_) + 1) + std::max(a, b);
+            side_.push_back({key, 4 * t + j});
+        }
+        made = t;
+    }
+    std::sort(side_.begin(), side_.end());
+    for (size_t i = 0; i + 1 < side_.size(); i += 2)
+    {
+        int a = side_[i].second, b = side_[i + 1].second;
+        tn_[a] = b / 4;
+        tn_[b] = a / 4;
+    }
+
+    if (made >= 0)
+        vertTet_[v] = made;
+    last_ = made;
+    return made;
+}
+
+void DelaunayKernel::extract(std::vector<int> &tets, bool withInfinite) const
+{
+    tets.clear();
+    for (size_t t = 0; t < dead_.size(); ++t)
+    {
+        if (dead_[t])
+            continue;
+        const int *v = tv_.data() + 4 * t;
+        if (!withInfinite && (isInfinite(v[0]) || isInfinite(v[1]) || isInfinite(v[2]) || isInfinite(v[3])))
+            continue;
+        tets.insert(tets.end(), v, v + 4);
+    }
+}
+
+void DelaunayKernel::extract(std::vector<int> &tets, std::vector<int> &regionID, bool withInfinite) const
+{
+    extract(tets, withInfinite);
+    regionID.assign(pointNum_, -1);
+    int tetNum = static_cast<int>(tets.size() / 4);
+    for (int t = 0; t < tetNum; ++t)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            int v = tets[4 * t + j];
+            if (v < pointNum_ && regionID[v] < 0)
+                regionID[v] = t;
+        }
+    }
+}
+
+void ComInsertOrder(const double *coords, int pointNum, DelaunayInsertOrder order, int threadNum, unsigned int seed,
+                    std::vector<int> &index)
+{
+    index.resize(pointNum);
+    for (int i = 0; i < pointNum; ++i)
+        index[i] = i;
+    switch (order)
+    {
+    case DelaunayInsertOrder::RANDOM:
+        ComRandomShuffle(index, seed);
+        break;
+    case DelaunayInsertOrder::HILBERT:
+        ComHilbertSort(coords, index, threadNum);
+        break;
+    case DelaunayInsertOrder::BRIO:
+        ComBrioSort(coords, index, threadNum, seed);
+        break;
+    default:
+        break;
+    }
+}
+
+DelaunayBenchResult ComDelaunayInsertBench(const double *coords, int pointNum, DelaunayInsertOrder order,
+                                           int threadNum, unsigned int seed)
+{
+    DelaunayBenchResult result;
+    result.order_ = order;
+    result.pointNum_ = pointNum;
+
+    auto clock = std::chrono::steady_clock::now();
+    auto lap = [&clock]() {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - clock).count();
+        clock = now;
+        return seconds;
+    };
+
+    std::vector<int> index;
+    ComInsertOrder(coords, pointNum, order, threadNum, seed, index);
+    result.orderSeconds_ = lap();
+
+    DelaunayKernel kernel;
+    kernel.init(coords, pointNum);
+    for (int v : index)
+        kernel.insert(v);
+    result.insertSeconds_ = lap();
+
+    std::vector<int> tets;
+    kernel.extract(tets);
+    result.tetNum_ = static_cast<int>(tets.size() / 4);
+    result.walk_ = kernel.walkStat();
+    double seconds = result.orderSeconds_ + result.insertSeconds_;
+    result.pointsPerSecond_ = seconds > 0. ? pointNum / seconds : 0.;
+    return result;
+}
+
+static std::string ComInsertOrderName(DelaunayInsertOrder order)
+{
+    switch (order)
+    {
+    case DelaunayInsertOrder::INPUT:
+        return "INPUT";
+    case DelaunayInsertOrder::RANDOM:
+        return "RANDOM";
+    case DelaunayInsertOrder::HILBERT:
+        return "HILBERT";
+    case DelaunayInsertOrder::BRIO:
+        return "BRIO";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+std::string ComDelaunayBenchToString(const DelaunayBenchResult &result, LogFileFormat format)
+{
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"order", ComInsertOrderName(result.order_)},
+        {"points", ComTelemetryValue(result.pointNum_)},
+        {"tets", ComTelemetryValue(result.tetNum_)},
+        {"seconds", ComTelemetryValue(result.orderSeconds_ + result.insertSeconds_)},
+        {"orderSeconds", ComTelemetryValue(result.orderSeconds_)},
+        {"pointsPerSec", ComTelemetryValue(result.pointsPerSecond_)},
+        {"walk.avg", ComTelemetryValue(result.walk_.avgStep())},
+        {"walk.p50", ComTelemetryValue(result.walk_.stepHist_.quantile(0.5))},
+        {"walk.p99", ComTelemetryValue(result.walk_.stepHist_.quantile(0.99))},
+        {"walk.max", ComTelemetryValue(result.walk_.maxStep_)},
+    };
+    return ComTelemetryFields(fields, format);
+}
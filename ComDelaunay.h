@@ -0,0 +1,171 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComDelaunay.h
+// 摘    要：三维 Delaunay 四面体剖分核心：无穷远点（凸包外的符号顶点）+ Bowyer-Watson 逐点插入，
+//           方向与外接球判断使用鲁棒谓词，点定位为从上次插入位置出发的可见性行走；
+//           插入顺序（输入 / 随机 / Hilbert / BRIO）、行走步数统计与插入吞吐量测试
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMDELAUNAY_H_
+#define EMMPMESH_COMMON_COMDELAUNAY_H_
+
+#include "ComConstants.h"
+#include "ComOptiTelemetry.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// 点定位行走统计
+struct DelaunayWalkStat
+{
+    long long locateNum_ = 0; // 定位次数
+    long long stepNum_ = 0;   // 行走步数之和（经过的四面体个数，不含起点）
+    int maxStep_ = 0;         // 单次定位的最大步数
+    Log2Histogram stepHist_;  // 单次定位步数的分布
+
+    void add(int step)
+    {
+        ++locateNum_;
+        stepNum_ += step;
+        maxStep_ = std::max(maxStep_, step);
+        stepHist_.add(step);
+    }
+
+    void merge(const DelaunayWalkStat &other)
+    {
+        locateNum_ += other.locateNum_;
+        stepNum_ += other.stepNum_;
+        maxStep_ = std::max(maxStep_, other.maxStep_);
+        stepHist_.merge(other.stepHist_);
+    }
+
+    double avgStep() const { return locateNum_ > 0 ? static_cast<double>(stepNum_) / locateNum_ : 0.; }
+};
+
+// Delaunay 剖分核心。顶点编号 0 .. pointNum-1 为输入点，pointNum 为无穷远点：每个凸包面与无穷远点
+// 组成一个无穷单元，因此所有面都有相邻单元，剖分恰好覆盖输入点的凸包（扁平点集同样如此）。
+// 无穷单元按有限面的朝向定义正向（无穷远点位于有限面的正侧），其外接球判断退化为凸包面的
+// 半空间判断，共面时取凸包面的外接圆，均由精确谓词完成。
+// 共球（共圆）时按点的 rank 做符号扰动（ComInspherePerturbed），剖分因此唯一：rank 取全局点编号时，
+// 同一点集的任意子集在各处剖分中对相同的点组给出相同的判断。
+// 四面体均为正向，局部面编号与 neigRegionID 一致（ComTetFaceVert）
+class DelaunayKernel
+{
+public:
+    DelaunayKernel() = default;
+
+    /************************************************************************
+    * 功能描述：初始化为只含初始四面体（4 个不共面的输入点）及其 4 个无穷单元的剖分。
+    *           coords 不复制，插入期间须保持有效；所有点共面（或少于 4 个点）时剖分为空，
+    *           之后的插入均返回 -1。rank 为各点的符号扰动序（如子集点的全局编号），
+    *           同样不复制，为 nullptr 时取点编号本身
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void init(const double *coords, int pointNum, const int *rank = nullptr);
+
+    /************************************************************************
+    * 功能描述：插入点 v。从 hint（无效时为上次插入得到的四面体，即上一个点的 regionID）
+    *           出发行走定位，删除外接球包含 v 的空腔并以 v 为顶点重新连接；
+    *           与已有顶点重合时不插入。已知邻近顶点 u 时可传入 regionID(u)。
+    *           v 为初始四面体的顶点时直接返回其所在单元
+    * 返回值：int - 以 v 为顶点的一个四面体，未插入返回 -1
+    * 作者：邓龙威
+    /************************************************************************/
+    int insert(int v, int hint = -1);
+
+    /************************************************************************
+    * 功能描述：输出存活的四面体（每个 4 个顶点编号），withInfinite 为 false 时
+    *           跳过无穷单元
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void extract(std::vector<int> &tets, bool withInfinite = false) const;
+
+    /************************************************************************
+    * 功能描述：同 extract，并输出每个顶点的 regionID（输出数组中包含该顶点的任意单元编号，
+    *           未插入或不在输出单元中的顶点为 -1），大小为 pointNum
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void extract(std::vector<int> &tets, std::vector<int> &regionID, bool withInfinite = false) const;
+
+    bool isInfinite(int v) const { return v >= pointNum_; }
+    int pointNum() const { return pointNum_; }
+    // 顶点坐标，无穷远点返回 nullptr
+    const double *point(int v) const { return v < pointNum_ ? coords_ + 3 * v : nullptr; }
+    int tetNum() const { return static_cast<int>(dead_.size() - free_.size()); }
+    int rank(int v) const { return rank_ ? rank_[v] : v; }
+
+    // 包含顶点 v 的一个存活四面体（剖分内部编号），未插入时为 -1
+    int regionID(int v) const { return vertTet_[v] >= 0 && !dead_[vertTet_[v]] ? vertTet_[v] : -1; }
+    const DelaunayWalkStat &walkStat() const { return walkStat_; }
+
+private:
+    int locate(const double *p, int start);                   // 可见性行走，返回包含 p 的四面体或 p 可见的无穷单元
+    int allocTet();                                           // 分配四面体编号（优先复用已删除的编号）
+    int finiteFace(int t) const;                              // 无穷单元中无穷远点的局部编号（即有限面编号），有限单元为 -1
+    bool conflict(int t, int u) const;                        // 点 u 是否位于单元 t 的外接球（无穷单元为半空间）内
+    bool visible(int t, int k, int n, const double *p) const; // 以单元 t 的第 k 个面（外侧为 n）与 p 组成的新单元是否为正向
+
+    const double *coords_ = nullptr; // 输入点坐标
+    int pointNum_ = 0;               // 输入点个数，同时是无穷远点的编号
+    const int *rank_ = nullptr;      // 符号扰动序，nullptr 时为点编号
+    std::vector<int> tv_;            // 四面体顶点，每个 4 个
+    std::vector<int> tn_;            // 四面体相邻单元，每个 4 个，第 i 个为顶点 i 对面的相邻单元
+    std::vector<char> dead_;         // 是否已删除
+    std::vector<int> free_;          // 已删除的编号
+    int last_ = 0;                   // 上次插入得到的四面体
+    std::vector<int> vertTet_;       // 顶点的 regionID：包含该顶点的一个四面体
+    DelaunayWalkStat walkStat_;      // 点定位行走统计
+
+    // 插入过程的临时数组
+    std::vector<unsigned int> mark_;              // 访问标记：2·gen 为空腔内，2·gen+1 为空腔外
+    unsigned int gen_ = 0;                        // 当前标记代数
+    std::vector<int> cavity_;                     // 空腔四面体
+    std::vector<int> bound_;                      // 空腔边界面：（空腔四面体, 面编号, 外侧相邻单元, 外侧单元中的面编号, 面的 3 个顶点）
+    std::vector<std::pair<long long, int>> side_; // 新四面体侧面：（边键值, 四面体·4 + 面编号）
+};
+
+/************************************************************************
+* 功能描述：生成 pointNum 个点的插入顺序 index。HILBERT / BRIO 的排序并行计算，
+*           RANDOM / BRIO 以 seed 为随机种子，结果与线程数无关
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComInsertOrder(const double *coords, int pointNum, DelaunayInsertOrder order, int threadNum, unsigned int seed,
+                    std::vector<int> &index);
+
+// 插入吞吐量测试结果
+struct DelaunayBenchResult
+{
+    DelaunayInsertOrder order_ = DelaunayInsertOrder::INPUT; // 插入顺序
+    int pointNum_ = 0;                                       // 点数
+    int tetNum_ = 0;                                         // 单元个数（不含无穷单元）
+    double orderSeconds_ = 0.;                               // 生成插入顺序耗时（秒）
+    double insertSeconds_ = 0.;                              // 逐点插入耗时（秒）
+    double pointsPerSecond_ = 0.;                            // 插入吞吐量（点 / 秒，含排序耗时）
+    DelaunayWalkStat walk_;                                  // 点定位行走统计
+};
+
+/************************************************************************
+* 功能描述：以给定插入顺序串行剖分 pointNum 个点，记录耗时、吞吐量与行走统计，
+*           用于比较各插入顺序（INPUT 即按输入顺序插入）
+* 返回值：DelaunayBenchResult
+* 作者：邓龙威
+/************************************************************************/
+DelaunayBenchResult ComDelaunayInsertBench(const double *coords, int pointNum, DelaunayInsertOrder order,
+                                           int threadNum = 1, unsigned int seed = 0);
+
+/************************************************************************
+* 功能描述：将测试结果格式化为一行（Json / Logfmt，Text 同 Logfmt），字段含
+*           order、points、tets、seconds、pointsPerSec、walk.avg / p50 / p99 / max
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComDelaunayBenchToString(const DelaunayBenchResult &result, LogFileFormat format);
+
+#endif // EMMPMESH_COMMON_COMDELAUNAY_H_
@@ -0,0 +1,288 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComDual.h
+// 摘    要：前向自动微分对偶数，固定宽度导数通道（单顶点 3，单个四面体 12），
+//           网格质量函数只需按模板写一次即可同时得到函数值与梯度
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMDUAL_H_
+#define EMMPMESH_COMMON_COMDUAL_H_
+
+#include <cmath>
+
+// 对偶数：v_ 为函数值，d_[i] 为对第 i 个变量的偏导数
+// N 在编译期确定，所有运算均为定长循环，可由编译器完全展开与向量化
+template <typename T, int N>
+struct Dual
+{
+    T v_;    // 函数值
+    T d_[N]; // 偏导数
+
+    Dual()
+        : v_(0)
+    {
+        for (int i = 0; i < N; ++i)
+            d_[i] = 0;
+    }
+
+    Dual(const T &value)
+        : v_(value)
+    {
+        for (int i = 0; i < N; ++i)
+            d_[i] = 0;
+    }
+
+    // 构造第 lane 个自变量
+    Dual(const T &value, int lane)
+        : v_(value)
+    {
+        for (int i = 0; i < N; ++i)
+            d_[i] = (i == lane) ? T(1) : T(0);
+    }
+
+    Dual &operator+=(const Dual &b)
+    {
+        v_ += b.v_;
+        for (int i = 0; i < N; ++i)
+            d_[i] += b.d_[i];
+        return *this;
+    }
+
+    Dual &operator-=(const Dual &b)
+    {
+        v_ -= b.v_;
+        for (int i = 0; i < N; ++i)
+            d_[i] -= b.d_[i];
+        return *this;
+    }
+
+    Dual &operator*=(const Dual &b)
+    {
+        for (int i = 0; i < N; ++i)
+            d_[i] = d_[i] * b.v_ + v_ * b.d_[i];
+        v_ *= b.v_;
+        return *this;
+    }
+
+    Dual &operator/=(const Dual &b)
+    {
+        T inv = T(1) / b.v_;
+        v_ *= inv;
+        for (int i = 0; i < N; ++i)
+            d_[i] = (d_[i] - v_ * b.d_[i]) * inv;
+        return *this;
+    }
+
+    Dual &operator+=(const T &b)
+    {
+        v_ += b;
+        return *this;
+    }
+
+    Dual &operator-=(const T &b)
+    {
+        v_ -= b;
+        return *this;
+    }
+
+    Dual &operator*=(const T &b)
+    {
+        v_ *= b;
+        for (int i = 0; i < N; ++i)
+            d_[i] *= b;
+        return *this;
+    }
+
+    Dual &operator/=(const T &b)
+    {
+        return *this *= (T(1) / b);
+    }
+};
+
+using Dual3 = Dual<double, 3>;   // 单顶点（x, y, z）
+using Dual12 = Dual<double, 12>; // 单个四面体的 4 个顶点
+
+// =============================== 算术运算 ===============================
+
+template <typename T, int N>
+inline Dual<T, N> operator-(const Dual<T, N> &a)
+{
+    Dual<T, N> r;
+    r.v_ = -a.v_;
+    for (int i = 0; i < N; ++i)
+        r.d_[i] = -a.d_[i];
+    return r;
+}
+
+template <typename T, int N>
+inline Dual<T, N> operator+(Dual<T, N> a, const Dual<T, N> &b) { return a += b; }
+template <typename T, int N>
+inline Dual<T, N> operator-(Dual<T, N> a, const Dual<T, N> &b) { return a -= b; }
+template <typename T, int N>
+inline Dual<T, N> operator*(Dual<T, N> a, const Dual<T, N> &b) { return a *= b; }
+template <typename T, int N>
+inline Dual<T, N> operator/(Dual<T, N> a, const Dual<T, N> &b) { return a /= b; }
+
+template <typename T, int N>
+inline Dual<T, N> operator+(Dual<T, N> a, const T &b) { return a += b; }
+template <typename T, int N>
+inline Dual<T, N> operator-(Dual<T, N> a, const T &b) { return a -= b; }
+template <typename T, int N>
+inline Dual<T, N> operator*(Dual<T, N> a, const T &b) { return a *= b; }
+template <typename T, int N>
+inline Dual<T, N> operator/(Dual<T, N> a, const T &b) { return a /= b; }
+
+template <typename T, int N>
+inline Dual<T, N> operator+(const T &a, Dual<T, N> b) { return b += a; }
+template <typename T, int N>
+inline Dual<T, N> operator-(const T &a, const Dual<T, N> &b) { return -b + a; }
+template <typename T, int N>
+inline Dual<T, N> operator*(const T &a, Dual<T, N> b) { return b *= a; }
+template <typename T, int N>
+inline Dual<T, N> operator/(const T &a, const Dual<T, N> &b)
+{
+    Dual<T, N> r;
+    r.v_ = a / b.v_;
+    T k = -r.v_ / b.v_;
+    for (int i = 0; i < N; ++i)
+        r.d_[i] = k * b.d_[i];
+    return r;
+}
+
+// 比较运算只比较函数值（用于 MAX / 分段函数的分支选择）
+template <typename T, int N>
+inline bool operator<(const Dual<T, N> &a, const Dual<T, N> &b) { return a.v_ < b.v_; }
+template <typename T, int N>
+inline bool operator>(const Dual<T, N> &a, const Dual<T, N> &b) { return a.v_ > b.v_; }
+template <typename T, int N>
+inline bool operator<(const Dual<T, N> &a, const T &b) { return a.v_ < b; }
+template <typename T, int N>
+inline bool operator>(const Dual<T, N> &a, const T &b) { return a.v_ > b; }
+
+// =============================== 初等函数 ===============================
+
+// 链式法则：r = f(a)，df 为 f'(a.v_)
+template <typename T, int N>
+inline Dual<T, N> ComDualChain(const Dual<T, N> &a, const T &f, const T &df)
+{
+    Dual<T, N> r;
+    r.v_ = f;
+    for (int i = 0; i < N; ++i)
+        r.d_[i] = df * a.d_[i];
+    return r;
+}
+
+template <typename T, int N>
+inline Dual<T, N> sqrt(const Dual<T, N> &a)
+{
+    T s = std::sqrt(a.v_);
+    return ComDualChain(a, s, T(0.5) / s);
+}
+
+template <typename T, int N>
+inline Dual<T, N> cbrt(const Dual<T, N> &a)
+{
+    T c = std::cbrt(a.v_);
+    return ComDualChain(a, c, T(1) / (T(3) * c * c));
+}
+
+template <typename T, int N>
+inline Dual<T, N> pow(const Dual<T, N> &a, const T &p)
+{
+    T f = std::pow(a.v_, p);
+    return ComDualChain(a, f, p * std::pow(a.v_, p - T(1)));
+}
+
+template <typename T, int N>
+inline Dual<T, N> exp(const Dual<T, N> &a)
+{
+    T e = std::exp(a.v_);
+    return ComDualChain(a, e, e);
+}
+
+template <typename T, int N>
+inline Dual<T, N> log(const Dual<T, N> &a)
+{
+    return ComDualChain(a, std::log(a.v_), T(1) / a.v_);
+}
+
+template <typename T, int N>
+inline Dual<T, N> fabs(const Dual<T, N> &a)
+{
+    return a.v_ < T(0) ? -a : a;
+}
+
+template <typename T, int N>
+inline Dual<T, N> acos(const Dual<T, N> &a)
+{
+    return ComDualChain(a, std::acos(a.v_), -T(1) / std::sqrt(T(1) - a.v_ * a.v_));
+}
+
+template <typename T, int N>
+inline Dual<T, N> atan2(const Dual<T, N> &y, const Dual<T, N> &x)
+{
+    T r2 = x.v_ * x.v_ + y.v_ * y.v_;
+    Dual<T, N> r;
+    r.v_ = std::atan2(y.v_, x.v_);
+    for (int i = 0; i < N; ++i)
+        r.d_[i] = (x.v_ * y.d_[i] - y.v_ * x.d_[i]) / r2;
+    return r;
+}
+
+template <typename T, int N>
+inline Dual<T, N> min(const Dual<T, N> &a, const Dual<T, N> &b) { return b.v_ < a.v_ ? b : a; }
+template <typename T, int N>
+inline Dual<T, N> max(const Dual<T, N> &a, const Dual<T, N> &b) { return a.v_ < b.v_ ? b : a; }
+
+// 取值：模板质量函数中统一获取函数值（double 直接返回）
+inline double ComDualValue(double a) { return a; }
+template <typename T, int N>
+inline T ComDualValue(const Dual<T, N> &a) { return a.v_; }
+
+// =============================== 梯度计算 ===============================
+
+/************************************************************************
+* 功能描述：以 N 个变量 x 计算模板函数 func 的值与梯度。
+*           func 形如 template <typename S> S func(const S *x)，
+*           对 S = double 与 S = Dual<double, N> 都应可用
+* 返回值：double - 函数值，grad 中返回 N 个偏导数
+* 作者：邓龙威
+/************************************************************************/
+template <int N, typename Func>
+inline double ComDualGradient(Func &&func, const double *x, double *grad)
+{
+    Dual<double, N> vars[N];
+    for (int i = 0; i < N; ++i)
+        vars[i] = Dual<double, N>(x[i], i);
+
+    Dual<double, N> f = func(static_cast<const Dual<double, N> *>(vars));
+    for (int i = 0; i < N; ++i)
+        grad[i] = f.d_[i];
+    return f.v_;
+}
+
+/************************************************************************
+* 功能描述：四面体质量函数对其中一个顶点（lane = 0..3）的梯度，只为该顶点的
+*           3 个坐标播种导数，用于单顶点光滑（SIGLE_VERT），代价约为 Dual12 的 1/4
+*           tet 为 12 个坐标（4 个顶点依次存储）
+* 返回值：double - 函数值，grad 中返回 3 个偏导数
+* 作者：邓龙威
+/************************************************************************/
+template <typename Func>
+inline double ComDualVertexGradient(Func &&func, const double *tet, int vert, double *grad)
+{
+    Dual3 vars[12];
+    for (int i = 0; i < 12; ++i)
+        vars[i] = Dual3(tet[i]);
+    for (int k = 0; k < 3; ++k)
+        vars[3 * vert + k] = Dual3(tet[3 * vert + k], k);
+
+    Dual3 f = func(static_cast<const Dual3 *>(vars));
+    for (int k = 0; k < 3; ++k)
+        grad[k] = f.d_[k];
+    return f.v_;
+}
+
+#endif // EMMPMESH_COMMON_COMDUAL_H_
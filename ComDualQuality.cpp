@@ -0,0 +1,141 @@
+#include "pch.h"
+
+#include "ComDualQuality.h"
+#include "ComOptiTelemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+double ComTetShapeGradient(const double *x, double *grad)
+{
+    double e[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+            e[i][k] = x[3 * (i + 1) + k] - x[k];
+    }
+
+    // det = e0·(e1×e2)，对 p1 / p2 / p3 的偏导数为 e1×e2、e2×e0、e0×e1，对 p0 为三者之和的相反数
+    double n[4][3];
+    auto cross = [](const double *a, const double *b, double *r) {
+        r[0] = a[1] * b[2] - a[2] * b[1];
+        r[1] = a[2] * b[0] - a[0] * b[2];
+        r[2] = a[0] * b[1] - a[1] * b[0];
+    };
+    cross(e[1], e[2], n[1]);
+    cross(e[2], e[0], n[2]);
+    cross(e[0], e[1], n[3]);
+    for (int k = 0; k < 3; ++k)
+        n[0][k] = -(n[1][k] + n[2][k] + n[3][k]);
+    double det = e[0][0] * n[1][0] + e[0][1] * n[1][1] + e[0][2] * n[1][2];
+
+    // Σl² = Σ_{i<j} |pj - pi|²，对 pi 的偏导数为 2·(4·pi - Σpj)
+    double l2 = 0., sum[3] = {0., 0., 0.};
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+            sum[k] += x[3 * i + k];
+        for (int j = i + 1; j < 4; ++j)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                double d = x[3 * j + k] - x[3 * i + k];
+                l2 += d * d;
+            }
+        }
+    }
+
+    // g = c·|c|，c = (det / 2)^(1/3)，dg/ddet = 1 / (3|c|)
+    double c = std::cbrt(det * 0.5);
+    double q = 12. * c * std::fabs(c) / l2;
+    double dDet = 12. / (3. * std::fabs(c) * l2);
+    double dL2 = -q / l2;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+            grad[3 * i + k] = dDet * n[i][k] + dL2 * 2. * (4. * x[3 * i + k] - sum[k]);
+    }
+    return q;
+}
+
+DualGradBenchResult ComDualGradientBench(const double *tets, int tetNum, int repeat)
+{
+    DualGradBenchResult result;
+    result.tetNum_ = tetNum;
+    result.repeat_ = std::max(1, repeat);
+    if (tetNum <= 0)
+        return result;
+
+    auto shape = [](const auto *v) { return ComTetShape(v); };
+    std::vector<double> analytic(12 * static_cast<size_t>(tetNum));
+    std::vector<double> grad(12 * static_cast<size_t>(tetNum));
+    volatile double sink = 0.; // 防止求值被优化掉
+    auto clock = std::chrono::steady_clock::now();
+    auto lap = [&clock]() {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - clock).count();
+        clock = now;
+        return seconds;
+    };
+    auto relErr = [&analytic, &grad]() {
+        double err = 0.;
+        for (size_t i = 0; i < analytic.size(); ++i)
+            err = std::max(err, std::fabs(grad[i] - analytic[i]) / std::max(std::fabs(analytic[i]), 1e-12));
+        return err;
+    };
+
+    lap();
+    for (int r = 0; r < result.repeat_; ++r)
+    {
+        double acc = 0.;
+        for (int t = 0; t < tetNum; ++t)
+            acc += ComTetShapeGradient(tets + 12 * static_cast<size_t>(t), analytic.data() + 12 * static_cast<size_t>(t));
+        sink = sink + acc;
+    }
+    result.analyticSeconds_ = lap();
+
+    for (int r = 0; r < result.repeat_; ++r)
+    {
+        double acc = 0.;
+        for (int t = 0; t < tetNum; ++t)
+            acc += ComDualGradient<12>(shape, tets + 12 * static_cast<size_t>(t), grad.data() + 12 * static_cast<size_t>(t));
+        sink = sink + acc;
+    }
+    result.dual12Seconds_ = lap();
+    result.maxRelErr12_ = relErr();
+
+    lap();
+    for (int r = 0; r < result.repeat_; ++r)
+    {
+        double acc = 0.;
+        for (int t = 0; t < tetNum; ++t)
+        {
+            const double *tet = tets + 12 * static_cast<size_t>(t);
+            for (int v = 0; v < 4; ++v)
+                acc += ComDualVertexGradient(shape, tet, v, grad.data() + 12 * static_cast<size_t>(t) + 3 * v);
+        }
+        sink = sink + acc;
+    }
+    result.dual3Seconds_ = lap();
+    result.maxRelErr3_ = relErr();
+    return result;
+}
+
+std::string ComDualBenchToString(const DualGradBenchResult &result, LogFileFormat format)
+{
+    double base = result.analyticSeconds_ > 0. ? result.analyticSeconds_ : 1.;
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"metric", "SHAPE_FUNC"},
+        {"tets", ComTelemetryValue(result.tetNum_)},
+        {"repeat", ComTelemetryValue(result.repeat_)},
+        {"analyticSeconds", ComTelemetryValue(result.analyticSeconds_)},
+        {"dual12Seconds", ComTelemetryValue(result.dual12Seconds_)},
+        {"dual3Seconds", ComTelemetryValue(result.dual3Seconds_)},
+        {"dual12Ratio", ComTelemetryValue(result.dual12Seconds_ / base)},
+        {"dual3Ratio", ComTelemetryValue(result.dual3Seconds_ / base)},
+        {"maxRelErr12", ComTelemetryValue(result.maxRelErr12_)},
+        {"maxRelErr3", ComTelemetryValue(result.maxRelErr3_)},
+    };
+    return ComTelemetryFields(fields, format);
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComDualQuality.h
+// 摘    要：以对偶数模板编写的四面体形状度量（SHAPE_FUNC，mean ratio），解析梯度，
+//           以及自动微分梯度与解析梯度的精度 / 耗时对比测试
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMDUALQUALITY_H_
+#define EMMPMESH_COMMON_COMDUALQUALITY_H_
+
+#include "ComConstants.h"
+#include "ComDual.h"
+
+#include <cmath>
+#include <string>
+
+/************************************************************************
+* 功能描述：四面体形状度量 q = 12·(3V)^(2/3) / Σl²（MeshQualityFunc::SHAPE_FUNC），
+*           正四面体为 1，退化为 0，体积为负（翻转）时取负值。
+*           x 为 12 个坐标（4 个顶点依次存储），S 为 double 或 Dual<double, N>
+* 返回值：S
+* 作者：邓龙威
+/************************************************************************/
+template <typename S>
+S ComTetShape(const S *x)
+{
+    using std::cbrt;
+    using std::fabs;
+
+    S e[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+            e[i][k] = x[3 * (i + 1) + k] - x[k];
+    }
+    S det = e[0][0] * (e[1][1] * e[2][2] - e[1][2] * e[2][1]) -
+            e[0][1] * (e[1][0] * e[2][2] - e[1][2] * e[2][0]) +
+            e[0][2] * (e[1][0] * e[2][1] - e[1][1] * e[2][0]);
+
+    S l2 = S(0.);
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = i + 1; j < 4; ++j)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                S d = x[3 * j + k] - x[3 * i + k];
+                l2 += d * d;
+            }
+        }
+    }
+
+    // 3V = det / 2，(3V)^(2/3) 保留体积符号
+    S c = cbrt(det * 0.5);
+    return 12. * c * fabs(c) / l2;
+}
+
+/************************************************************************
+* 功能描述：ComTetShape 的解析梯度，grad 中返回对 12 个坐标的偏导数
+* 返回值：double - 函数值
+* 作者：邓龙威
+/************************************************************************/
+double ComTetShapeGradient(const double *x, double *grad);
+
+/************************************************************************
+* 功能描述：按 MeshOptiOptions::autoDiff_ 选择 Dual12 自动微分或解析梯度
+* 返回值：double - 函数值，grad 中返回 12 个偏导数
+* 作者：邓龙威
+/************************************************************************/
+inline double ComTetShapeGradient(const double *x, double *grad, bool autoDiff)
+{
+    if (!autoDiff)
+        return ComTetShapeGradient(x, grad);
+    return ComDualGradient<12>([](const auto *v) { return ComTetShape(v); }, x, grad);
+}
+
+// 自动微分梯度对比测试结果
+struct DualGradBenchResult
+{
+    int tetNum_ = 0;              // 单元个数
+    int repeat_ = 0;              // 重复次数
+    double analyticSeconds_ = 0.; // 解析梯度耗时（秒）
+    double dual12Seconds_ = 0.;   // Dual12 全部 12 个坐标梯度耗时（秒）
+    double dual3Seconds_ = 0.;    // Dual3 逐顶点梯度耗时（秒，每个单元 4 次，与 SIGLE_VERT 相同）
+    double maxRelErr12_ = 0.;     // Dual12 梯度与解析梯度的最大相对误差
+    double maxRelErr3_ = 0.;      // Dual3 梯度与解析梯度的最大相对误差
+};
+
+/************************************************************************
+* 功能描述：对 tetNum 个四面体（每个 12 个坐标）分别以解析梯度、Dual12 与 Dual3 计算
+*           ComTetShape 的梯度，重复 repeat 次计时，并比较梯度的最大相对误差
+*           （相对于 max(|解析梯度|, 1e-12)）
+* 返回值：DualGradBenchResult
+* 作者：邓龙威
+/************************************************************************/
+DualGradBenchResult ComDualGradientBench(const double *tets, int tetNum, int repeat = 10);
+
+/************************************************************************
+* 功能描述：将测试结果格式化为一行（Json / Logfmt，Text 同 Logfmt），字段含
+*           tets、repeat、各方法耗时、dual12Ratio / dual3Ratio（相对解析梯度的耗时比）与最大相对误差
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComDualBenchToString(const DualGradBenchResult &result, LogFileFormat format);
+
+#endif // EMMPMESH_COMMON_COMDUALQUALITY_H_
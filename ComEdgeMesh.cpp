@@ -0,0 +1,346 @@
+#include "pch.h"
+
+#include "ComEdgeMesh.h"
+#include "ComParallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+// 5 点 Gauss-Legendre 求积节点与权重（[-1, 1]）
+static const double ComGaussNode[5] = {0., -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640};
+static const double ComGaussWeight[5] = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891};
+
+// 弧长表采样点
+struct ComArcSample
+{
+    double t_ = 0.;                    // 参数
+    double xyz_[3] = {0., 0., 0.};     // 坐标
+    double tangent_[3] = {0., 0., 0.}; // 单位切向，导数为零时为零向量
+};
+
+int EdgeArcTable::segment(double s, double &w) const
+{
+    int n = static_cast<int>(s_.size());
+    if (n < 2)
+    {
+        w = 0.;
+        return 0;
+    }
+    s = std::max(0., std::min(s, s_.back()));
+    int i = static_cast<int>(std::upper_bound(s_.begin(), s_.end(), s) - s_.begin()) - 1;
+    i = std::max(0, std::min(i, n - 2));
+    double ds = s_[i + 1] - s_[i];
+    w = ds > 0. ? (s - s_[i]) / ds : 0.;
+    return i;
+}
+
+double EdgeArcTable::paramAt(double s) const
+{
+    if (t_.empty())
+        return 0.;
+    double w;
+    int i = segment(s, w);
+    return t_.size() < 2 ? t_[0] : t_[i] + w * (t_[i + 1] - t_[i]);
+}
+
+double EdgeArcTable::curvatureAt(double s) const
+{
+    if (kappa_.empty())
+        return 0.;
+    double w;
+    int i = segment(s, w);
+    return kappa_.size() < 2 ? kappa_[0] : kappa_[i] + w * (kappa_[i + 1] - kappa_[i]);
+}
+
+void EdgeMesher::setGeometry(const ComCurveEval &curveEval, const ComCurveRange &curveRange)
+{
+    curveEval_ = curveEval;
+    curveRange_ = curveRange;
+}
+
+std::vector<int> EdgeMesher::collectEdgeIDs(const std::vector<std::vector<LoopCoedge>> &loops)
+{
+    std::vector<int> ids;
+    for (const auto &loop : loops)
+    {
+        for (const auto &coedge : loop)
+        {
+            if (coedge.edgeIDFromEG_ >= 0)
+                ids.push_back(coedge.edgeIDFromEG_);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+bool EdgeMesher::buildTable(int edgeID, EdgeArcTable &table) const
+{
+    table = EdgeArcTable();
+    table.edgeID_ = edgeID;
+    double t0 = 0., t1 = 0.;
+    curveRange_(edgeID, t0, t1);
+    if (!std::isfinite(t0) || !std::isfinite(t1) || !(t1 > t0))
+        return false;
+
+    int evalNum = 0;
+    auto sample = [&](double t) {
+        ComArcSample p;
+        double d[3];
+        p.t_ = t;
+        curveEval_(edgeID, t, p.xyz_, d);
+        ++evalNum;
+        double len = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        for (int j = 0; j < 3; ++j)
+            p.tangent_[j] = len > 0. ? d[j] / len : 0.;
+        return p;
+    };
+    auto arcLength = [&](double a, double b) {
+        double mid = 0.5 * (a + b), half = 0.5 * (b - a), len = 0.;
+        for (int k = 0; k < 5; ++k)
+        {
+            double xyz[3], d[3];
+            curveEval_(edgeID, mid + half * ComGaussNode[k], xyz, d);
+            ++evalNum;
+            len += ComGaussWeight[k] * std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        }
+        return len * half;
+    };
+
+    const double cosTurn = std::cos(opts_.tableMaxTurnAngle_ * 3.14159265358979323846 / 180.);
+    const int initNum = std::max(1, opts_.tableSegmentNum_);
+    const int maxSegNum = std::max(initNum, opts_.maxTableSegmentNum_);
+    int segNum = initNum;
+
+    std::vector<ComArcSample> samples = {sample(t0)};
+    std::vector<double> arc = {0.};
+    // 待处理的段终点（栈顶为下一段），附带整段弧长估计
+    std::vector<std::pair<ComArcSample, double>> stack;
+    // 初始各段弧长估计及其总和，分段误差阈值为 tableTolerance_ 乘以估计总长
+    std::vector<double> initLen(initNum);
+    double total = 0.;
+    for (int k = 0; k < initNum; ++k)
+    {
+        double a = t0 + (t1 - t0) * k / initNum;
+        double b = k + 1 == initNum ? t1 : t0 + (t1 - t0) * (k + 1) / initNum;
+        initLen[k] = arcLength(a, b);
+        total += initLen[k];
+    }
+    const double tolerance = opts_.tableTolerance_ * std::max(total, 0.);
+    for (int k = 0; k < initNum; ++k)
+    {
+        double b = k + 1 == initNum ? t1 : t0 + (t1 - t0) * (k + 1) / initNum;
+        stack.push_back({sample(b), initLen[k]});
+        while (!stack.empty())
+        {
+            const ComArcSample &pa = samples.back();
+            ComArcSample pb = stack.back().first;
+            double whole = stack.back().second;
+            stack.pop_back();
+
+            ComArcSample pm = sample(0.5 * (pa.t_ + pb.t_));
+            double left = arcLength(pa.t_, pm.t_), right = arcLength(pm.t_, pb.t_);
+            double dot = pa.tangent_[0] * pb.tangent_[0] + pa.tangent_[1] * pb.tangent_[1] + pa.tangent_[2] * pb.tangent_[2];
+            bool defined = (pa.tangent_[0] != 0. || pa.tangent_[1] != 0. || pa.tangent_[2] != 0.) &&
+                           (pb.tangent_[0] != 0. || pb.tangent_[1] != 0. || pb.tangent_[2] != 0.);
+            bool turned = defined && dot < cosTurn;
+            bool inexact = std::fabs(left + right - whole) > tolerance;
+            if ((turned || inexact) && segNum < maxSegNum)
+            {
+                ++segNum;
+                stack.push_back({pb, right});
+                stack.push_back({pm, left});
+                continue;
+            }
+            double s = arc.back();
+            samples.push_back(pm);
+            arc.push_back(s + left);
+            samples.push_back(pb);
+            arc.push_back(s + left + right);
+        }
+    }
+    if (!std::isfinite(arc.back()))
+        return false;
+
+    int n = static_cast<int>(samples.size());
+    table.t_.resize(n);
+    table.xyz_.resize(3 * static_cast<size_t>(n));
+    table.kappa_.assign(n, 0.);
+    table.s_ = arc;
+    for (int i = 0; i < n; ++i)
+    {
+        table.t_[i] = samples[i].t_;
+        std::copy(samples[i].xyz_, samples[i].xyz_ + 3, table.xyz_.begin() + 3 * i);
+    }
+    // 曲率 κ ≈ |T(i+1) - T(i-1)| / (s(i+1) - s(i-1))，端点取单侧差分；切向未定义（导数为零）时取 0
+    auto defined = [&](int i) {
+        const double *tv = samples[i].tangent_;
+        return tv[0] != 0. || tv[1] != 0. || tv[2] != 0.;
+    };
+    for (int i = 0; i < n; ++i)
+    {
+        int a = std::max(0, i - 1), b = std::min(n - 1, i + 1);
+        double ds = arc[b] - arc[a];
+        if (ds <= 0. || !defined(a) || !defined(b))
+            continue;
+        double dt2 = 0.;
+        for (int j = 0; j < 3; ++j)
+        {
+            double dt = samples[b].tangent_[j] - samples[a].tangent_[j];
+            dt2 += dt * dt;
+        }
+        table.kappa_[i] = std::sqrt(dt2) / ds;
+    }
+    table.evalNum_ = evalNum;
+    return true;
+}
+
+void EdgeMesher::place(const EdgeArcTable &table, SizingQueryCache &cache, EdgeDiscretization &out) const
+{
+    out.coords_.clear();
+    out.tParam_.clear();
+    int n = static_cast<int>(table.t_.size());
+    double length = table.length();
+    if (n < 2 || length <= 0.)
+        return;
+
+    // 采样点尺寸与归一化弧长 N(s) = ∫ ds / h（梯形公式）
+    const double minH = adaptive_.minSize_ > 0. ? adaptive_.minSize_ : 1e-12 * length;
+    std::vector<double> inv(n), N(n, 0.);
+    for (int i = 0; i < n; ++i)
+    {
+        const double *p = table.xyz_.data() + 3 * i;
+        double h = sizing_ && !sizing_->empty() ? sizing_->size(p, &cache) : adaptive_.maxSize_;
+        if (opts_.curvatureSizing_)
+            h = std::min(h, ComCurvatureSize(table.kappa_[i], adaptive_));
+        inv[i] = 1. / std::max(h, minH);
+    }
+    for (int i = 1; i < n; ++i)
+        N[i] = N[i - 1] + 0.5 * (table.s_[i] - table.s_[i - 1]) * (inv[i - 1] + inv[i]);
+
+    // 闭合模型边至少 3 段，保证边界环不退化
+    const double *pa = table.xyz_.data(), *pb = table.xyz_.data() + 3 * (n - 1);
+    double gap = std::sqrt((pa[0] - pb[0]) * (pa[0] - pb[0]) + (pa[1] - pb[1]) * (pa[1] - pb[1]) +
+                           (pa[2] - pb[2]) * (pa[2] - pb[2]));
+    int segNum = std::max(std::max(1, opts_.minSegmentNum_), static_cast<int>(std::llround(N.back())));
+    if (gap <= 1e-9 * length)
+        segNum = std::max(segNum, 3);
+
+    out.coords_.resize(3 * static_cast<size_t>(segNum - 1));
+    out.tParam_.resize(segNum - 1);
+    int i = 0;
+    for (int k = 1; k < segNum; ++k)
+    {
+        double target = N.back() * k / segNum;
+        while (i < n - 2 && N[i + 1] < target)
+            ++i;
+        double dN = N[i + 1] - N[i];
+        double w = dN > 0. ? std::max(0., std::min(1., (target - N[i]) / dN)) : 0.;
+        double t = table.t_[i] + w * (table.t_[i + 1] - table.t_[i]);
+        double d[3];
+        curveEval_(table.edgeID_, t, out.coords_.data() + 3 * (k - 1), d);
+        out.tParam_[k - 1] = t;
+    }
+}
+
+EdgeMeshStat EdgeMesher::run(const std::vector<int> &edgeIDs)
+{
+    EdgeMeshStat stat;
+    std::vector<int> ids;
+    for (int id : edgeIDs)
+    {
+        if (id >= 0)
+            ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    stat.edgeNum_ = static_cast<int>(ids.size());
+    int threadNum = ComThreadNum(opts_.threadNum_);
+
+    auto clock = std::chrono::steady_clock::now();
+    auto lap = [&clock]() {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - clock).count();
+        clock = now;
+        return seconds;
+    };
+
+    // 1. 并行建立缺少的弧长表
+    std::vector<int> missing;
+    for (int id : ids)
+    {
+        if (tables_.count(id))
+            ++stat.reusedTableNum_;
+        else
+            missing.push_back(id);
+    }
+    int missNum = static_cast<int>(missing.size());
+    std::vector<EdgeArcTable> built(missNum);
+    std::vector<char> builtOk(missNum, 0);
+    std::atomic<int> cursor(0);
+    if (missNum > 0)
+    {
+        ComParallelFor(0, std::min(threadNum, missNum), threadNum, [&](int, int, int) {
+            for (int i = cursor.fetch_add(1); i < missNum; i = cursor.fetch_add(1))
+                builtOk[i] = buildTable(missing[i], built[i]);
+        });
+    }
+    for (int i = 0; i < missNum; ++i)
+    {
+        stat.evalNum_ += built[i].evalNum_;
+        if (!builtOk[i])
+            continue;
+        tables_[missing[i]] = std::move(built[i]);
+        ++stat.builtTableNum_;
+    }
+    stat.tableSeconds_ = lap();
+
+    // 2. 并行布置节点，每个线程持有一个尺寸场查询缓存
+    int edgeNum = stat.edgeNum_;
+    std::vector<EdgeDiscretization> out(edgeNum);
+    std::vector<const EdgeArcTable *> tables(edgeNum, nullptr);
+    for (int i = 0; i < edgeNum; ++i)
+        tables[i] = table(ids[i]);
+    cursor = 0;
+    if (edgeNum > 0)
+    {
+        ComParallelFor(0, std::min(threadNum, edgeNum), threadNum, [&](int, int, int) {
+            SizingQueryCache cache;
+            for (int i = cursor.fetch_add(1); i < edgeNum; i = cursor.fetch_add(1))
+            {
+                if (tables[i])
+                    place(*tables[i], cache, out[i]);
+            }
+        });
+    }
+    for (int i = 0; i < edgeNum; ++i)
+    {
+        if (!tables[i])
+        {
+            stat.failedEdge_.push_back(ids[i]);
+            results_.erase(ids[i]);
+            continue;
+        }
+        stat.nodeNum_ += static_cast<int>(out[i].tParam_.size());
+        results_[ids[i]] = std::move(out[i]);
+    }
+    stat.placeSeconds_ = lap();
+    return stat;
+}
+
+bool EdgeMesher::discretize(int edgeID, EdgeDiscretization &out) const
+{
+    auto it = results_.find(edgeID);
+    if (it == results_.end())
+        return false;
+    out = it->second;
+    return true;
+}
+
+const EdgeArcTable *EdgeMesher::table(int edgeID) const
+{
+    auto it = tables_.find(edgeID);
+    return it == tables_.end() ? nullptr : &it->second;
+}
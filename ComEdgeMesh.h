@@ -0,0 +1,134 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComEdgeMesh.h
+// 摘    要：线网格生成：按模型边编号（LoopCoedge::edgeIDFromEG_）缓存弧长 / 曲率查找表，
+//           以尺寸场对归一化弧长反求节点参数，各模型边并行离散
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMEDGEMESH_H_
+#define EMMPMESH_COMMON_COMEDGEMESH_H_
+
+#include "ComConstants.h"
+#include "ComParamSmooth.h"
+#include "ComSizingOctree.h"
+#include "ComSurfParallel.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// 模型边参数范围：写入模型边 edgeID 的起止参数 t0 < t1（由几何内核提供）
+using ComCurveRange = std::function<void(int edgeID, double &t0, double &t1)>;
+
+// 模型边弧长表：参数递增的采样点及其累积弧长、曲率
+struct EdgeArcTable
+{
+    int edgeID_ = -1;           // 模型边编号
+    std::vector<double> t_;     // 采样点参数
+    std::vector<double> s_;     // 采样点累积弧长，s_[0] = 0
+    std::vector<double> kappa_; // 采样点曲率（相邻单位切向之差估计）
+    std::vector<double> xyz_;   // 采样点坐标，每个 3 个 double
+    int evalNum_ = 0;           // 构建时的曲线求值次数
+
+    double length() const { return s_.empty() ? 0. : s_.back(); }
+
+    /************************************************************************
+    * 功能描述：弧长 s 对应的采样段：返回 i 使 s_[i] <= s <= s_[i+1]（二分查找），
+    *           w 为段内线性插值权重
+    * 返回值：int - 段编号
+    * 作者：邓龙威
+    /************************************************************************/
+    int segment(double s, double &w) const;
+
+    /************************************************************************
+    * 功能描述：由弧长反求参数 / 曲率（段内线性插值，s 截断到 [0, length()]）
+    * 返回值：double
+    * 作者：邓龙威
+    /************************************************************************/
+    double paramAt(double s) const;
+    double curvatureAt(double s) const;
+};
+
+// 线网格生成统计
+struct EdgeMeshStat
+{
+    int edgeNum_ = 0;             // 离散的模型边个数
+    int builtTableNum_ = 0;       // 本次新建的弧长表个数
+    int reusedTableNum_ = 0;      // 从缓存复用的弧长表个数
+    long long evalNum_ = 0;       // 本次建表的曲线求值次数
+    int nodeNum_ = 0;             // 内部节点总数
+    std::vector<int> failedEdge_; // 离散失败的模型边（参数范围无效或弧长非有限）
+    double tableSeconds_ = 0.;    // 建表耗时（秒）
+    double placeSeconds_ = 0.;    // 节点布置耗时（秒）
+};
+
+// 线网格生成器：弧长表在多次离散之间按模型边编号缓存，尺寸场变化后只需重新布置节点
+class EdgeMesher
+{
+public:
+    EdgeMesher(const EdgeMeshGenerationOptions &opts, const AdaptiveMeshOptions &adaptive)
+        : opts_(opts), adaptive_(adaptive) {}
+
+    /************************************************************************
+    * 功能描述：设置几何内核回调：curveEval 求坐标与一阶导数，curveRange 求参数范围
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setGeometry(const ComCurveEval &curveEval, const ComCurveRange &curveRange);
+
+    /************************************************************************
+    * 功能描述：设置背景尺寸场，sizing 为空时只使用 maxSize_ 与曲率尺寸
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setSizing(const SizingOctree *sizing) { sizing_ = sizing; }
+
+    /************************************************************************
+    * 功能描述：离散模型边 edgeIDs（可重复，按编号去重）。
+    *           1. 缺少弧长表的模型边并行建表：参数等分 tableSegmentNum_ 段，每段以 Gauss-Legendre
+    *              求积估计弧长，整段与两半之差超过 tableTolerance_·估计总长或两端切向夹角
+    *              超过 tableMaxTurnAngle_ 时二分，直到 maxTableSegmentNum_；
+    *           2. 并行布置节点：采样点尺寸 h 取尺寸场与曲率尺寸（curvatureSizing_）的较小值，
+    *              归一化弧长 N(s) = ∫ ds / h，段数 n = max(minSegmentNum_, round(N(L)))，
+    *              第 k 个节点取 N(s) = k·N(L)/n 的 s，再由弧长表反求参数并求坐标。
+    *           结果与线程数无关
+    * 返回值：EdgeMeshStat - 统计信息
+    * 作者：邓龙威
+    /************************************************************************/
+    EdgeMeshStat run(const std::vector<int> &edgeIDs);
+
+    /************************************************************************
+    * 功能描述：由各环的 LoopCoedge 收集模型边编号（去重、升序）
+    * 返回值：std::vector<int>
+    * 作者：邓龙威
+    /************************************************************************/
+    static std::vector<int> collectEdgeIDs(const std::vector<std::vector<LoopCoedge>> &loops);
+
+    /************************************************************************
+    * 功能描述：读取模型边 edgeID 的离散结果，可直接作为 ComEdgeDiscretize 回调使用
+    *           （未在 run 中成功离散时返回 false）
+    * 返回值：bool
+    * 作者：邓龙威
+    /************************************************************************/
+    bool discretize(int edgeID, EdgeDiscretization &out) const;
+
+    const EdgeArcTable *table(int edgeID) const;
+    int tableNum() const { return static_cast<int>(tables_.size()); }
+    void clearTables() { tables_.clear(); }
+
+private:
+    bool buildTable(int edgeID, EdgeArcTable &table) const;                               // 建立弧长表
+    void place(const EdgeArcTable &table, SizingQueryCache &cache, EdgeDiscretization &out) const; // 布置节点
+
+    EdgeMeshGenerationOptions opts_;                       // 线网格生成选项
+    AdaptiveMeshOptions adaptive_;                         // 尺寸范围与曲率角
+    ComCurveEval curveEval_;                               // 模型边求值
+    ComCurveRange curveRange_;                             // 模型边参数范围
+    const SizingOctree *sizing_ = nullptr;                 // 背景尺寸场
+    std::unordered_map<int, EdgeArcTable> tables_;         // 模型边编号 -> 弧长表
+    std::unordered_map<int, EdgeDiscretization> results_;  // 模型边编号 -> 离散结果
+};
+
+#endif // EMMPMESH_COMMON_COMEDGEMESH_H_
@@ -0,0 +1,160 @@
+#include "pch.h"
+
+#include "ComGradation.h"
+#include "ComOptiTelemetry.h"
+#include "ComParallel.h"
+
+#include <chrono>
+#include <cmath>
+
+GradationStat ComGradation(const GradationGraph &graph, double ratioFactor, int threadNum, double *h)
+{
+    GradationStat stat;
+    auto start = std::chrono::steady_clock::now();
+    int n = graph.vertNum();
+    threadNum = ComThreadNum(threadNum);
+    double g = std::max(0., ratioFactor - 1.);
+
+    std::vector<double> next(h, h + n);
+    std::vector<char> active(n, 1), changed(n, 0);
+    std::vector<long long> updateNum(threadNum), relaxNum(threadNum);
+    bool any = n > 0;
+    while (any)
+    {
+        std::fill(updateNum.begin(), updateNum.end(), 0);
+        std::fill(relaxNum.begin(), relaxNum.end(), 0);
+        ComParallelFor(0, n, threadNum, [&](int tid, int first, int last) {
+            for (int v = first; v < last; ++v)
+            {
+                double hv = h[v];
+                for (int k = graph.start_[v]; k < graph.start_[v + 1]; ++k)
+                {
+                    int u = graph.adj_[k];
+                    if (!active[u])
+                        continue;
+                    ++relaxNum[tid];
+                    hv = std::min(hv, h[u] + g * graph.dist_[k]);
+                }
+                changed[v] = hv < h[v];
+                if (changed[v])
+                {
+                    next[v] = hv;
+                    ++updateNum[tid];
+                }
+            }
+        });
+        ++stat.sweepNum_;
+
+        any = false;
+        for (int t = 0; t < threadNum; ++t)
+        {
+            stat.updateNum_ += updateNum[t];
+            stat.relaxNum_ += relaxNum[t];
+            any = any || updateNum[t] > 0;
+        }
+        ComParallelFor(0, n, threadNum, [&](int, int first, int last) {
+            for (int v = first; v < last; ++v)
+            {
+                if (changed[v])
+                    h[v] = next[v];
+            }
+        });
+        active.swap(changed);
+    }
+
+    stat.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stat;
+}
+
+void ComOctreeLeafGraph(const SizingOctree &tree, int threadNum, GradationGraph &graph)
+{
+    graph.start_.clear();
+    graph.adj_.clear();
+    graph.dist_.clear();
+    int leafNum = tree.leafNum();
+    graph.start_.assign(leafNum + 1, 0);
+    if (leafNum == 0)
+        return;
+
+    const std::vector<SizingOctreeNode> &nodes = tree.nodes();
+    const std::vector<int> &leafNodes = tree.leafNodes();
+    const SizingOctreeNode &root = nodes[0];
+    double eps = 0.5 * tree.minHalf();
+
+    // 每个叶子 6 个面外探测点所在的叶子，-1 表示位于包围盒外或为自身
+    std::vector<int> probe(6 * static_cast<size_t>(leafNum), -1);
+    ComParallelFor(0, leafNum, threadNum, [&](int, int first, int last) {
+        for (int l = first; l < last; ++l)
+        {
+            const SizingOctreeNode &node = nodes[leafNodes[l]];
+            for (int f = 0; f < 6; ++f)
+            {
+                int axis = f >> 1;
+                double p[3] = {node.center_[0], node.center_[1], node.center_[2]};
+                p[axis] += (f & 1 ? 1. : -1.) * (node.half_ + eps);
+                if (std::fabs(p[axis] - root.center_[axis]) > root.half_)
+                    continue;
+                int m = nodes[tree.locate(p)].leaf_;
+                if (m != l)
+                    probe[6 * static_cast<size_t>(l) + f] = m;
+            }
+        }
+    });
+
+    // 对称化并去重
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(2 * probe.size());
+    for (int l = 0; l < leafNum; ++l)
+    {
+        for (int f = 0; f < 6; ++f)
+        {
+            int m = probe[6 * static_cast<size_t>(l) + f];
+            if (m < 0)
+                continue;
+            edges.push_back({l, m});
+            edges.push_back({m, l});
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    graph.adj_.resize(edges.size());
+    graph.dist_.resize(edges.size());
+    for (const auto &e : edges)
+        ++graph.start_[e.first + 1];
+    for (int l = 0; l < leafNum; ++l)
+        graph.start_[l + 1] += graph.start_[l];
+    ComParallelFor(0, static_cast<int>(edges.size()), threadNum, [&](int, int first, int last) {
+        for (int k = first; k < last; ++k)
+        {
+            const SizingOctreeNode &a = nodes[leafNodes[edges[k].first]];
+            const SizingOctreeNode &b = nodes[leafNodes[edges[k].second]];
+            double d2 = 0.;
+            for (int j = 0; j < 3; ++j)
+                d2 += (a.center_[j] - b.center_[j]) * (a.center_[j] - b.center_[j]);
+            graph.adj_[k] = edges[k].second;
+            graph.dist_[k] = std::sqrt(d2);
+        }
+    });
+}
+
+GradationStat ComGradeSizingOctree(SizingOctree &tree, double ratioFactor, int threadNum)
+{
+    auto start = std::chrono::steady_clock::now();
+    GradationGraph graph;
+    ComOctreeLeafGraph(tree, threadNum, graph);
+    GradationStat stat = ComGradation(graph, ratioFactor, threadNum, tree.leafSize().data());
+    tree.updateCorners();
+    stat.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stat;
+}
+
+std::string ComGradationPerf(const GradationStat &stat, LogFileFormat format)
+{
+    return ComTelemetryFields({{"task", "gradation"},
+                               {"sweeps", ComTelemetryValue(stat.sweepNum_)},
+                               {"updates", ComTelemetryValue(stat.updateNum_)},
+                               {"relaxations", ComTelemetryValue(stat.relaxNum_)},
+                               {"seconds", ComTelemetryValue(stat.seconds_)}},
+                              format);
+}
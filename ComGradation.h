@@ -0,0 +1,71 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComGradation.h
+// 摘    要：尺寸场梯度控制：在邻接图上以并行 Jacobi 扫描求 h_j <= h_i + (ratioFactor_-1)·d_ij
+//           的不动点，结果与串行 Dijkstra 式传播一致；提供八叉树叶子邻接图的构建
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMGRADATION_H_
+#define EMMPMESH_COMMON_COMGRADATION_H_
+
+#include "ComConstants.h"
+#include "ComSizingOctree.h"
+
+#include <string>
+#include <vector>
+
+// 邻接图（CSR 格式），顶点 v 的邻居为 adj_[start_[v] .. start_[v+1])，dist_ 为对应边长
+struct GradationGraph
+{
+    std::vector<int> start_;   // 邻居起始下标，长度为顶点个数 + 1
+    std::vector<int> adj_;     // 邻居
+    std::vector<double> dist_; // 边长
+
+    int vertNum() const { return start_.empty() ? 0 : static_cast<int>(start_.size()) - 1; }
+};
+
+// 梯度控制统计
+struct GradationStat
+{
+    int sweepNum_ = 0;        // Jacobi 扫描次数（含最后一次无更新的扫描）
+    long long updateNum_ = 0; // 尺寸下降次数
+    long long relaxNum_ = 0;  // 边松弛次数
+    double seconds_ = 0.;     // 耗时（秒）
+};
+
+/************************************************************************
+* 功能描述：梯度控制。h 为顶点尺寸，原地修改为满足 h_j <= h_i + (ratioFactor-1)·d_ij 的
+*           最大尺寸，即 h_j = min_i {h_i + (ratioFactor-1)·dist(i, j)}。
+*           每次扫描并行地只从上一次扫描中下降的邻居拉取更新（双缓冲），
+*           尺寸不再变化时停止；不动点唯一，结果与线程数及串行传播相同
+* 返回值：GradationStat - 扫描次数与耗时
+* 作者：邓龙威
+/************************************************************************/
+GradationStat ComGradation(const GradationGraph &graph, double ratioFactor, int threadNum, double *h);
+
+/************************************************************************
+* 功能描述：构建八叉树叶子的面邻接图，边长为叶子中心距离。每个叶子向 6 个面外探测一次，
+*           较小叶子总能探测到相邻的较大叶子，对称化后得到完整的面邻接
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComOctreeLeafGraph(const SizingOctree &tree, int threadNum, GradationGraph &graph);
+
+/************************************************************************
+* 功能描述：对八叉树叶子尺寸进行梯度控制并更新角点尺寸
+* 返回值：GradationStat - 扫描次数与耗时（含邻接图构建）
+* 作者：邓龙威
+/************************************************************************/
+GradationStat ComGradeSizingOctree(SizingOctree &tree, double ratioFactor, int threadNum);
+
+/************************************************************************
+* 功能描述：LogLevel::Perf 消息：扫描次数、更新次数、松弛次数与耗时，
+*           format 为 Text / Logfmt 时为 key=value 串，Json 时为 JSON 对象
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComGradationPerf(const GradationStat &stat, LogFileFormat format);
+
+#endif // EMMPMESH_COMMON_COMGRADATION_H_
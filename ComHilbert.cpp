@@ -0,0 +1,141 @@
+#include "pch.h"
+
+#include "ComHilbert.h"
+#include "ComParallel.h"
+
+#include <limits>
+#include <random>
+#include <utility>
+
+uint64_t ComHilbertKey(uint32_t x, uint32_t y, uint32_t z, int bits)
+{
+    uint32_t X[3] = {x, y, z};
+    uint32_t M = 1u << (bits - 1);
+
+    // 逆向消除旋转与翻转
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+        uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (X[i] & Q)
+            {
+                X[0] ^= P;
+            }
+            else
+            {
+                uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray 编码
+    for (int i = 1; i < 3; ++i)
+        X[i] ^= X[i - 1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+        if (X[2] & Q)
+            t ^= Q - 1;
+    }
+    for (int i = 0; i < 3; ++i)
+        X[i] ^= t;
+
+    // 按位交错
+    uint64_t key = 0;
+    for (int b = bits - 1; b >= 0; --b)
+    {
+        for (int i = 0; i < 3; ++i)
+            key = (key << 1) | ((X[i] >> b) & 1u);
+    }
+    return key;
+}
+
+void ComHilbertSort(const double *coords, std::vector<int> &index, int threadNum)
+{
+    int n = static_cast<int>(index.size());
+    if (n <= 1)
+        return;
+
+    double lo[3], hi[3];
+    for (int j = 0; j < 3; ++j)
+    {
+        lo[j] = std::numeric_limits<double>::max();
+        hi[j] = -std::numeric_limits<double>::max();
+    }
+    for (int v : index)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            lo[j] = std::min(lo[j], coords[3 * v + j]);
+            hi[j] = std::max(hi[j], coords[3 * v + j]);
+        }
+    }
+    double extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+    const int bits = 21;
+    const double cells = static_cast<double>((1u << bits) - 1);
+    double scale = extent > 0. ? cells / extent : 0.;
+
+    std::vector<std::pair<uint64_t, int>> keys(n);
+    ComParallelFor(0, n, threadNum, [&](int, int first, int last) {
+        for (int i = first; i < last; ++i)
+        {
+            const double *p = coords + 3 * index[i];
+            uint32_t q[3];
+            for (int j = 0; j < 3; ++j)
+                q[j] = static_cast<uint32_t>(std::min(cells, std::max(0., (p[j] - lo[j]) * scale)));
+            keys[i] = {ComHilbertKey(q[0], q[1], q[2], bits), index[i]};
+        }
+    });
+    std::sort(keys.begin(), keys.end());
+    for (int i = 0; i < n; ++i)
+        index[i] = keys[i].second;
+}
+
+void ComSfcPartition(const double *coords, int pointNum, int partNum, int threadNum, std::vector<int> &part)
+{
+    part.assign(pointNum, 0);
+    partNum = std::max(1, std::min(partNum, pointNum));
+    if (partNum <= 1)
+        return;
+
+    std::vector<int> order(pointNum);
+    for (int i = 0; i < pointNum; ++i)
+        order[i] = i;
+    ComHilbertSort(coords, order, threadNum);
+    for (int i = 0; i < pointNum; ++i)
+        part[order[i]] = static_cast<int>(static_cast<long long>(i) * partNum / pointNum);
+}
+
+void ComRandomShuffle(std::vector<int> &index, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    for (size_t i = index.size(); i > 1; --i)
+        std::swap(index[i - 1], index[rng() % i]);
+}
+
+void ComBrioSort(const double *coords, std::vector<int> &index, int threadNum, unsigned int seed, int minRound)
+{
+    int n = static_cast<int>(index.size());
+    ComRandomShuffle(index, seed);
+
+    // 轮次边界（从后向前）：n, n/2, n/4, ..., 0
+    std::vector<int> bounds = {n};
+    for (int end = n; end > std::max(minRound, 1);)
+    {
+        end /= 2;
+        bounds.push_back(end);
+    }
+    if (bounds.back() != 0)
+        bounds.push_back(0);
+
+    std::vector<int> round;
+    for (size_t r = bounds.size() - 1; r > 0; --r)
+    {
+        round.assign(index.begin() + bounds[r], index.begin() + bounds[r - 1]);
+        ComHilbertSort(coords, round, threadNum);
+        std::copy(round.begin(), round.end(), index.begin() + bounds[r]);
+    }
+}
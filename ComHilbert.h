@@ -0,0 +1,54 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComHilbert.h
+// 摘    要：三维 Hilbert 空间填充曲线：编码、点排序与按曲线顺序的均衡区域划分
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMHILBERT_H_
+#define EMMPMESH_COMMON_COMHILBERT_H_
+
+#include <cstdint>
+#include <vector>
+
+/************************************************************************
+* 功能描述：整数坐标（每轴 bits 位，bits <= 21）的 Hilbert 编码（Skilling, 2004）
+* 返回值：uint64_t - 曲线上的序号
+* 作者：邓龙威
+/************************************************************************/
+uint64_t ComHilbertKey(uint32_t x, uint32_t y, uint32_t z, int bits = 21);
+
+/************************************************************************
+* 功能描述：按 Hilbert 曲线顺序排序点编号 index（原地），坐标在 index 所含点的包围盒内
+*           量化到 2^21 网格；编码并行计算，键值相同时按编号排序，结果与线程数无关
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComHilbertSort(const double *coords, std::vector<int> &index, int threadNum);
+
+/************************************************************************
+* 功能描述：按 Hilbert 曲线顺序将 pointNum 个点均分为 partNum 个子区域，
+*           part[i] 为点 i 所属子区域编号；曲线的局部性使子区域紧凑、界面较小
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComSfcPartition(const double *coords, int pointNum, int partNum, int threadNum, std::vector<int> &part);
+
+/************************************************************************
+* 功能描述：以 seed 为种子随机打乱 index（Fisher-Yates，结果与平台无关）
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComRandomShuffle(std::vector<int> &index, unsigned int seed);
+
+/************************************************************************
+* 功能描述：有偏随机插入顺序（BRIO，Amenta et al., 2003）：随机打乱后分轮，
+*           末轮为后一半点，前一轮为其余点的后一半，依次类推，首轮不多于 minRound 个点；
+*           每轮内按 Hilbert 曲线排序。兼顾随机插入的期望复杂度与曲线顺序的定位局部性
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComBrioSort(const double *coords, std::vector<int> &index, int threadNum, unsigned int seed, int minRound = 64);
+
+#endif // EMMPMESH_COMMON_COMHILBERT_H_
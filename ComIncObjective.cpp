@@ -0,0 +1,215 @@
+#include "pch.h"
+
+#include "ComIncObjective.h"
+
+#include <cmath>
+#include <limits>
+
+void IncrementalObjective::init(CalculateWay way, double p, bool useLogBarrier, double mu, int elemNum,
+                                int recomputeInterval, int threadNum, bool deterministic)
+{
+    way_ = way;
+    p_ = p;
+    useLogBarrier_ = useLogBarrier;
+    mu_ = mu;
+    elemNum_ = elemNum;
+    recomputeInterval_ = recomputeInterval;
+    threadNum_ = threadNum;
+    deterministic_ = deterministic;
+
+    f_.assign(elemNum, 0.);
+    term_.assign(elemNum, 0.);
+    s_.assign(useLogBarrier ? elemNum : 0, 1.);
+    bar_.assign(useLogBarrier ? elemNum : 0, 0.);
+
+    tree_.clear();
+    if (way == CalculateWay::MAX)
+    {
+        leafBase_ = 1;
+        while (leafBase_ < elemNum)
+            leafBase_ <<= 1;
+        tree_.assign(2 * static_cast<size_t>(leafBase_), -std::numeric_limits<double>::max());
+    }
+
+    termSum_ = NeumaierSum();
+    barSum_ = NeumaierSum();
+    value_ = 0.;
+    commitNum_ = 0;
+    recomputeNum_ = 0;
+}
+
+void IncrementalObjective::init(const MeshOptiOptions &opts, int elemNum)
+{
+    init(opts.calculateWay_, opts.p_, opts.useLogBarrier_, opts.logBarrier_, elemNum,
+         opts.objectiveRecomputeInterval_, opts.threadNum_, opts.deterministic_);
+}
+
+double IncrementalObjective::term(double f) const
+{
+    switch (way_)
+    {
+    case CalculateWay::P_NORM:
+    case CalculateWay::P_NORM_LIMIT:
+        return p_ == 2. ? f * f : std::pow(std::fabs(f), p_);
+    default:
+        return f;
+    }
+}
+
+double IncrementalObjective::aggregate(double termSum) const
+{
+    if (elemNum_ <= 0)
+        return 0.;
+    switch (way_)
+    {
+    case CalculateWay::SUM:
+        return termSum;
+    case CalculateWay::MAX:
+        return treeMax();
+    case CalculateWay::P_NORM:
+        return std::pow(std::max(termSum, 0.) / elemNum_, 1. / p_);
+    case CalculateWay::P_NORM_LIMIT:
+        return std::pow(std::max(termSum, 0.), 1. / p_);
+    default:
+        return termSum;
+    }
+}
+
+void IncrementalObjective::treeUpdate(int e, double f)
+{
+    size_t i = static_cast<size_t>(leafBase_) + e;
+    tree_[i] = f;
+    for (i >>= 1; i >= 1; i >>= 1)
+        tree_[i] = std::max(tree_[2 * i], tree_[2 * i + 1]);
+}
+
+double IncrementalObjective::reset(const double *f, const double *s)
+{
+    for (int e = 0; e < elemNum_; ++e)
+    {
+        f_[e] = f[e];
+        term_[e] = term(f[e]);
+        if (useLogBarrier_)
+        {
+            s_[e] = s[e];
+            bar_[e] = s[e] > 0. ? -std::log(s[e]) : std::numeric_limits<double>::infinity();
+        }
+    }
+    if (way_ == CalculateWay::MAX)
+    {
+        std::fill(tree_.begin(), tree_.end(), -std::numeric_limits<double>::max());
+        std::copy(f_.begin(), f_.end(), tree_.begin() + leafBase_);
+        for (int i = leafBase_ - 1; i >= 1; --i)
+            tree_[i] = std::max(tree_[2 * i], tree_[2 * i + 1]);
+    }
+    return recompute();
+}
+
+double IncrementalObjective::recompute()
+{
+    termSum_ = NeumaierSum();
+    termSum_.sum_ = ComReduceSum(term_.data(), elemNum_, threadNum_, deterministic_);
+    barSum_ = NeumaierSum();
+    if (useLogBarrier_)
+        barSum_.sum_ = ComReduceSum(bar_.data(), elemNum_, threadNum_, deterministic_);
+
+    commitNum_ = 0;
+    ++recomputeNum_;
+    value_ = aggregate(termSum_.value()) + (useLogBarrier_ ? mu_ * barSum_.value() : 0.);
+    return value_;
+}
+
+double IncrementalObjective::trial(const int *elems, const double *f, const double *s, int num)
+{
+    NeumaierSum termSum = termSum_;
+    NeumaierSum barSum = barSum_;
+    for (int i = 0; i < num; ++i)
+    {
+        int e = elems[i];
+        termSum.add(term(f[i]) - term_[e]);
+        if (useLogBarrier_)
+        {
+            if (s[i] <= 0.)
+                return std::numeric_limits<double>::infinity();
+            barSum.add(-std::log(s[i]) - bar_[e]);
+        }
+    }
+
+    double agg;
+    if (way_ == CalculateWay::MAX)
+    {
+        // 暂时写入线段树取最大值后恢复
+        saved_.resize(num);
+        for (int i = 0; i < num; ++i)
+        {
+            saved_[i] = f_[elems[i]];
+            treeUpdate(elems[i], f[i]);
+        }
+        agg = treeMax();
+        for (int i = num - 1; i >= 0; --i)
+            treeUpdate(elems[i], saved_[i]);
+    }
+    else
+    {
+        agg = aggregate(termSum.value());
+    }
+    return agg + (useLogBarrier_ ? mu_ * barSum.value() : 0.);
+}
+
+double IncrementalObjective::commit(const int *elems, const double *f, const double *s, int num)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        int e = elems[i];
+        double t = term(f[i]);
+        termSum_.add(t - term_[e]);
+        term_[e] = t;
+        f_[e] = f[i];
+        if (way_ == CalculateWay::MAX)
+            treeUpdate(e, f[i]);
+        if (useLogBarrier_)
+        {
+            double b = s[i] > 0. ? -std::log(s[i]) : std::numeric_limits<double>::infinity();
+            barSum_.add(b - bar_[e]);
+            bar_[e] = b;
+            s_[e] = s[i];
+        }
+    }
+
+    if (recomputeInterval_ > 0 && ++commitNum_ >= recomputeInterval_)
+        return recompute();
+    value_ = aggregate(termSum_.value()) + (useLogBarrier_ ? mu_ * barSum_.value() : 0.);
+    return value_;
+}
+
+double IncrementalObjective::termWeight(int e) const
+{
+    double f = f_[e];
+    switch (way_)
+    {
+    case CalculateWay::SUM:
+        return 1.;
+    case CalculateWay::MAX:
+        return f == treeMax() ? 1. : 0.;
+    case CalculateWay::P_NORM:
+    case CalculateWay::P_NORM_LIMIT:
+        {
+            // F = (S / c)^(1/p)  =>  ∂F/∂f_e = |f_e|^(p-1) sign(f_e) / (c F^(p-1))
+            double c = way_ == CalculateWay::P_NORM ? static_cast<double>(elemNum_) : 1.;
+            double agg = aggregate(termSum_.value());
+            if (agg <= 0.)
+                return 0.;
+            double w = std::pow(std::fabs(f), p_ - 1.) / (c * std::pow(agg, p_ - 1.));
+            return f < 0. ? -w : w;
+        }
+    default:
+        return 1.;
+    }
+}
+
+double IncrementalObjective::barrierWeight(int e) const
+{
+    if (!useLogBarrier_ || s_[e] <= 0.)
+        return 0.;
+    return -mu_ / s_[e];
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComIncObjective.h
+// 摘    要：增量目标函数：缓存每个单元的质量函数项与对数屏障项，顶点移动时只更新其关联单元，
+//           按 CalculateWay 增量维护聚合值，并定期精确重算以限制累积误差
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMINCOBJECTIVE_H_
+#define EMMPMESH_COMMON_COMINCOBJECTIVE_H_
+
+#include "ComConstants.h"
+#include "ComReduce.h"
+
+#include <vector>
+
+// 增量目标函数。目标函数为
+//   F = Agg(f_1, ..., f_n) + mu * Σ -log(s_e)
+// 其中 f_e 为单元 e 的加权质量函数值，Agg 由 CalculateWay 决定：
+//   SUM：Σ f_e；MAX：max f_e；P_NORM：(Σ |f_e|^p / n)^(1/p)；P_NORM_LIMIT：(Σ |f_e|^p)^(1/p)；
+// s_e 为屏障参数（> 0，如归一化体积），未使用对数屏障时忽略。
+// 单元编号为空腔（或全局）内的局部编号 0 .. n-1
+class IncrementalObjective
+{
+public:
+    IncrementalObjective() = default;
+
+    /************************************************************************
+    * 功能描述：设置计算方式与单元个数，可重复调用以复用内存。
+    *           recomputeInterval 为精确重算间隔（提交次数），<= 0 表示不定期重算；
+    *           threadNum 为精确重算的线程数，全局模式下有效；deterministic 选择精确重算的
+    *           归约方式（ComReduceSum），为 true 时结果与线程数无关
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void init(CalculateWay way, double p, bool useLogBarrier, double mu, int elemNum,
+              int recomputeInterval = 64, int threadNum = 1, bool deterministic = true);
+
+    /************************************************************************
+    * 功能描述：按 opts 的 calculateWay_、p_、useLogBarrier_、logBarrier_、
+    *           objectiveRecomputeInterval_、threadNum_ 与 deterministic_ 初始化
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void init(const MeshOptiOptions &opts, int elemNum);
+
+    /************************************************************************
+    * 功能描述：设置全部单元的项并精确计算，s 在未使用对数屏障时可为空
+    * 返回值：double - 目标函数值
+    * 作者：邓龙威
+    /************************************************************************/
+    double reset(const double *f, const double *s);
+
+    /************************************************************************
+    * 功能描述：试探步：以 num 个单元 elems 的新值 f / s 代替缓存值计算目标函数，不修改缓存。
+    *           任一 s <= 0 时返回 +∞（越过屏障）
+    * 返回值：double
+    * 作者：邓龙威
+    /************************************************************************/
+    double trial(const int *elems, const double *f, const double *s, int num);
+
+    /************************************************************************
+    * 功能描述：接受试探步，更新缓存与聚合值；每 recomputeInterval 次提交精确重算一次
+    * 返回值：double - 更新后的目标函数值
+    * 作者：邓龙威
+    /************************************************************************/
+    double commit(const int *elems, const double *f, const double *s, int num);
+
+    /************************************************************************
+    * 功能描述：按缓存项精确重算聚合值（确定性时为分块补偿求和，结果与线程数无关）
+    * 返回值：double - 目标函数值
+    * 作者：邓龙威
+    /************************************************************************/
+    double recompute();
+
+    double value() const { return value_; }
+
+    /************************************************************************
+    * 功能描述：链式法则系数。∂F/∂f_e = termWeight(e)，屏障项 ∂F/∂s_e = barrierWeight(e)，
+    *           梯度组装为 Σ termWeight(e) ∇f_e + Σ barrierWeight(e) ∇s_e。
+    *           MAX 时只有取到最大值的单元系数为 1
+    * 返回值：double
+    * 作者：邓龙威
+    /************************************************************************/
+    double termWeight(int e) const;
+    double barrierWeight(int e) const;
+
+    int recomputeNum() const { return recomputeNum_; }
+
+private:
+    double term(double f) const;            // 单元项对聚合和的贡献（SUM 为 f，P_NORM 为 |f|^p）
+    double aggregate(double termSum) const; // 由项之和得到聚合值
+    void treeUpdate(int e, double f);       // MAX 的线段树更新
+    double treeMax() const { return tree_.empty() ? 0. : tree_[1]; }
+
+    CalculateWay way_ = CalculateWay::P_NORM; // 计算方式
+    double p_ = 2.;                           // p 范数的 p 值
+    bool useLogBarrier_ = false;              // 是否使用对数屏障
+    double mu_ = 0.;                          // 对数屏障系数
+    int elemNum_ = 0;                         // 单元个数
+    int recomputeInterval_ = 64;              // 精确重算间隔
+    int threadNum_ = 1;                       // 精确重算线程数
+    bool deterministic_ = true;               // 精确重算是否使用确定性归约
+
+    std::vector<double> f_;    // 单元质量函数值
+    std::vector<double> term_; // 单元项
+    std::vector<double> s_;    // 单元屏障参数
+    std::vector<double> bar_;  // 单元屏障项 -log(s_e)
+    std::vector<double> tree_; // MAX 的线段树（叶子从 leafBase_ 开始）
+    int leafBase_ = 1;         // 线段树叶子起始下标
+
+    NeumaierSum termSum_;       // 单元项之和
+    NeumaierSum barSum_;        // 屏障项之和
+    double value_ = 0.;         // 当前目标函数值
+    int commitNum_ = 0;         // 自上次精确重算以来的提交次数
+    int recomputeNum_ = 0;      // 精确重算次数
+    std::vector<double> saved_; // 试探步时暂存的线段树叶子
+};
+
+#endif // EMMPMESH_COMMON_COMINCOBJECTIVE_H_
@@ -0,0 +1,142 @@
+#include "pch.h"
+
+#include "ComLegality.h"
+#include "ComParallel.h"
+#include "ComPredicates.h"
+
+#include <cmath>
+
+// 取顶点坐标，movedVert 以 movedPos 代替
+static inline const double *ComLegalityVert(const double *coords, int v, int movedVert, const double *movedPos)
+{
+    return v == movedVert ? movedPos : coords + 3 * static_cast<size_t>(v);
+}
+
+// 检查 [first, first+num) 批次（num <= ComLegalityBatch），sign[i] 返回每个单元的方向符号
+static void ComOrientBatch(const double *coords, const int *tets, int first, int num,
+                           int movedVert, const double *movedPos, int *sign)
+{
+    // SoA 布局：u = b-a，v = c-a，w = d-a
+    double ux[ComLegalityBatch], uy[ComLegalityBatch], uz[ComLegalityBatch];
+    double vx[ComLegalityBatch], vy[ComLegalityBatch], vz[ComLegalityBatch];
+    double wx[ComLegalityBatch], wy[ComLegalityBatch], wz[ComLegalityBatch];
+    for (int i = 0; i < ComLegalityBatch; ++i)
+    {
+        if (i < num)
+        {
+            const int *t = tets + 4 * static_cast<size_t>(first + i);
+            const double *pa = ComLegalityVert(coords, t[0], movedVert, movedPos);
+            const double *pb = ComLegalityVert(coords, t[1], movedVert, movedPos);
+            const double *pc = ComLegalityVert(coords, t[2], movedVert, movedPos);
+            const double *pd = ComLegalityVert(coords, t[3], movedVert, movedPos);
+            ux[i] = pb[0] - pa[0], uy[i] = pb[1] - pa[1], uz[i] = pb[2] - pa[2];
+            vx[i] = pc[0] - pa[0], vy[i] = pc[1] - pa[1], vz[i] = pc[2] - pa[2];
+            wx[i] = pd[0] - pa[0], wy[i] = pd[1] - pa[1], wz[i] = pd[2] - pa[2];
+        }
+        else
+        {
+            // 尾部填充为单位正四面体，保证定长循环
+            ux[i] = 1., uy[i] = 0., uz[i] = 0.;
+            vx[i] = 0., vy[i] = 1., vz[i] = 0.;
+            wx[i] = 0., wy[i] = 0., wz[i] = 1.;
+        }
+    }
+
+    // 定长、无分支的内层循环，由编译器向量化
+    double det[ComLegalityBatch], bound[ComLegalityBatch];
+    for (int i = 0; i < ComLegalityBatch; ++i)
+    {
+        double m1 = vy[i] * wz[i], m2 = vz[i] * wy[i];
+        double m3 = vz[i] * wx[i], m4 = vx[i] * wz[i];
+        double m5 = vx[i] * wy[i], m6 = vy[i] * wx[i];
+        det[i] = ux[i] * (m1 - m2) + uy[i] * (m3 - m4) + uz[i] * (m5 - m6);
+        bound[i] = ComOrient3dErrBound *
+                   (std::fabs(ux[i]) * (std::fabs(m1) + std::fabs(m2)) +
+                    std::fabs(uy[i]) * (std::fabs(m3) + std::fabs(m4)) +
+                    std::fabs(uz[i]) * (std::fabs(m5) + std::fabs(m6)));
+    }
+
+    for (int i = 0; i < num; ++i)
+    {
+        if (det[i] > bound[i])
+            sign[i] = 1;
+        else if (-det[i] > bound[i])
+            sign[i] = -1;
+        else
+        {
+            // 近退化单元：回退精确谓词
+            const int *t = tets + 4 * static_cast<size_t>(first + i);
+            sign[i] = ComOrient3dExact(ComLegalityVert(coords, t[0], movedVert, movedPos),
+                                       ComLegalityVert(coords, t[1], movedVert, movedPos),
+                                       ComLegalityVert(coords, t[2], movedVert, movedPos),
+                                       ComLegalityVert(coords, t[3], movedVert, movedPos));
+        }
+    }
+}
+
+bool ComCheckTetsLegal(const double *coords, const int *tets, int tetNum, int movedVert, const double *movedPos)
+{
+    int sign[ComLegalityBatch];
+    for (int first = 0; first < tetNum; first += ComLegalityBatch)
+    {
+        int num = std::min(ComLegalityBatch, tetNum - first);
+        ComOrientBatch(coords, tets, first, num, movedVert, movedPos, sign);
+        for (int i = 0; i < num; ++i)
+        {
+            if (sign[i] <= 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+int ComCollectIllegalTets(const double *coords, const int *tets, int tetNum, std::vector<int> &illegal,
+                          int movedVert, const double *movedPos)
+{
+    illegal.clear();
+    int sign[ComLegalityBatch];
+    for (int first = 0; first < tetNum; first += ComLegalityBatch)
+    {
+        int num = std::min(ComLegalityBatch, tetNum - first);
+        ComOrientBatch(coords, tets, first, num, movedVert, movedPos, sign);
+        for (int i = 0; i < num; ++i)
+        {
+            if (sign[i] <= 0)
+                illegal.push_back(first + i);
+        }
+    }
+    return static_cast<int>(illegal.size());
+}
+
+int ComScanMeshLegality(const Mesh &mesh, int threadNum, std::vector<int> &illegal)
+{
+    illegal.clear();
+    auto vertIt = mesh.find(MeshElementType::Vertex);
+    auto regIt = mesh.find(MeshElementType::Region);
+    if (vertIt == mesh.end() || regIt == mesh.end() || !vertIt->second || !regIt->second)
+        return 0;
+
+    const auto *verts = dynamic_cast<const TypedVectorHolder<double> *>(vertIt->second.get());
+    const auto *regs = dynamic_cast<const TypedVectorHolder<int> *>(regIt->second.get());
+    if (!verts || !regs)
+        return 0;
+
+    const double *coords = verts->data_typed();
+    const int *tets = regs->data_typed();
+    int tetNum = static_cast<int>(regs->size() / 4);
+
+    threadNum = ComThreadNum(threadNum);
+    std::vector<std::vector<int>> local(threadNum);
+    ComParallelFor(0, tetNum, threadNum, [&](int tid, int first, int last) {
+        std::vector<int> part;
+        ComCollectIllegalTets(coords, tets + 4 * static_cast<size_t>(first), last - first, part);
+        for (int &idx : part)
+            idx += first;
+        local[tid].swap(part);
+    });
+
+    // 各线程负责连续区间，按线程序号拼接即为升序
+    for (auto &part : local)
+        illegal.insert(illegal.end(), part.begin(), part.end());
+    return static_cast<int>(illegal.size());
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComLegality.h
+// 摘    要：四面体网格合法性（无翻转单元）批量检查，支持空腔试探步检查与全网格并行扫描
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMLEGALITY_H_
+#define EMMPMESH_COMMON_COMLEGALITY_H_
+
+#include "ComConstants.h"
+
+#include <vector>
+
+// 批处理宽度：每批按 SoA 布局计算的四面体个数，定长内层循环便于编译器向量化
+inline const int ComLegalityBatch = 8;
+
+/************************************************************************
+* 功能描述：批量检查四面体是否均为正向（6 倍有向体积 > 0）。
+*           coords 为全局顶点坐标（每个顶点 3 个 double），tets 为 tetNum 个四面体的顶点编号；
+*           movedVert >= 0 时，该顶点坐标以 movedPos 代替（用于光滑试探步，无需写回坐标）。
+*           先以浮点过滤批量判断，误差界内的近退化单元回退精确谓词
+* 返回值：bool - 全部合法返回 true；遇到第一个非法批次即返回 false
+* 作者：邓龙威
+/************************************************************************/
+bool ComCheckTetsLegal(const double *coords, const int *tets, int tetNum,
+                       int movedVert = -1, const double *movedPos = nullptr);
+
+/************************************************************************
+* 功能描述：与 ComCheckTetsLegal 相同，但检查全部单元并返回非法单元在 tets 中的序号
+* 返回值：int - 非法单元个数
+* 作者：邓龙威
+/************************************************************************/
+int ComCollectIllegalTets(const double *coords, const int *tets, int tetNum,
+                          std::vector<int> &illegal,
+                          int movedVert = -1, const double *movedPos = nullptr);
+
+/************************************************************************
+* 功能描述：全网格并行合法性扫描，用于验证优化结果。
+*           illegal 返回全部翻转 / 退化体单元编号（升序，与线程数无关）
+* 返回值：int - 非法单元个数
+* 作者：邓龙威
+/************************************************************************/
+int ComScanMeshLegality(const Mesh &mesh, int threadNum, std::vector<int> &illegal);
+
+#endif // EMMPMESH_COMMON_COMLEGALITY_H_
@@ -0,0 +1,604 @@
+#include "pch.h"
+
+#include "ComLocalRemesh.h"
+#include "ComDelaunay.h"
+#include "ComParallel.h"
+#include "ComPredicates.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+
+// 候选重剖分结果状态
+enum class RemeshState
+{
+    OK = 0,       // 可拼接
+    FAILED = 1,   // 填充失败或结果不协调
+    REJECTED = 2, // 最差质量未改善
+};
+
+// 单个簇的候选重剖分结果
+struct RemeshCandidate
+{
+    RemeshState state_ = RemeshState::FAILED;
+    std::vector<double> newPos_;     // 新增顶点坐标
+    std::vector<int> newTets_;       // 新单元，新增顶点编号为 vertNum + k
+    std::vector<double> newQuality_; // 新单元质量
+};
+
+int ComExtractBadClusters(const int *tets, const int *neig, const double *quality, int tetNum,
+                          double badQuality, int growLayer, int maxClusterSize,
+                          std::vector<RemeshCluster> &clusters, int *skipped)
+{
+    clusters.clear();
+    if (skipped)
+        *skipped = 0;
+
+    // 劣质单元向外扩展 growLayer 层
+    std::vector<char> mark(tetNum, 0);
+    std::vector<int> front, next;
+    for (int t = 0; t < tetNum; ++t)
+    {
+        if (quality[t] < badQuality)
+        {
+            mark[t] = 1;
+            front.push_back(t);
+        }
+    }
+    for (int layer = 0; layer < growLayer && !front.empty(); ++layer)
+    {
+        next.clear();
+        for (int t : front)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                int n = neig[4 * t + i];
+                if (n >= 0 && !mark[n])
+                {
+                    mark[n] = 1;
+                    next.push_back(n);
+                }
+            }
+        }
+        front.swap(next);
+    }
+
+    // 按面邻接求连通分量
+    std::vector<char> visited(tetNum, 0);
+    std::vector<int> stack;
+    for (int seed = 0; seed < tetNum; ++seed)
+    {
+        if (!mark[seed] || visited[seed])
+            continue;
+
+        RemeshCluster cluster;
+        visited[seed] = 1;
+        stack.assign(1, seed);
+        while (!stack.empty())
+        {
+            int t = stack.back();
+            stack.pop_back();
+            cluster.tets_.push_back(t);
+            for (int i = 0; i < 4; ++i)
+            {
+                int n = neig[4 * t + i];
+                if (n >= 0 && mark[n] && !visited[n])
+                {
+                    visited[n] = 1;
+                    stack.push_back(n);
+                }
+            }
+        }
+
+        if (maxClusterSize > 0 && static_cast<int>(cluster.tets_.size()) > maxClusterSize)
+        {
+            if (skipped)
+                ++*skipped;
+            continue;
+        }
+
+        // 边界面：相邻单元不在簇内（标记的相邻单元必在同一连通分量内）
+        std::sort(cluster.tets_.begin(), cluster.tets_.end());
+        std::vector<int> allVerts, faceVerts;
+        cluster.minQuality_ = std::numeric_limits<double>::max();
+        for (int t : cluster.tets_)
+        {
+            const int *tet = tets + 4 * static_cast<size_t>(t);
+            cluster.minQuality_ = std::min(cluster.minQuality_, quality[t]);
+            allVerts.insert(allVerts.end(), tet, tet + 4);
+            cluster.tetVerts_.insert(cluster.tetVerts_.end(), tet, tet + 4);
+            for (int i = 0; i < 4; ++i)
+            {
+                int n = neig[4 * t + i];
+                if (n >= 0 && mark[n])
+                    continue;
+                for (int k = 0; k < 3; ++k)
+                {
+                    cluster.faces_.push_back(tet[ComTetFaceVert[i][k]]);
+                    faceVerts.push_back(tet[ComTetFaceVert[i][k]]);
+                }
+                cluster.faceOwner_.push_back(t);
+                cluster.faceNeig_.push_back(n);
+            }
+        }
+
+        std::sort(allVerts.begin(), allVerts.end());
+        allVerts.erase(std::unique(allVerts.begin(), allVerts.end()), allVerts.end());
+        std::sort(faceVerts.begin(), faceVerts.end());
+        faceVerts.erase(std::unique(faceVerts.begin(), faceVerts.end()), faceVerts.end());
+        std::set_difference(allVerts.begin(), allVerts.end(), faceVerts.begin(), faceVerts.end(),
+                            std::back_inserter(cluster.innerVerts_));
+
+        clusters.push_back(std::move(cluster));
+    }
+    return static_cast<int>(clusters.size());
+}
+
+// 对局部点集 pts 剖分并取出空腔内的单元（局部编号）；bound 为边界面（空腔位于正侧）的键
+static bool ComCavityTetrahedralize(const std::vector<double> &pts, const std::set<std::array<int, 3>> &bound,
+                                    std::vector<int> &inside)
+{
+    inside.clear();
+    int n = static_cast<int>(pts.size() / 3);
+    DelaunayKernel kernel;
+    kernel.init(pts.data(), n);
+    for (int v = 0; v < n; ++v)
+    {
+        if (kernel.insert(v) < 0)
+            return false; // 重合点
+    }
+
+    std::vector<int> all;
+    kernel.extract(all, true);
+    int tetNum = static_cast<int>(all.size() / 4);
+    std::map<std::array<int, 3>, int> faceTet;
+    for (int t = 0; t < tetNum; ++t)
+    {
+        for (int i = 0; i < 4; ++i)
+            faceTet[ComTetFace(&all[4 * t], i)] = t;
+    }
+
+    // 边界约束：每个边界面都是剖分面，其正侧单元为泛洪起点
+    std::vector<char> visited(tetNum, 0);
+    std::vector<int> stack;
+    for (const auto &key : bound)
+    {
+        auto it = faceTet.find(key);
+        if (it == faceTet.end())
+            return false;
+        if (!visited[it->second])
+        {
+            visited[it->second] = 1;
+            stack.push_back(it->second);
+        }
+    }
+    while (!stack.empty())
+    {
+        int t = stack.back();
+        stack.pop_back();
+        const int *tet = &all[4 * t];
+        for (int i = 0; i < 4; ++i)
+        {
+            if (tet[i] >= n)
+                return false; // 到达无穷单元：边界不封闭或从外侧进入
+        }
+        inside.insert(inside.end(), tet, tet + 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            std::array<int, 3> key = ComTetFace(tet, i);
+            if (bound.count(key))
+                continue;
+            std::array<int, 3> rev = ComFaceReverse(key);
+            if (bound.count(rev))
+                return false; // 从外侧碰到边界面
+            auto it = faceTet.find(rev);
+            if (it == faceTet.end())
+                return false;
+            if (!visited[it->second])
+            {
+                visited[it->second] = 1;
+                stack.push_back(it->second);
+            }
+        }
+    }
+    return !inside.empty();
+}
+
+ComCavityFill ComMakeDelaunayCavityFill(const ComSizingFunc &size, double sizeRatio, int maxPointNum)
+{
+    return [size, sizeRatio, maxPointNum](const double *coords, int vertNum, const RemeshCluster &cluster,
+                                          std::vector<double> &newPos, std::vector<int> &newTets) {
+        newPos.clear();
+        newTets.clear();
+        if (cluster.faceOwner_.size() < 4)
+            return false;
+
+        // 局部编号：边界面顶点在前，内部点在后
+        std::vector<int> boundVerts(cluster.faces_);
+        std::sort(boundVerts.begin(), boundVerts.end());
+        boundVerts.erase(std::unique(boundVerts.begin(), boundVerts.end()), boundVerts.end());
+        int boundNum = static_cast<int>(boundVerts.size());
+        auto local = [&boundVerts](int v) {
+            return static_cast<int>(std::lower_bound(boundVerts.begin(), boundVerts.end(), v) - boundVerts.begin());
+        };
+        std::vector<double> pts;
+        for (int v : boundVerts)
+            pts.insert(pts.end(), coords + 3 * static_cast<size_t>(v), coords + 3 * static_cast<size_t>(v) + 3);
+
+        std::set<std::array<int, 3>> bound;
+        double edgeSum = 0.;
+        for (size_t f = 0; f < cluster.faceOwner_.size(); ++f)
+        {
+            const int *face = cluster.faces_.data() + 3 * f;
+            bound.insert(ComFaceRotate(local(face[0]), local(face[1]), local(face[2])));
+            for (int k = 0; k < 3; ++k)
+            {
+                const double *p = coords + 3 * static_cast<size_t>(face[k]);
+                const double *q = coords + 3 * static_cast<size_t>(face[(k + 1) % 3]);
+                edgeSum += std::sqrt((p[0] - q[0]) * (p[0] - q[0]) + (p[1] - q[1]) * (p[1] - q[1]) + (p[2] - q[2]) * (p[2] - q[2]));
+            }
+        }
+        double h0 = edgeSum / (3. * static_cast<double>(cluster.faceOwner_.size()));
+        auto target = [&](const double *p) {
+            double h = size ? size(p) : 0.;
+            return h > 0. ? h : h0;
+        };
+
+        // 1. 边界约束的剖分，失败时加入原内部顶点重试
+        std::vector<int> inside;
+        if (!ComCavityTetrahedralize(pts, bound, inside))
+        {
+            if (cluster.innerVerts_.empty())
+                return false;
+            for (int v : cluster.innerVerts_)
+                pts.insert(pts.end(), coords + 3 * static_cast<size_t>(v), coords + 3 * static_cast<size_t>(v) + 3);
+            if (!ComCavityTetrahedralize(pts, bound, inside))
+                return false;
+        }
+
+        // 2. 按尺寸细化
+        std::vector<int> refined;
+        while (static_cast<int>(pts.size() / 3) - boundNum < maxPointNum)
+        {
+            size_t oldSize = pts.size();
+            for (size_t t = 0; 4 * t < inside.size(); ++t)
+            {
+                if (static_cast<int>(pts.size() / 3) - boundNum >= maxPointNum)
+                    break;
+                const int *tet = &inside[4 * t];
+                double c[3] = {0., 0., 0.}, longest = 0.;
+                for (int i = 0; i < 4; ++i)
+                {
+                    const double *p = &pts[3 * static_cast<size_t>(tet[i])];
+                    for (int k = 0; k < 3; ++k)
+                        c[k] += 0.25 * p[k];
+                    for (int j = i + 1; j < 4; ++j)
+                    {
+                        const double *q = &pts[3 * static_cast<size_t>(tet[j])];
+                        longest = std::max(longest, (p[0] - q[0]) * (p[0] - q[0]) + (p[1] - q[1]) * (p[1] - q[1]) + (p[2] - q[2]) * (p[2] - q[2]));
+                    }
+                }
+                double h = target(c);
+                if (longest <= sizeRatio * sizeRatio * h * h)
+                    continue;
+                bool spaced = true;
+                for (size_t k = 0; k < pts.size() && spaced; k += 3)
+                {
+                    double d2 = (pts[k] - c[0]) * (pts[k] - c[0]) + (pts[k + 1] - c[1]) * (pts[k + 1] - c[1]) + (pts[k + 2] - c[2]) * (pts[k + 2] - c[2]);
+                    spaced = d2 >= 0.25 * h * h;
+                }
+                if (spaced)
+                    pts.insert(pts.end(), c, c + 3);
+            }
+            if (pts.size() == oldSize)
+                break;
+            if (!ComCavityTetrahedralize(pts, bound, refined))
+            {
+                pts.resize(oldSize); // 撤回破坏边界约束的一批点
+                break;
+            }
+            inside.swap(refined);
+        }
+
+        newPos.assign(pts.begin() + 3 * static_cast<size_t>(boundNum), pts.end());
+        newTets.reserve(inside.size());
+        for (int l : inside)
+            newTets.push_back(l < boundNum ? boundVerts[l] : vertNum + (l - boundNum));
+        return true;
+    };
+}
+
+bool ComStarCavityFill(const double *coords, int vertNum, const RemeshCluster &cluster,
+                       std::vector<double> &newPos, std::vector<int> &newTets)
+{
+    newPos.clear();
+    newTets.clear();
+    int faceNum = static_cast<int>(cluster.faceOwner_.size());
+    if (faceNum < 4)
+        return false;
+
+    auto centroid = [&](const int *verts, size_t num, double *p) {
+        p[0] = p[1] = p[2] = 0.;
+        for (size_t i = 0; i < num; ++i)
+        {
+            const double *v = coords + 3 * static_cast<size_t>(verts[i]);
+            p[0] += v[0];
+            p[1] += v[1];
+            p[2] += v[2];
+        }
+        for (int k = 0; k < 3; ++k)
+            p[k] /= static_cast<double>(num);
+    };
+
+    std::vector<std::array<double, 3>> cand;
+    std::array<double, 3> p;
+    centroid(cluster.faces_.data(), cluster.faces_.size(), p.data());
+    cand.push_back(p);
+    if (!cluster.innerVerts_.empty())
+    {
+        centroid(cluster.innerVerts_.data(), cluster.innerVerts_.size(), p.data());
+        cand.push_back(p);
+    }
+    for (size_t t = 0; 4 * t < cluster.tetVerts_.size(); ++t)
+    {
+        centroid(cluster.tetVerts_.data() + 4 * t, 4, p.data());
+        cand.push_back(p);
+    }
+
+    // 可见性度量：6 倍体积 / |2 倍面积|^1.5，即高度与面尺寸之比，与尺度无关
+    double bestScore = 0.;
+    int best = -1;
+    for (size_t c = 0; c < cand.size(); ++c)
+    {
+        double score = std::numeric_limits<double>::max();
+        for (int f = 0; f < faceNum && score > bestScore; ++f)
+        {
+            const int *face = cluster.faces_.data() + 3 * f;
+            const double *pa = coords + 3 * static_cast<size_t>(face[0]);
+            const double *pb = coords + 3 * static_cast<size_t>(face[1]);
+            const double *pc = coords + 3 * static_cast<size_t>(face[2]);
+            if (ComOrient3d(pa, pb, pc, cand[c].data()) <= 0)
+            {
+                score = 0.;
+                break;
+            }
+            double u[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+            double v[3] = {pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2]};
+            double n[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+            double area2 = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            score = std::min(score, ComOrient3dFast(pa, pb, pc, cand[c].data()) / (area2 * std::sqrt(area2)));
+        }
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = static_cast<int>(c);
+        }
+    }
+    if (best < 0)
+        return false;
+
+    newPos.assign(cand[best].begin(), cand[best].end());
+    for (int f = 0; f < faceNum; ++f)
+    {
+        const int *face = cluster.faces_.data() + 3 * f;
+        newTets.insert(newTets.end(), {face[0], face[1], face[2], vertNum});
+    }
+    return true;
+}
+
+// 填充单个簇并检查正向性、协调性与质量
+static void ComEvalCandidate(const double *coords, int vertNum, const RemeshCluster &cluster,
+                             const ComTetQuality &qualityFunc, const ComCavityFill &fill, RemeshCandidate &cand)
+{
+    cand.state_ = RemeshState::FAILED;
+    if (!fill(coords, vertNum, cluster, cand.newPos_, cand.newTets_))
+        return;
+    if (cand.newTets_.empty() || cand.newTets_.size() % 4 != 0 || cand.newPos_.size() % 3 != 0)
+        return;
+
+    int totalVertNum = vertNum + static_cast<int>(cand.newPos_.size() / 3);
+    auto point = [&](int v) {
+        return v < vertNum ? coords + 3 * static_cast<size_t>(v) : cand.newPos_.data() + 3 * static_cast<size_t>(v - vertNum);
+    };
+
+    // 协调性：每个边界面以相同方向恰好出现一次，其余面以相反方向成对出现
+    int newTetNum = static_cast<int>(cand.newTets_.size() / 4);
+    std::map<std::array<int, 3>, int> faceCount;
+    for (int t = 0; t < newTetNum; ++t)
+    {
+        const int *tet = cand.newTets_.data() + 4 * t;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (tet[i] < 0 || tet[i] >= totalVertNum)
+                return;
+            ++faceCount[ComTetFace(tet, i)];
+        }
+    }
+    for (size_t f = 0; f < cluster.faceOwner_.size(); ++f)
+    {
+        const int *face = cluster.faces_.data() + 3 * f;
+        auto it = faceCount.find(ComFaceRotate(face[0], face[1], face[2]));
+        if (it == faceCount.end() || it->second != 1)
+            return;
+        faceCount.erase(it);
+    }
+    for (const auto &[face, count] : faceCount)
+    {
+        auto it = faceCount.find(ComFaceReverse(face));
+        if (count != 1 || it == faceCount.end() || it->second != 1)
+            return;
+    }
+
+    double newMin = std::numeric_limits<double>::max();
+    cand.newQuality_.resize(newTetNum);
+    for (int t = 0; t < newTetNum; ++t)
+    {
+        const int *tet = cand.newTets_.data() + 4 * t;
+        const double *pa = point(tet[0]), *pb = point(tet[1]), *pc = point(tet[2]), *pd = point(tet[3]);
+        if (ComOrient3d(pa, pb, pc, pd) <= 0)
+            return;
+        cand.newQuality_[t] = qualityFunc(pa, pb, pc, pd);
+        newMin = std::min(newMin, cand.newQuality_[t]);
+    }
+    cand.state_ = newMin > cluster.minQuality_ ? RemeshState::OK : RemeshState::REJECTED;
+}
+
+// 将候选结果拼接回网格：新单元优先复用簇内单元编号，多余的原单元标记删除
+static void ComSpliceCandidate(std::vector<double> &coords, std::vector<int> &tets, std::vector<int> &neig,
+                               std::vector<double> &quality, std::vector<char> &dead, int vertNum,
+                               const RemeshCluster &cluster, const RemeshCandidate &cand, std::vector<int> *freedVerts)
+{
+    int newTetNum = static_cast<int>(cand.newTets_.size() / 4);
+    int newPosNum = static_cast<int>(cand.newPos_.size() / 3);
+
+    // 新增顶点优先复用不再被引用的内部顶点编号
+    std::vector<int> freeList;
+    for (int v : cluster.innerVerts_)
+    {
+        if (std::find(cand.newTets_.begin(), cand.newTets_.end(), v) == cand.newTets_.end())
+            freeList.push_back(v);
+    }
+    std::vector<int> posID(newPosNum);
+    for (int k = 0; k < newPosNum; ++k)
+    {
+        if (k < static_cast<int>(freeList.size()))
+        {
+            posID[k] = freeList[k];
+            std::copy(cand.newPos_.begin() + 3 * k, cand.newPos_.begin() + 3 * k + 3, coords.begin() + 3 * static_cast<size_t>(posID[k]));
+        }
+        else
+        {
+            posID[k] = static_cast<int>(coords.size() / 3);
+            coords.insert(coords.end(), cand.newPos_.begin() + 3 * k, cand.newPos_.begin() + 3 * k + 3);
+        }
+    }
+    if (freedVerts && newPosNum < static_cast<int>(freeList.size()))
+        freedVerts->insert(freedVerts->end(), freeList.begin() + newPosNum, freeList.end());
+
+    // 单元编号
+    std::vector<int> tetID(newTetNum);
+    int oldTetNum = static_cast<int>(cluster.tets_.size());
+    for (int t = 0; t < newTetNum; ++t)
+    {
+        if (t < oldTetNum)
+        {
+            tetID[t] = cluster.tets_[t];
+        }
+        else
+        {
+            tetID[t] = static_cast<int>(tets.size() / 4);
+            tets.resize(tets.size() + 4);
+            neig.resize(neig.size() + 4);
+            quality.push_back(0.);
+            dead.push_back(0);
+        }
+    }
+    for (int t = newTetNum; t < oldTetNum; ++t)
+        dead[cluster.tets_[t]] = 1;
+
+    std::map<std::array<int, 3>, std::pair<int, int>> faceSlot; // 有向面 -> (单元, 局部面)
+    for (int t = 0; t < newTetNum; ++t)
+    {
+        int id = tetID[t];
+        for (int i = 0; i < 4; ++i)
+        {
+            int v = cand.newTets_[4 * t + i];
+            tets[4 * id + i] = v < vertNum ? v : posID[v - vertNum];
+        }
+        quality[id] = cand.newQuality_[t];
+        for (int i = 0; i < 4; ++i)
+            faceSlot[ComTetFace(&tets[4 * id], i)] = {id, i};
+    }
+
+    // 内部面两两相邻
+    for (const auto &[face, slot] : faceSlot)
+    {
+        auto it = faceSlot.find(ComFaceReverse(face));
+        neig[4 * slot.first + slot.second] = it == faceSlot.end() ? -1 : it->second.first;
+    }
+
+    // 边界面与外侧单元相互连接；外侧单元的局部面按顶点匹配，不依赖可能已被复用的原单元编号
+    for (size_t f = 0; f < cluster.faceOwner_.size(); ++f)
+    {
+        const int *face = cluster.faces_.data() + 3 * f;
+        std::array<int, 3> key = ComFaceRotate(face[0], face[1], face[2]);
+        const auto &slot = faceSlot.at(key);
+        int outer = cluster.faceNeig_[f];
+        neig[4 * slot.first + slot.second] = outer;
+        if (outer < 0)
+            continue;
+        std::array<int, 3> outerKey = ComFaceReverse(key);
+        for (int i = 0; i < 4; ++i)
+        {
+            if (ComTetFace(&tets[4 * static_cast<size_t>(outer)], i) == outerKey)
+            {
+                neig[4 * outer + i] = slot.first;
+                break;
+            }
+        }
+    }
+}
+
+LocalRemeshStat ComLocalRemesh(std::vector<double> &coords, std::vector<int> &tets, std::vector<int> &neig,
+                               std::vector<double> &quality, double badQuality, int growLayer, int maxClusterSize,
+                               const ComTetQuality &qualityFunc, const ComCavityFill &fill, int threadNum,
+                               std::vector<int> *freedVerts)
+{
+    LocalRemeshStat stat;
+    int vertNum = static_cast<int>(coords.size() / 3);
+    int tetNum = static_cast<int>(tets.size() / 4);
+
+    const ComCavityFill &cavityFill = fill ? fill : ComMakeDelaunayCavityFill();
+    std::vector<RemeshCluster> clusters;
+    stat.clusterNum_ = ComExtractBadClusters(tets.data(), neig.data(), quality.data(), tetNum, badQuality,
+                                             growLayer, maxClusterSize, clusters, &stat.skippedNum_);
+    if (clusters.empty())
+        return stat;
+
+    // 各簇互不重叠且不面相邻，填充只读原网格，可并行；大簇优先以均衡负载
+    std::vector<int> order(clusters.size());
+    for (size_t c = 0; c < order.size(); ++c)
+        order[c] = static_cast<int>(c);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return clusters[a].tets_.size() > clusters[b].tets_.size();
+    });
+
+    std::vector<RemeshCandidate> cands(clusters.size());
+    std::atomic<int> cursor(0);
+    threadNum = ComThreadNum(threadNum);
+    ComParallelFor(0, threadNum, threadNum, [&](int, int, int) {
+        for (int i = cursor.fetch_add(1); i < stat.clusterNum_; i = cursor.fetch_add(1))
+        {
+            int c = order[i];
+            ComEvalCandidate(coords.data(), vertNum, clusters[c], qualityFunc, cavityFill, cands[c]);
+        }
+    });
+
+    // 按簇编号串行拼接，结果与线程数无关
+    std::vector<char> dead(tetNum, 0);
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        switch (cands[c].state_)
+        {
+        case RemeshState::OK:
+            ComSpliceCandidate(coords, tets, neig, quality, dead, vertNum, clusters[c], cands[c], freedVerts);
+            ++stat.remeshedNum_;
+            break;
+        case RemeshState::FAILED:
+            ++stat.failedNum_;
+            break;
+        case RemeshState::REJECTED:
+            ++stat.rejectedNum_;
+            break;
+        }
+    }
+
+    // 压缩删除多余单元
+    ComCompactTets(tets, neig, quality, dead);
+    return stat;
+}
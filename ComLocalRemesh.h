@@ -0,0 +1,98 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComLocalRemesh.h
+// 摘    要：劣质单元簇的局部重剖分：提取连通劣质簇，空腔以边界约束的 Delaunay 剖分按尺寸重新
+//           四面体化后拼接回原网格，各簇互不相邻，可并行填充
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMLOCALREMESH_H_
+#define EMMPMESH_COMMON_COMLOCALREMESH_H_
+
+#include "ComTopoFlip.h"
+
+#include <functional>
+#include <vector>
+
+// 劣质单元簇（空腔）
+struct RemeshCluster
+{
+    std::vector<int> tets_;       // 簇内单元（升序）
+    std::vector<int> tetVerts_;   // 簇内单元顶点，与 tets_ 对应，每 4 个一个
+    std::vector<int> faces_;      // 空腔边界面，每 3 个顶点一个，空腔位于正侧
+    std::vector<int> faceOwner_;  // 边界面所属的簇内单元
+    std::vector<int> faceNeig_;   // 边界面外侧的相邻单元，-1 表示网格边界
+    std::vector<int> innerVerts_; // 内部顶点（不在边界面上），重剖分后不再被引用
+    double minQuality_ = 0.;      // 簇内单元最差质量
+};
+
+// 空腔填充：由边界面（空腔位于正侧）生成新单元。新增顶点坐标写入 newPos，
+// 新单元中新增顶点编号为 vertNum + k；失败返回 false
+using ComCavityFill = std::function<bool(const double *coords, int vertNum, const RemeshCluster &cluster,
+                                         std::vector<double> &newPos, std::vector<int> &newTets)>;
+
+// 尺寸函数：返回点 p 处的期望边长（如 SizingOctree::size），<= 0 表示该处不限制
+using ComSizingFunc = std::function<double(const double *p)>;
+
+// 局部重剖分统计
+struct LocalRemeshStat
+{
+    int clusterNum_ = 0;  // 劣质簇个数
+    int skippedNum_ = 0;  // 超过单元个数上限而跳过的簇个数
+    int remeshedNum_ = 0; // 重剖分并拼接成功的簇个数
+    int failedNum_ = 0;   // 填充失败或结果不协调的簇个数
+    int rejectedNum_ = 0; // 最差质量未改善而放弃的簇个数
+};
+
+/************************************************************************
+* 功能描述：提取劣质单元簇。质量低于 badQuality 的单元向外扩展 growLayer 层邻接单元后，
+*           按面邻接求连通分量，每个分量即一个簇；因此不同簇既不重叠也不面相邻。
+*           单元个数超过 maxClusterSize 的簇计入 skipped 而不返回
+* 返回值：int - 返回的簇个数
+* 作者：邓龙威
+/************************************************************************/
+int ComExtractBadClusters(const int *tets, const int *neig, const double *quality, int tetNum,
+                          double badQuality, int growLayer, int maxClusterSize,
+                          std::vector<RemeshCluster> &clusters, int *skipped = nullptr);
+
+/************************************************************************
+* 功能描述：生成边界约束的 Delaunay 空腔填充函数。
+*           1. 以边界面顶点（局部编号）为点集，用 DelaunayKernel 剖分，从每个边界面向空腔内侧
+*              泛洪（不穿过边界面）取出空腔内的单元；边界面须全部作为剖分面出现，且泛洪不得到达
+*              无穷单元或从外侧碰到边界面，否则加入原内部顶点重试，仍不满足时填充失败；
+*           2. 尺寸细化：最长边大于 sizeRatio × h 的单元在形心处加入内部点，h 取 size(形心)，
+*              size 为空或返回值 <= 0 时取边界边的平均长度；新点与已有点的距离不小于 0.5h。
+*              每批点加入后重新剖分，破坏边界约束的一批点被撤回并结束细化；内部点最多 maxPointNum 个
+* 返回值：ComCavityFill
+* 作者：邓龙威
+/************************************************************************/
+ComCavityFill ComMakeDelaunayCavityFill(const ComSizingFunc &size = nullptr, double sizeRatio = 1.0,
+                                        int maxPointNum = 1000);
+
+/************************************************************************
+* 功能描述：星形空腔填充。以内部顶点形心、边界顶点形心及各簇内单元形心为候选核点，
+*           取所有边界面均从正侧可见、且最小（高度 / 面尺寸）最大的候选点，
+*           以该点与每个边界面组成新单元。不考虑尺寸，只适用于少量单元的星形小空腔，
+*           一般空腔使用 ComMakeDelaunayCavityFill
+* 返回值：bool - 是否找到可见的核点
+* 作者：邓龙威
+/************************************************************************/
+bool ComStarCavityFill(const double *coords, int vertNum, const RemeshCluster &cluster,
+                       std::vector<double> &newPos, std::vector<int> &newTets);
+
+/************************************************************************
+* 功能描述：局部重剖分。提取劣质簇后并行调用 fill 填充各空腔，检查新单元均为正向、
+*           与空腔边界面协调且最差质量高于原簇，再按簇顺序串行拼接：新单元优先复用原单元编号，
+*           同步更新 neig 与 quality，最后压缩删除多余单元。新增顶点优先复用不再被引用的内部顶点编号，
+*           其余追加到 coords 末尾（均为内部顶点，调用者需补齐顶点属性）；
+*           仍未被复用的内部顶点写入 freedVerts。fill 为空时使用 ComMakeDelaunayCavityFill()
+* 返回值：LocalRemeshStat
+* 作者：邓龙威
+/************************************************************************/
+LocalRemeshStat ComLocalRemesh(std::vector<double> &coords, std::vector<int> &tets, std::vector<int> &neig,
+                               std::vector<double> &quality, double badQuality, int growLayer, int maxClusterSize,
+                               const ComTetQuality &qualityFunc, const ComCavityFill &fill, int threadNum,
+                               std::vector<int> *freedVerts = nullptr);
+
+#endif // EMMPMESH_COMMON_COMLOCALREMESH_H_
@@ -0,0 +1,546 @@
+#include "pch.h"
+
+#include "ComMinNLC.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+void MinNLCSolver::project(const NLCProblem &prob, double *x) const
+{
+    for (int i = 0; i < prob.varNum_; ++i)
+    {
+        if (prob.lower_ && x[i] < prob.lower_[i])
+            x[i] = prob.lower_[i];
+        if (prob.upper_ && x[i] > prob.upper_[i])
+            x[i] = prob.upper_[i];
+    }
+}
+
+double MinNLCSolver::projGradNorm(const NLCProblem &prob, const double *x, const double *g) const
+{
+    double norm = 0.;
+    for (int i = 0; i < prob.varNum_; ++i)
+    {
+        double t = x[i] - g[i];
+        if (prob.lower_ && t < prob.lower_[i])
+            t = prob.lower_[i];
+        if (prob.upper_ && t > prob.upper_[i])
+            t = prob.upper_[i];
+        norm += (t - x[i]) * (t - x[i]);
+    }
+    return std::sqrt(norm);
+}
+
+double MinNLCSolver::evalAL(const NLCProblem &prob, const double *x, double *g)
+{
+    double L = prob.func_(x, g);
+    if (prob.conNum_ <= 0)
+        return L;
+
+    prob.con_(x, c_.data(), nullptr, nullptr);
+    bool active = false;
+    for (int i = 0; i < prob.conNum_; ++i)
+    {
+        double t = lambda_[i] - rho_ * c_[i];
+        if (t > 0.)
+        {
+            L += -lambda_[i] * c_[i] + 0.5 * rho_ * c_[i] * c_[i];
+            w_[i] = -t;
+            active = true;
+        }
+        else
+        {
+            L += -0.5 * lambda_[i] * lambda_[i] / rho_;
+            w_[i] = 0.;
+        }
+    }
+    // ∇L = ∇f - Σ max(0, λ_i - ρc_i) ∇c_i
+    if (active)
+        prob.con_(x, c_.data(), w_.data(), g);
+    return L;
+}
+
+OptiStopReason MinNLCSolver::minimize(const NLCProblem &prob, double *x, NLCResult &res)
+{
+    const int n = prob.varNum_;
+    const LineSearchOptions &ls = opts_.lineSearchOpti_;
+    history_.clear();
+
+    double L = evalAL(prob, x, g_.data());
+    ++res.funcEval_;
+    ++res.gradEval_;
+    for (int iter = 0;; ++iter)
+    {
+        OptiStopReason reason;
+        double pgNorm = projGradNorm(prob, x, g_.data());
+        if (pgNorm <= opts_.epsG_)
+            return OptiStopReason::EPS_G;
+        if (opts_.maxIter_ > 0 && iter >= opts_.maxIter_)
+            return OptiStopReason::MAX_ITER;
+
+        // L-BFGS 方向，固定位于边界且指向外侧的分量；非下降方向时退化为投影梯度
+        history_.twoLoop(g_.data(), d_.data(), alpha_.data());
+        double gd = 0.;
+        for (int i = 0; i < n; ++i)
+        {
+            if ((prob.lower_ && x[i] <= prob.lower_[i] && d_[i] < 0.) ||
+                (prob.upper_ && x[i] >= prob.upper_[i] && d_[i] > 0.))
+                d_[i] = 0.;
+            gd += g_[i] * d_[i];
+        }
+        if (gd >= 0.)
+        {
+            history_.clear();
+            gd = 0.;
+            for (int i = 0; i < n; ++i)
+            {
+                d_[i] = -g_[i];
+                if ((prob.lower_ && x[i] <= prob.lower_[i] && d_[i] < 0.) ||
+                    (prob.upper_ && x[i] >= prob.upper_[i] && d_[i] > 0.))
+                    d_[i] = 0.;
+                gd += g_[i] * d_[i];
+            }
+            if (gd >= 0.)
+                return OptiStopReason::EPS_G;
+        }
+
+        // 投影回溯线搜索（Armijo 条件，参数取自 lineSearchOpti_）
+        double alpha = history_.size_ > 0 ? 1. : std::min(1., 1. / pgNorm);
+        alpha = std::min(alpha, ls.alphaMax_);
+        double Lt = 0.;
+        bool accepted = false;
+        for (int k = 0; ls.maxLineSearchIter_ <= 0 || k < ls.maxLineSearchIter_; ++k)
+        {
+            if (alpha < ls.alphaMin_)
+                break;
+            double descent = 0.;
+            for (int i = 0; i < n; ++i)
+                xt_[i] = x[i] + alpha * d_[i];
+            project(prob, xt_.data());
+            for (int i = 0; i < n; ++i)
+                descent += g_[i] * (xt_[i] - x[i]);
+
+            Lt = evalAL(prob, xt_.data(), gt_.data());
+            ++res.funcEval_;
+            ++res.gradEval_;
+            ++res.lineSearch_;
+            if (std::isfinite(Lt) && Lt <= L + ls.strongWolfeC1_ * descent)
+            {
+                accepted = true;
+                break;
+            }
+            alpha *= 0.5;
+        }
+        if (!accepted)
+            return OptiStopReason::LINE_SEARCH_FAIL;
+
+        double xStep = 0.;
+        for (int i = 0; i < n; ++i)
+        {
+            s_[i] = xt_[i] - x[i];
+            y_[i] = gt_[i] - g_[i];
+            xStep += s_[i] * s_[i];
+        }
+        history_.push(s_.data(), y_.data(), std::numeric_limits<double>::epsilon());
+        std::copy(xt_.begin(), xt_.end(), x);
+        std::swap(g_, gt_);
+        double LPrev = L;
+        L = Lt;
+        ++res.innerIter_;
+
+        if (ComCheckStop(opts_, iter + 1, std::numeric_limits<double>::max(), LPrev, L, std::sqrt(xStep), reason) &&
+            reason != OptiStopReason::MAX_ITER)
+            return reason;
+    }
+}
+
+NLCResult MinNLCSolver::solve(const NLCProblem &prob, double *x)
+{
+    const int n = prob.varNum_;
+    const int m = prob.conNum_;
+    int histNum = std::max(opts_.m_, 1);
+    history_.reset(n, histNum);
+    alpha_.resize(histNum);
+    g_.resize(n);
+    gt_.resize(n);
+    xt_.resize(n);
+    d_.resize(n);
+    s_.resize(n);
+    y_.resize(n);
+    c_.resize(m);
+    w_.resize(m);
+    lambda_.assign(m, 0.);
+    rho_ = std::max(opts_.rho_, std::numeric_limits<double>::min());
+
+    NLCResult res;
+    if (telemetryOn_)
+        telemetry_.begin();
+    project(prob, x);
+
+    auto violation = [&]() {
+        double v = 0.;
+        if (m > 0)
+        {
+            prob.con_(x, c_.data(), nullptr, nullptr);
+            for (int i = 0; i < m; ++i)
+                v = std::max(v, -c_[i]);
+        }
+        return v;
+    };
+
+    double prevViol = violation();
+    for (int outer = 0; outer < std::max(opts_.outerIter_, 1); ++outer)
+    {
+        res.innerStop_ = minimize(prob, x, res);
+        ++res.outerIter_;
+
+        double viol = violation();
+        bool feasible = viol <= opts_.feasTol_;
+        if (feasible && res.innerStop_ != OptiStopReason::MAX_ITER)
+        {
+            // 互补条件：非活跃约束的乘子应已为 0
+            double comp = 0.;
+            for (int i = 0; i < m; ++i)
+                comp = std::max(comp, std::fabs(std::min(c_[i], lambda_[i] / rho_)));
+            if (comp <= opts_.feasTol_)
+            {
+                res.converged_ = true;
+                break;
+            }
+        }
+
+        // 乘子更新（c_ 为 violation() 计算的当前约束值）
+        for (int i = 0; i < m; ++i)
+            lambda_[i] = std::max(0., lambda_[i] - rho_ * c_[i]);
+        if (viol > opts_.feasTol_ && viol > opts_.rhoDecrease_ * prevViol)
+            rho_ = std::min(rho_ * opts_.rhoFactor_, std::max(opts_.rhoMax_, rho_));
+        prevViol = viol;
+    }
+
+    res.f_ = prob.func_(x, nullptr);
+    ++res.funcEval_;
+    res.maxViolation_ = violation();
+    res.feasible_ = res.maxViolation_ <= opts_.feasTol_;
+    res.rho_ = rho_;
+
+    // 未收敛时除线搜索失败外均为外层迭代次数用尽
+    if (telemetryOn_)
+    {
+        OptiStopReason reason = res.converged_ || res.innerStop_ == OptiStopReason::LINE_SEARCH_FAIL
+                                    ? res.innerStop_
+                                    : OptiStopReason::MAX_ITER;
+        telemetry_.end(scope_, res.innerIter_, res.funcEval_, res.gradEval_, res.lineSearch_, reason);
+    }
+    return res;
+}
+
+void MinNLCSolver::setTelemetry(bool enable, int sampleRate, OptiSolveScope scope)
+{
+    telemetryOn_ = enable;
+    scope_ = scope;
+    if (enable)
+        telemetry_ = OptiTelemetry(sampleRate);
+}
+
+void MinNLCSolver::flushTelemetry() const
+{
+    if (!telemetryOn_ || !sink_)
+        return;
+    const OptiTelemetryStat &stat = telemetry_.stat(scope_);
+    sink_(LogLevel::Stat, OptiTelemetry::formatStat(stat, scope_, logFormat_));
+    sink_(LogLevel::Perf, OptiTelemetry::formatPerf(stat, scope_, logFormat_));
+}
+
+void ComTetVolumeConstraints(const int *tets, int tetNum, int freeNum, const double *fixedCoords,
+                             double volRef, double minVolume, const double *x, double *c,
+                             const double *w, double *g)
+{
+    double inv = volRef > 0. ? 1. / volRef : 1.;
+    for (int e = 0; e < tetNum; ++e)
+    {
+        const int *tv = tets + 4 * e;
+        const double *p[4];
+        for (int k = 0; k < 4; ++k)
+            p[k] = tv[k] < freeNum ? x + 3 * tv[k] : fixedCoords + 3 * (tv[k] - freeNum);
+
+        double b[3], cc[3], d[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            b[j] = p[1][j] - p[0][j];
+            cc[j] = p[2][j] - p[0][j];
+            d[j] = p[3][j] - p[0][j];
+        }
+        // 6V = b · (c × d)
+        double cxd[3] = {cc[1] * d[2] - cc[2] * d[1], cc[2] * d[0] - cc[0] * d[2], cc[0] * d[1] - cc[1] * d[0]};
+        c[e] = (b[0] * cxd[0] + b[1] * cxd[1] + b[2] * cxd[2]) * inv - minVolume;
+
+        if (!w || !g || w[e] == 0.)
+            continue;
+        double dxb[3] = {d[1] * b[2] - d[2] * b[1], d[2] * b[0] - d[0] * b[2], d[0] * b[1] - d[1] * b[0]};
+        double bxc[3] = {b[1] * cc[2] - b[2] * cc[1], b[2] * cc[0] - b[0] * cc[2], b[0] * cc[1] - b[1] * cc[0]};
+        const double *grad[4] = {nullptr, cxd, dxb, bxc};
+        double g0[3] = {-(cxd[0] + dxb[0] + bxc[0]), -(cxd[1] + dxb[1] + bxc[1]), -(cxd[2] + dxb[2] + bxc[2])};
+        grad[0] = g0;
+        double s = w[e] * inv;
+        for (int k = 0; k < 4; ++k)
+        {
+            if (tv[k] >= freeNum)
+                continue;
+            for (int j = 0; j < 3; ++j)
+                g[3 * tv[k] + j] += s * grad[k][j];
+        }
+    }
+}
+
+NLCResult ComUntangleCavity(const MeshOptiOptions &opts, const int *tets, int tetNum, int freeNum,
+                            const double *fixedCoords, double volRef, double *x, double penalty, int gdMaxIter)
+{
+    const int n = 3 * freeNum;
+    const double minVolume = opts.meshOptiAlgorithmOptions_.nlcOptions_.minVolume_;
+    const std::vector<double> x0(x, x + n);
+    auto disp = [&x0, n](const double *p, double *g) {
+        double f = 0.;
+        for (int i = 0; i < n; ++i)
+        {
+            double d = p[i] - x0[i];
+            f += d * d;
+            if (g)
+                g[i] = 2. * d;
+        }
+        return f;
+    };
+
+    if (opts.smoothType_ == MeshSmoothType::MinNLC)
+    {
+        NLCProblem prob;
+        prob.varNum_ = n;
+        prob.conNum_ = tetNum;
+        prob.func_ = disp;
+        prob.con_ = [=](const double *p, double *c, const double *w, double *g) {
+            ComTetVolumeConstraints(tets, tetNum, freeNum, fixedCoords, volRef, minVolume, p, c, w, g);
+        };
+        MinNLCSolver solver(opts);
+        return solver.solve(prob, x);
+    }
+
+    // 罚函数梯度下降：F = Σ|x - x0|² + penalty/2·Σ min(c_e, 0)²
+    GradientDescentOptions gd = opts.meshOptiAlgorithmOptions_.gdOptions_;
+    if (gdMaxIter > 0)
+        gd.maxIter_ = gdMaxIter;
+    const LineSearchOptions &ls = gd.lineSearchOpti_;
+    std::vector<double> c(tetNum), w(tetNum), g(n), gt(n), xt(n);
+    auto eval = [&](const double *p, double *grad) {
+        double F = disp(p, grad);
+        ComTetVolumeConstraints(tets, tetNum, freeNum, fixedCoords, volRef, minVolume, p, c.data(), nullptr, nullptr);
+        for (int e = 0; e < tetNum; ++e)
+        {
+            double v = std::min(c[e], 0.);
+            F += 0.5 * penalty * v * v;
+            w[e] = penalty * v;
+        }
+        ComTetVolumeConstraints(tets, tetNum, freeNum, fixedCoords, volRef, minVolume, p, c.data(), w.data(), grad);
+        return F;
+    };
+
+    NLCResult res;
+    res.outerIter_ = 1;
+    res.rho_ = penalty;
+    double F = eval(x, g.data());
+    ++res.funcEval_;
+    ++res.gradEval_;
+    double alpha = 0.;
+    for (int iter = 0;; ++iter)
+    {
+        double gNorm = 0.;
+        for (int i = 0; i < n; ++i)
+            gNorm += g[i] * g[i];
+        gNorm = std::sqrt(gNorm);
+        if (gNorm <= gd.epsG_)
+        {
+            res.innerStop_ = OptiStopReason::EPS_G;
+            break;
+        }
+        if (gd.maxIter_ > 0 && iter >= gd.maxIter_)
+        {
+            res.innerStop_ = OptiStopReason::MAX_ITER;
+            break;
+        }
+
+        // Armijo 回溯，初始步长取上一步接受步长的 2 倍，第一步为 min(1, 1/||∇F||)
+        alpha = std::min(iter == 0 ? std::min(1., 1. / gNorm) : 2. * alpha, ls.alphaMax_);
+        double Ft = 0.;
+        bool accepted = false;
+        for (int k = 0; ls.maxLineSearchIter_ <= 0 || k < ls.maxLineSearchIter_; ++k)
+        {
+            if (alpha < ls.alphaMin_)
+                break;
+            for (int i = 0; i < n; ++i)
+                xt[i] = x[i] - alpha * g[i];
+            Ft = eval(xt.data(), gt.data());
+            ++res.funcEval_;
+            ++res.gradEval_;
+            ++res.lineSearch_;
+            if (std::isfinite(Ft) && Ft <= F - ls.strongWolfeC1_ * alpha * gNorm * gNorm)
+            {
+                accepted = true;
+                break;
+            }
+            alpha *= 0.5;
+        }
+        if (!accepted)
+        {
+            res.innerStop_ = OptiStopReason::LINE_SEARCH_FAIL;
+            break;
+        }
+
+        std::copy(xt.begin(), xt.end(), x);
+        std::swap(g, gt);
+        double FPrev = F;
+        F = Ft;
+        ++res.innerIter_;
+        OptiStopReason reason;
+        if (ComCheckStop(gd, iter + 1, gNorm, FPrev, F, alpha * gNorm, reason) && reason != OptiStopReason::MAX_ITER)
+        {
+            res.innerStop_ = reason;
+            break;
+        }
+    }
+
+    res.f_ = disp(x, nullptr);
+    ++res.funcEval_;
+    ComTetVolumeConstraints(tets, tetNum, freeNum, fixedCoords, volRef, minVolume, x, c.data(), nullptr, nullptr);
+    for (int e = 0; e < tetNum; ++e)
+        res.maxViolation_ = std::max(res.maxViolation_, -c[e]);
+    res.feasible_ = res.maxViolation_ <= opts.meshOptiAlgorithmOptions_.nlcOptions_.feasTol_;
+    res.converged_ = res.feasible_ && res.innerStop_ != OptiStopReason::MAX_ITER &&
+                     res.innerStop_ != OptiStopReason::LINE_SEARCH_FAIL;
+    return res;
+}
+
+NLCBenchResult ComMinNLCBench(const MeshOptiOptions &opts, int latticeNum, double amplitude, double penalty,
+                              int gdMaxIter, unsigned int seed)
+{
+    NLCBenchResult result;
+    int n = latticeNum;
+    if (n < 2)
+        return result;
+
+    // 点阵顶点：内部顶点为自由顶点（局部编号 0 .. freeNum-1），边界顶点为固定顶点
+    int m = n + 1;
+    double h = 1. / n;
+    std::vector<int> local(m * m * m);
+    std::vector<double> x, fixedCoords;
+    int freeNum = 0, fixedNum = 0;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                for (int k = 0; k < m; ++k)
+                {
+                    bool inner = i > 0 && j > 0 && k > 0 && i < n && j < n && k < n;
+                    if (inner != (pass == 0))
+                        continue;
+                    std::vector<double> &dst = inner ? x : fixedCoords;
+                    dst.push_back(i * h);
+                    dst.push_back(j * h);
+                    dst.push_back(k * h);
+                    local[(i * m + j) * m + k] = inner ? freeNum++ : fixedNum++;
+                }
+            }
+        }
+    }
+    for (int v = 0; v < m * m * m; ++v)
+    {
+        int i = v / (m * m), j = v / m % m, k = v % m;
+        if (!(i > 0 && j > 0 && k > 0 && i < n && j < n && k < n))
+            local[v] += freeNum;
+    }
+
+    // 每个立方体沿主对角线剖分为 6 个四面体，按体积符号调整为正向
+    std::vector<int> tets;
+    const int path[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    auto corner = [&](int i, int j, int k) { return local[(i * m + j) * m + k]; };
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                for (const auto &p : path)
+                {
+                    int q[3] = {i, j, k};
+                    int tv[4] = {corner(q[0], q[1], q[2]), 0, 0, 0};
+                    for (int s = 0; s < 3; ++s)
+                    {
+                        ++q[p[s]];
+                        tv[s + 1] = corner(q[0], q[1], q[2]);
+                    }
+                    double c = 0.;
+                    ComTetVolumeConstraints(tv, 1, freeNum, fixedCoords.data(), 1., 0., x.data(), &c, nullptr, nullptr);
+                    if (c < 0.)
+                        std::swap(tv[2], tv[3]);
+                    tets.insert(tets.end(), tv, tv + 4);
+                }
+            }
+        }
+    }
+    int tetNum = static_cast<int>(tets.size() / 4);
+    double volRef = h * h * h; // 6V 的平均值
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(-amplitude * h, amplitude * h);
+    for (double &v : x)
+        v += uni(rng);
+
+    std::vector<double> c(tetNum);
+    ComTetVolumeConstraints(tets.data(), tetNum, freeNum, fixedCoords.data(), volRef, 0., x.data(), c.data(), nullptr,
+                            nullptr);
+    result.freeNum_ = freeNum;
+    result.tetNum_ = tetNum;
+    for (double v : c)
+        result.invertedNum_ += v <= 0. ? 1 : 0;
+
+    auto run = [&](MeshSmoothType type, NLCResult &res, double &seconds, double &minVolume) {
+        MeshOptiOptions o = opts;
+        o.smoothType_ = type;
+        std::vector<double> y = x;
+        auto start = std::chrono::steady_clock::now();
+        res = ComUntangleCavity(o, tets.data(), tetNum, freeNum, fixedCoords.data(), volRef, y.data(), penalty,
+                                gdMaxIter);
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        ComTetVolumeConstraints(tets.data(), tetNum, freeNum, fixedCoords.data(), volRef, 0., y.data(), c.data(),
+                                nullptr, nullptr);
+        minVolume = *std::min_element(c.begin(), c.end());
+    };
+    run(MeshSmoothType::MinNLC, result.nlc_, result.nlcSeconds_, result.nlcMinVolume_);
+    run(MeshSmoothType::GD, result.gd_, result.gdSeconds_, result.gdMinVolume_);
+    return result;
+}
+
+std::string ComMinNLCBenchToString(const NLCBenchResult &result, LogFileFormat format)
+{
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"free", ComTelemetryValue(result.freeNum_)},
+        {"tets", ComTelemetryValue(result.tetNum_)},
+        {"inverted", ComTelemetryValue(result.invertedNum_)},
+    };
+    auto add = [&fields](const std::string &prefix, const NLCResult &res, double seconds, double minVolume) {
+        fields.push_back({prefix + "outer", ComTelemetryValue(res.outerIter_)});
+        fields.push_back({prefix + "iter", ComTelemetryValue(res.innerIter_)});
+        fields.push_back({prefix + "fEval", ComTelemetryValue(res.funcEval_)});
+        fields.push_back({prefix + "seconds", ComTelemetryValue(seconds)});
+        fields.push_back({prefix + "disp", ComTelemetryValue(res.f_)});
+        fields.push_back({prefix + "maxViolation", ComTelemetryValue(res.maxViolation_)});
+        fields.push_back({prefix + "minVolume", ComTelemetryValue(minVolume)});
+        fields.push_back({prefix + "feasible", res.feasible_ ? "true" : "false"});
+        fields.push_back({prefix + "stop", OptiTelemetry::stopReasonToString(res.innerStop_)});
+    };
+    add("nlc.", result.nlc_, result.nlcSeconds_, result.nlcMinVolume_);
+    add("gd.", result.gd_, result.gdSeconds_, result.gdMinVolume_);
+    return ComTelemetryFields(fields, format);
+}
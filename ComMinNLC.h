@@ -0,0 +1,199 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComMinNLC.h
+// 摘    要：带约束优化（MeshSmoothType::MinNLC）：增广拉格朗日法处理不等式约束 c_i(x) >= 0
+//           （如单元体积下界），内层以带盒约束的投影 L-BFGS 求解，用于网格解缠
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMMINNLC_H_
+#define EMMPMESH_COMMON_COMMINNLC_H_
+
+#include "ComConstants.h"
+#include "ComOptiTelemetry.h"
+#include "ComOptiWorkspace.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 约束优化问题：min f(x)  s.t.  c_i(x) >= 0 (0 <= i < conNum_)，lower_ <= x <= upper_
+struct NLCProblem
+{
+    int varNum_ = 0; // 变量个数
+    int conNum_ = 0; // 不等式约束个数
+
+    // 目标函数：返回 f(x)，g 非空时写入 ∇f(x)
+    std::function<double(const double *x, double *g)> func_;
+
+    // 约束函数：写入 c(x)；w 与 g 非空时另外累加 g += Σ w_i ∇c_i(x)
+    std::function<void(const double *x, double *c, const double *w, double *g)> con_;
+
+    const double *lower_ = nullptr; // 变量下界，为空表示无下界
+    const double *upper_ = nullptr; // 变量上界，为空表示无上界
+};
+
+// 求解结果
+struct NLCResult
+{
+    int outerIter_ = 0;                                // 外层迭代次数
+    int innerIter_ = 0;                                // 内层迭代总次数
+    int funcEval_ = 0;                                 // 目标函数求值次数
+    int gradEval_ = 0;                                 // 梯度求值次数
+    int lineSearch_ = 0;                               // 线搜索试探次数
+    double f_ = 0.;                                    // 最终目标函数值
+    double maxViolation_ = 0.;                         // 最大约束违反量 max{-c_i(x), 0}
+    double rho_ = 0.;                                  // 最终罚参数
+    bool feasible_ = false;                            // 最大约束违反量是否不超过 feasTol_
+    bool converged_ = false;                           // 可行、满足互补条件且最后一次内层迭代未达到 maxIter_
+    OptiStopReason innerStop_ = OptiStopReason::OTHER; // 最后一次内层迭代的停止原因
+};
+
+// 增广拉格朗日求解器（PHR 形式）：
+//   L(x; λ, ρ) = f(x) + Σ ψ(c_i(x), λ_i, ρ)
+//   ψ = -λc + ρc²/2      (λ - ρc > 0)
+//   ψ = -λ²/(2ρ)         (其他)
+// 外层更新 λ_i = max(0, λ_i - ρ c_i)，约束违反量下降不足时放大 ρ
+class MinNLCSolver
+{
+public:
+    explicit MinNLCSolver(const MinNLCOptions &opts) : opts_(opts) {}
+
+    // 取 meshOptiAlgorithmOptions_.nlcOptions_ 为选项，并按 telemetry_ / telemetrySample_ 开启遥测
+    explicit MinNLCSolver(const MeshOptiOptions &opts) : opts_(opts.meshOptiAlgorithmOptions_.nlcOptions_)
+    {
+        setTelemetry(opts);
+    }
+
+    /************************************************************************
+    * 功能描述：求解约束优化问题，x 为初值并写回结果（先投影到盒约束内）。
+    *           乘子在两次 solve 之间不保留
+    * 返回值：NLCResult - 求解结果
+    * 作者：邓龙威
+    /************************************************************************/
+    NLCResult solve(const NLCProblem &prob, double *x);
+
+    /************************************************************************
+    * 功能描述：开启或关闭遥测。开启时每次 solve 以 OptiTelemetry::begin / end 记录一次求解
+    *           （范围为 scope，每 sampleRate 次求解计时一次），重新开启时清空已有统计
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setTelemetry(bool enable, int sampleRate = 1, OptiSolveScope scope = OptiSolveScope::LOCAL);
+
+    // 按 opts.telemetry_ 与 opts.telemetrySample_ 开启或关闭遥测
+    void setTelemetry(const MeshOptiOptions &opts, OptiSolveScope scope = OptiSolveScope::LOCAL)
+    {
+        setTelemetry(opts.telemetry_, opts.telemetrySample_, scope);
+    }
+
+    /************************************************************************
+    * 功能描述：设置日志输出回调，flushTelemetry 按 format 格式化遥测消息
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setLogSink(ComLogSink sink, LogFileFormat format = LogFileFormat::Logfmt)
+    {
+        sink_ = std::move(sink);
+        logFormat_ = format;
+    }
+
+    /************************************************************************
+    * 功能描述：以 LogLevel::Stat 输出 OptiTelemetry::formatStat、以 LogLevel::Perf 输出
+    *           OptiTelemetry::formatPerf，未开启遥测或未设置回调时不输出
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void flushTelemetry() const;
+
+    const std::vector<double> &multipliers() const { return lambda_; }
+    const MinNLCOptions &options() const { return opts_; }
+    // 遥测计数器，未开启遥测时为 nullptr
+    const OptiTelemetry *telemetry() const { return telemetryOn_ ? &telemetry_ : nullptr; }
+
+private:
+    double evalAL(const NLCProblem &prob, const double *x, double *g);           // 计算 L 与 ∇L
+    void project(const NLCProblem &prob, double *x) const;                       // 投影到盒约束内
+    double projGradNorm(const NLCProblem &prob, const double *x, const double *g) const; // ||P(x-g)-x||
+    OptiStopReason minimize(const NLCProblem &prob, double *x, NLCResult &res);   // 内层投影 L-BFGS
+
+    MinNLCOptions opts_;         // 选项
+    double rho_ = 0.;            // 当前罚参数
+    std::vector<double> lambda_; // 乘子
+    std::vector<double> c_;      // 约束值
+    std::vector<double> w_;      // 约束梯度系数
+    std::vector<double> g_;      // 当前梯度
+    std::vector<double> gt_;     // 试探点梯度
+    std::vector<double> xt_;     // 试探点
+    std::vector<double> d_;      // 搜索方向
+    std::vector<double> s_;      // X(k+1)-X(k)
+    std::vector<double> y_;      // ∇L(k+1)-∇L(k)
+    std::vector<double> alpha_;  // 双循环递推系数
+    LbfgsHistory history_;       // L-BFGS 历史
+
+    bool telemetryOn_ = false;                        // 是否记录遥测
+    OptiSolveScope scope_ = OptiSolveScope::LOCAL;    // 遥测范围
+    OptiTelemetry telemetry_;                         // 遥测计数器
+    ComLogSink sink_;                                 // 日志输出回调
+    LogFileFormat logFormat_ = LogFileFormat::Logfmt; // 日志消息格式
+};
+
+/************************************************************************
+* 功能描述：空腔体积约束 c_e = 6V_e / volRef - minVolume >= 0，可直接作为 NLCProblem::con_。
+*           tets 为 tetNum 个四面体的局部顶点编号（每个 4 个），局部编号小于 freeNum 的顶点为
+*           自由顶点，坐标取自 x[3v..3v+2]；其余为固定顶点，坐标取自 fixedCoords[3(v-freeNum)..]。
+*           volRef 为参考体积的 6 倍（如空腔平均 6V），w、g 非空时累加 g += Σ w_e ∇c_e
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComTetVolumeConstraints(const int *tets, int tetNum, int freeNum, const double *fixedCoords,
+                             double volRef, double minVolume, const double *x, double *c,
+                             const double *w, double *g);
+
+/************************************************************************
+* 功能描述：空腔解缠：以最小位移 Σ|x_v - x0_v|² 为目标，使空腔单元满足体积下界
+*           6V_e / volRef >= nlcOptions_.minVolume_（ComTetVolumeConstraints）。
+*           opts.smoothType_ 为 MeshSmoothType::MinNLC 时以 MinNLCSolver(opts) 求解；
+*           否则以罚函数 Σ penalty/2·min(c_e, 0)² 加入目标，按 gdOptions_ 做梯度下降（Armijo 回溯，
+*           最大迭代次数为 gdMaxIter，<= 0 时取 gdOptions_.maxIter_）。x 为自由顶点坐标（初值即 x0）并写回结果
+* 返回值：NLCResult - 求解结果（梯度下降时 outerIter_ 为 1，rho_ 为 penalty）
+* 作者：邓龙威
+/************************************************************************/
+NLCResult ComUntangleCavity(const MeshOptiOptions &opts, const int *tets, int tetNum, int freeNum,
+                            const double *fixedCoords, double volRef, double *x, double penalty = 1e4,
+                            int gdMaxIter = 0);
+
+// 带约束解缠与罚函数梯度下降的对比结果
+struct NLCBenchResult
+{
+    int freeNum_ = 0;          // 自由顶点数
+    int tetNum_ = 0;           // 单元数
+    int invertedNum_ = 0;      // 初始翻转（体积非正）的单元数
+    NLCResult nlc_;            // MinNLC 求解结果
+    NLCResult gd_;             // 罚函数梯度下降求解结果
+    double nlcSeconds_ = 0.;   // MinNLC 耗时（秒）
+    double gdSeconds_ = 0.;    // 罚函数梯度下降耗时（秒）
+    double nlcMinVolume_ = 0.; // MinNLC 结果的最小 6V / volRef
+    double gdMinVolume_ = 0.;  // 罚函数梯度下降结果的最小 6V / volRef
+};
+
+/************************************************************************
+* 功能描述：n×n×n 立方体点阵（每个立方体 6 个四面体）的内部顶点以 amplitude 倍边长随机扰动，
+*           产生翻转单元后分别以 MinNLC 与罚函数梯度下降（ComUntangleCavity）解缠，
+*           对比迭代次数、求值次数、耗时、最终约束违反量与最小体积
+* 返回值：NLCBenchResult
+* 作者：邓龙威
+/************************************************************************/
+NLCBenchResult ComMinNLCBench(const MeshOptiOptions &opts, int latticeNum = 4, double amplitude = 0.8,
+                              double penalty = 1e4, int gdMaxIter = 10000, unsigned int seed = 0);
+
+/************************************************************************
+* 功能描述：将测试结果格式化为一行（Json / Logfmt，Text 同 Logfmt），字段以 nlc. / gd. 为前缀
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComMinNLCBenchToString(const NLCBenchResult &result, LogFileFormat format);
+
+#endif // EMMPMESH_COMMON_COMMINNLC_H_
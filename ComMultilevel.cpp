@@ -0,0 +1,351 @@
+#include "pch.h"
+
+#include "ComMultilevel.h"
+#include "ComOptiTelemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <utility>
+
+void MultilevelHierarchy::build(const std::vector<int> &adjOffset, const std::vector<int> &adjVert,
+                                int levelNum, int minVertNum, const std::vector<char> *fixed)
+{
+    levels_.clear();
+    int vertNum = adjOffset.empty() ? 0 : static_cast<int>(adjOffset.size()) - 1;
+
+    MultilevelLevel fine;
+    fine.verts_.resize(vertNum);
+    for (int v = 0; v < vertNum; ++v)
+        fine.verts_[v] = v;
+    fine.adjOffset_ = adjOffset;
+    fine.adjVert_ = adjVert;
+    levels_.push_back(std::move(fine));
+
+    while (static_cast<int>(levels_.size()) < levelNum)
+    {
+        MultilevelLevel &cur = levels_.back();
+        int num = static_cast<int>(cur.verts_.size());
+        cur.coarse_.assign(num, 0);
+
+        // 固定顶点强制保留，其余顶点按编号顺序贪心选取极大独立集（结果确定，与线程无关）
+        std::vector<char> blocked(num, 0);
+        for (int i = 0; i < num; ++i)
+        {
+            if (fixed && (*fixed)[cur.verts_[i]])
+            {
+                cur.coarse_[i] = 1;
+                for (int k = cur.adjOffset_[i]; k < cur.adjOffset_[i + 1]; ++k)
+                    blocked[cur.adjVert_[k]] = 1;
+            }
+        }
+        for (int i = 0; i < num; ++i)
+        {
+            if (cur.coarse_[i] || blocked[i])
+                continue;
+            cur.coarse_[i] = 1;
+            for (int k = cur.adjOffset_[i]; k < cur.adjOffset_[i + 1]; ++k)
+                blocked[cur.adjVert_[k]] = 1;
+        }
+
+        std::vector<int> local2coarse(num, -1);
+        MultilevelLevel next;
+        for (int i = 0; i < num; ++i)
+        {
+            if (cur.coarse_[i])
+            {
+                local2coarse[i] = static_cast<int>(next.verts_.size());
+                next.verts_.push_back(cur.verts_[i]);
+            }
+        }
+
+        int coarseNum = static_cast<int>(next.verts_.size());
+        if (coarseNum < minVertNum || coarseNum == num)
+        {
+            cur.coarse_.clear();
+            break;
+        }
+
+        // 粗层邻接：在细层中距离不超过 2 的保留顶点互为邻点
+        std::vector<int> mark(coarseNum, -1);
+        next.adjOffset_.assign(1, 0);
+        for (int i = 0; i < num; ++i)
+        {
+            if (!cur.coarse_[i])
+                continue;
+            int ci = local2coarse[i];
+            mark[ci] = ci;
+            for (int k = cur.adjOffset_[i]; k < cur.adjOffset_[i + 1]; ++k)
+            {
+                int n = cur.adjVert_[k];
+                if (cur.coarse_[n])
+                {
+                    if (mark[local2coarse[n]] != ci)
+                    {
+                        mark[local2coarse[n]] = ci;
+                        next.adjVert_.push_back(local2coarse[n]);
+                    }
+                    continue;
+                }
+                for (int kk = cur.adjOffset_[n]; kk < cur.adjOffset_[n + 1]; ++kk)
+                {
+                    int m = cur.adjVert_[kk];
+                    if (cur.coarse_[m] && mark[local2coarse[m]] != ci)
+                    {
+                        mark[local2coarse[m]] = ci;
+                        next.adjVert_.push_back(local2coarse[m]);
+                    }
+                }
+            }
+            next.adjOffset_.push_back(static_cast<int>(next.adjVert_.size()));
+        }
+
+        levels_.push_back(std::move(next));
+    }
+}
+
+void MultilevelHierarchy::prolong(int l, std::vector<double> &disp) const
+{
+    const MultilevelLevel &cur = levels_[l];
+    if (cur.coarse_.empty())
+        return;
+
+    int num = static_cast<int>(cur.verts_.size());
+    for (int i = 0; i < num; ++i)
+    {
+        if (cur.coarse_[i])
+            continue;
+
+        // 极大独立集保证每个未保留顶点至少有一个保留邻点
+        double sum[3] = {0., 0., 0.};
+        int cnt = 0;
+        for (int k = cur.adjOffset_[i]; k < cur.adjOffset_[i + 1]; ++k)
+        {
+            int n = cur.adjVert_[k];
+            if (!cur.coarse_[n])
+                continue;
+            const double *d = disp.data() + 3 * static_cast<size_t>(cur.verts_[n]);
+            sum[0] += d[0];
+            sum[1] += d[1];
+            sum[2] += d[2];
+            ++cnt;
+        }
+
+        double *dst = disp.data() + 3 * static_cast<size_t>(cur.verts_[i]);
+        if (cnt > 0)
+        {
+            dst[0] = sum[0] / cnt;
+            dst[1] = sum[1] / cnt;
+            dst[2] = sum[2] / cnt;
+        }
+    }
+}
+
+MultilevelSmoothStat ComMultilevelSmooth(const MultilevelHierarchy &hierarchy, std::vector<double> &coords,
+                                         const ComLevelSmooth &smooth)
+{
+    MultilevelSmoothStat stat;
+    int levelNum = hierarchy.levelNum();
+    stat.vertNum_.resize(levelNum);
+    stat.iterNum_.assign(levelNum, 0);
+    if (levelNum == 0)
+        return stat;
+
+    const std::vector<double> origin = coords;
+    std::vector<double> disp(coords.size(), 0.);
+    for (int l = levelNum - 1; l >= 0; --l)
+    {
+        const MultilevelLevel &lvl = hierarchy.level(l);
+        stat.vertNum_[l] = static_cast<int>(lvl.verts_.size());
+        stat.iterNum_[l] = smooth(l, lvl, coords);
+        if (l == 0)
+            break;
+
+        // 第 l 层及更粗层的顶点已移动，其余顶点位移为零；插值后只写入第 l-1 层中未保留到第 l 层的顶点
+        for (size_t i = 0; i < coords.size(); ++i)
+            disp[i] = coords[i] - origin[i];
+        hierarchy.prolong(l - 1, disp);
+        const MultilevelLevel &fine = hierarchy.level(l - 1);
+        for (size_t i = 0; i < fine.verts_.size(); ++i)
+        {
+            if (fine.coarse_[i])
+                continue;
+            size_t v = 3 * static_cast<size_t>(fine.verts_[i]);
+            coords[v] = origin[v] + disp[v];
+            coords[v + 1] = origin[v + 1] + disp[v + 1];
+            coords[v + 2] = origin[v + 2] + disp[v + 2];
+        }
+    }
+    return stat;
+}
+
+MultilevelSmoothStat ComMultilevelSmooth(const MeshOptiOptions &opts, const std::vector<int> &adjOffset,
+                                         const std::vector<int> &adjVert, const std::vector<char> *fixed,
+                                         std::vector<double> &coords, const ComLevelSmooth &smooth)
+{
+    MultilevelHierarchy hierarchy;
+    hierarchy.build(adjOffset, adjVert, std::max(1, opts.multilevelNum_), opts.multilevelMinVert_, fixed);
+    return ComMultilevelSmooth(hierarchy, coords, smooth);
+}
+
+MultilevelBenchResult ComMultilevelBench(int latticeNum, int levelNum, double tol, int maxIter, unsigned int seed)
+{
+    MultilevelBenchResult result;
+    int n = latticeNum;
+    result.latticeNum_ = n;
+    if (n < 3)
+        return result;
+    int vertNum = n * n * n;
+    result.vertNum_ = vertNum;
+
+    // 点阵 6 邻接，边界点固定
+    auto id = [n](int i, int j, int k) { return (i * n + j) * n + k; };
+    std::vector<int> adjOffset(1, 0), adjVert;
+    std::vector<char> fixed(vertNum, 0);
+    std::vector<double> grid(3 * static_cast<size_t>(vertNum));
+    double h = 1. / (n - 1);
+    const int step[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                int v = id(i, j, k);
+                grid[3 * v] = i * h;
+                grid[3 * v + 1] = j * h;
+                grid[3 * v + 2] = k * h;
+                fixed[v] = i == 0 || j == 0 || k == 0 || i == n - 1 || j == n - 1 || k == n - 1;
+                for (const auto &d : step)
+                {
+                    int a = i + d[0], b = j + d[1], c = k + d[2];
+                    if (a >= 0 && a < n && b >= 0 && b < n && c >= 0 && c < n)
+                        adjVert.push_back(id(a, b, c));
+                }
+                adjOffset.push_back(static_cast<int>(adjVert.size()));
+            }
+        }
+    }
+
+    // 低频正弦位移（光滑迭代收敛最慢的分量）叠加网格尺度的随机扰动
+    const double pi = std::acos(-1.);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(-0.2 * h, 0.2 * h);
+    std::vector<double> start = grid;
+    for (int v = 0; v < vertNum; ++v)
+    {
+        if (fixed[v])
+            continue;
+        double *p = start.data() + 3 * static_cast<size_t>(v);
+        double bump = 0.1 * std::sin(pi * p[0]) * std::sin(pi * p[1]) * std::sin(pi * p[2]);
+        for (int d = 0; d < 3; ++d)
+            p[d] += bump + uni(rng);
+    }
+
+    // Jacobi Laplace 光滑本层非固定顶点相对点阵的位移（取本层邻点位移的平均）。粗层邻接不是点阵的
+    // 规则模板，直接平均坐标会偏离点阵，平均位移则在任意邻接下都以零位移为不动点。
+    // target 大于 0 时改为本层最大偏差不超过 target 时停止
+    double target = 0.;
+    ComLevelSmooth smooth = [&fixed, &grid, &target, tol, maxIter](int, const MultilevelLevel &lvl,
+                                                                  std::vector<double> &coords) {
+        int num = static_cast<int>(lvl.verts_.size());
+        std::vector<double> next(3 * static_cast<size_t>(num));
+        int iter = 0;
+        while (iter < maxIter)
+        {
+            ++iter;
+            double maxMove = 0., maxError = 0.;
+            for (int i = 0; i < num; ++i)
+            {
+                size_t v = 3 * static_cast<size_t>(lvl.verts_[i]);
+                const double *p = coords.data() + v;
+                double *q = next.data() + 3 * static_cast<size_t>(i);
+                int cnt = lvl.adjOffset_[i + 1] - lvl.adjOffset_[i];
+                if (fixed[lvl.verts_[i]] || cnt == 0)
+                {
+                    q[0] = p[0], q[1] = p[1], q[2] = p[2];
+                    continue;
+                }
+                double sum[3] = {0., 0., 0.};
+                for (int k = lvl.adjOffset_[i]; k < lvl.adjOffset_[i + 1]; ++k)
+                {
+                    size_t u = 3 * static_cast<size_t>(lvl.verts_[lvl.adjVert_[k]]);
+                    for (int d = 0; d < 3; ++d)
+                        sum[d] += coords[u + d] - grid[u + d];
+                }
+                for (int d = 0; d < 3; ++d)
+                {
+                    q[d] = grid[v + d] + sum[d] / cnt;
+                    maxMove = std::max(maxMove, std::fabs(q[d] - p[d]));
+                    maxError = std::max(maxError, std::fabs(q[d] - grid[v + d]));
+                }
+            }
+            for (int i = 0; i < num; ++i)
+            {
+                double *p = coords.data() + 3 * static_cast<size_t>(lvl.verts_[i]);
+                const double *q = next.data() + 3 * static_cast<size_t>(i);
+                p[0] = q[0], p[1] = q[1], p[2] = q[2];
+            }
+            if (target > 0. ? maxError <= target : maxMove < tol)
+                break;
+        }
+        return iter;
+    };
+    auto error = [&grid](const std::vector<double> &coords) {
+        double e = 0.;
+        for (size_t i = 0; i < coords.size(); ++i)
+            e = std::max(e, std::fabs(coords[i] - grid[i]));
+        return e;
+    };
+
+    std::vector<double> single = start;
+    auto clock = std::chrono::steady_clock::now();
+    MultilevelHierarchy flat;
+    flat.build(adjOffset, adjVert, 1, 0, &fixed);
+    result.singleIterNum_ = ComMultilevelSmooth(flat, single, smooth).fineIterNum();
+    auto now = std::chrono::steady_clock::now();
+    result.singleSeconds_ = std::chrono::duration<double>(now - clock).count();
+    result.singleError_ = error(single);
+
+    std::vector<double> multi = start;
+    clock = std::chrono::steady_clock::now();
+    MultilevelHierarchy hierarchy;
+    hierarchy.build(adjOffset, adjVert, levelNum, 0, &fixed);
+    MultilevelSmoothStat stat = ComMultilevelSmooth(hierarchy, multi, smooth);
+    now = std::chrono::steady_clock::now();
+    result.multiSeconds_ = std::chrono::duration<double>(now - clock).count();
+    result.multiError_ = error(multi);
+    result.levelNum_ = hierarchy.levelNum();
+    result.multiFineIterNum_ = stat.fineIterNum();
+    for (int l = 1; l < result.levelNum_; ++l)
+        result.multiCoarseIterNum_ += stat.iterNum_[l];
+
+    // 以最大移动量判断收敛时单层光滑提前停滞，另以多层结果的偏差为目标统计单层所需的迭代次数
+    single = start;
+    target = result.multiError_;
+    result.singleMatchIterNum_ = ComMultilevelSmooth(flat, single, smooth).fineIterNum();
+    return result;
+}
+
+std::string ComMultilevelBenchToString(const MultilevelBenchResult &result, LogFileFormat format)
+{
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"lattice", ComTelemetryValue(result.latticeNum_)},
+        {"verts", ComTelemetryValue(result.vertNum_)},
+        {"levels", ComTelemetryValue(result.levelNum_)},
+        {"singleIter", ComTelemetryValue(result.singleIterNum_)},
+        {"multiFineIter", ComTelemetryValue(result.multiFineIterNum_)},
+        {"multiCoarseIter", ComTelemetryValue(result.multiCoarseIterNum_)},
+        {"singleMatchIter", ComTelemetryValue(result.singleMatchIterNum_)},
+        {"fineIterSaved", ComTelemetryValue(result.multiFineIterNum_ > 0 ? static_cast<double>(result.singleMatchIterNum_) /
+                                                                               result.multiFineIterNum_
+                                                                         : 0.)},
+        {"singleSeconds", ComTelemetryValue(result.singleSeconds_)},
+        {"multiSeconds", ComTelemetryValue(result.multiSeconds_)},
+        {"singleError", ComTelemetryValue(result.singleError_)},
+        {"multiError", ComTelemetryValue(result.multiError_)},
+    };
+    return ComTelemetryFields(fields, format);
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComMultilevel.h
+// 摘    要：多层网格优化的顶点层次结构，由顶点邻接关系逐层粗化，粗层位移插值到细层；
+//           由粗到细的多层光滑驱动与对比测试
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMMULTILEVEL_H_
+#define EMMPMESH_COMMON_COMMULTILEVEL_H_
+
+#include "ComConstants.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// 单层顶点集合
+struct MultilevelLevel
+{
+    std::vector<int> verts_;     // 本层顶点（全局编号，升序）
+    std::vector<int> adjOffset_; // 本层邻接 CSR 偏移（按 verts_ 的局部序号）
+    std::vector<int> adjVert_;   // 本层邻接 CSR 顶点（局部序号）
+    std::vector<char> coarse_;   // 本层顶点是否保留到下一粗层
+};
+
+// 顶点层次结构：第 0 层为全部顶点，第 l+1 层为第 l 层邻接图的极大独立集。
+// 粗层优化后，第 l 层中未保留的顶点位移取其在第 l 层邻接图中保留邻点位移的平均值，
+// 使低频变形在粗层上以少量迭代传播，细层只需修正高频部分
+class MultilevelHierarchy
+{
+public:
+    MultilevelHierarchy() = default;
+
+    /************************************************************************
+    * 功能描述：由全网格顶点邻接 CSR 构建层次结构。levelNum 为最多层数（含第 0 层），
+    *           某层顶点数少于 minVertNum 时停止粗化；fixed[v] 为真的顶点（边界等）
+    *           总是保留到所有粗层，以保证插值时边界位移为零
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void build(const std::vector<int> &adjOffset, const std::vector<int> &adjVert,
+               int levelNum, int minVertNum, const std::vector<char> *fixed = nullptr);
+
+    int levelNum() const { return static_cast<int>(levels_.size()); }
+    const MultilevelLevel &level(int l) const { return levels_[l]; }
+
+    /************************************************************************
+    * 功能描述：将第 l+1 层的位移插值到第 l 层。disp 为全局顶点位移（vertNum * 3），
+    *           第 l+1 层顶点的位移已由粗层优化得到，本函数填充第 l 层其余顶点
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void prolong(int l, std::vector<double> &disp) const;
+
+private:
+    std::vector<MultilevelLevel> levels_; // 第 0 层为最细层
+};
+
+// 单层光滑回调：光滑第 level 层的顶点 lvl.verts_（邻接为本层 CSR），直接修改全局坐标 coords（vertNum * 3），
+// 只移动本层顶点；返回本层执行的迭代次数
+using ComLevelSmooth = std::function<int(int level, const MultilevelLevel &lvl, std::vector<double> &coords)>;
+
+// 多层光滑统计
+struct MultilevelSmoothStat
+{
+    std::vector<int> vertNum_; // 各层顶点数（第 0 层为最细层）
+    std::vector<int> iterNum_; // 各层迭代次数
+
+    int fineIterNum() const { return iterNum_.empty() ? 0 : iterNum_[0]; }
+};
+
+/************************************************************************
+* 功能描述：由粗到细的多层光滑。从最粗层开始，每层以 smooth 光滑本层顶点（本层顶点是细层顶点的子集，
+*           坐标直接取全局坐标，即注入限制），再将本层顶点相对初始坐标的累计位移以 prolong
+*           插值到下一细层未保留的顶点，最后在第 0 层光滑全部顶点
+* 返回值：MultilevelSmoothStat - 各层顶点数与迭代次数
+* 作者：邓龙威
+/************************************************************************/
+MultilevelSmoothStat ComMultilevelSmooth(const MultilevelHierarchy &hierarchy, std::vector<double> &coords,
+                                         const ComLevelSmooth &smooth);
+
+/************************************************************************
+* 功能描述：按 opts.multilevelNum_ 与 opts.multilevelMinVert_ 由顶点邻接 CSR 构建层次结构，
+*           再执行 ComMultilevelSmooth；multilevelNum_ 不大于 1 时只在第 0 层光滑一次
+* 返回值：MultilevelSmoothStat
+* 作者：邓龙威
+/************************************************************************/
+MultilevelSmoothStat ComMultilevelSmooth(const MeshOptiOptions &opts, const std::vector<int> &adjOffset,
+                                         const std::vector<int> &adjVert, const std::vector<char> *fixed,
+                                         std::vector<double> &coords, const ComLevelSmooth &smooth);
+
+// 多层光滑与单层光滑的对比结果
+struct MultilevelBenchResult
+{
+    int latticeNum_ = 0;         // 点阵每个方向的点数 n
+    int vertNum_ = 0;            // 顶点数 n³
+    int levelNum_ = 0;           // 实际层数
+    int singleIterNum_ = 0;      // 单层光滑收敛所需的迭代次数
+    int singleMatchIterNum_ = 0; // 单层光滑达到多层光滑结果偏差所需的迭代次数
+    int multiFineIterNum_ = 0;   // 多层光滑中第 0 层的迭代次数
+    int multiCoarseIterNum_ = 0; // 多层光滑中各粗层的迭代次数之和
+    double singleSeconds_ = 0.;  // 单层光滑耗时（秒）
+    double multiSeconds_ = 0.;   // 多层光滑耗时（秒，含层次结构构建）
+    double singleError_ = 0.;    // 单层光滑结果与点阵坐标的最大偏差
+    double multiError_ = 0.;     // 多层光滑结果与点阵坐标的最大偏差
+};
+
+/************************************************************************
+* 功能描述：n×n×n 点阵（6 邻接，边界点固定）的内部点叠加低频正弦位移与随机扰动，
+*           以 Jacobi Laplace 光滑相对点阵的位移（每次迭代取邻点位移的平均，最大移动量小于 tol 时收敛）
+*           分别做单层与 levelNum 层光滑，对比第 0 层的迭代次数与耗时；另统计单层光滑
+*           达到多层光滑结果偏差所需的迭代次数（超过 maxIter 时为 maxIter）
+* 返回值：MultilevelBenchResult
+* 作者：邓龙威
+/************************************************************************/
+MultilevelBenchResult ComMultilevelBench(int latticeNum, int levelNum, double tol = 1e-6, int maxIter = 100000,
+                                         unsigned int seed = 0);
+
+/************************************************************************
+* 功能描述：将测试结果格式化为一行（Json / Logfmt，Text 同 Logfmt），字段含各项迭代次数、
+*           耗时、误差与 fineIterSaved（达到相同偏差时单层迭代次数与多层第 0 层迭代次数之比）
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComMultilevelBenchToString(const MultilevelBenchResult &result, LogFileFormat format);
+
+#endif // EMMPMESH_COMMON_COMMULTILEVEL_H_
@@ -0,0 +1,157 @@
+#include "pch.h"
+
+#include "ComOptiScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <utility>
+
+void OptiStageStat::merge(const OptiStageStat &other)
+{
+    for (int i = 0; i < OptiStageNum; ++i)
+    {
+        iterNum_[i] += other.iterNum_[i];
+        switchNum_[i] += other.switchNum_[i];
+    }
+    entityNum_ += other.entityNum_;
+}
+
+OptiStageScheduler::OptiStageScheduler(const MeshOptiAlgorithmOptions &opts)
+    : enabled_{opts.useGD_, opts.useCG_, opts.useQN_},
+      adaptive_(opts.adaptiveSwitch_),
+      switchRate_(opts.switchRate_),
+      switchWindow_(std::max(1, opts.switchWindow_))
+{
+    // 三种算法均未开启时退化为梯度下降法
+    if (!enabled_[0] && !enabled_[1] && !enabled_[2])
+        enabled_[0] = true;
+}
+
+OptiStage OptiStageScheduler::begin(int entityID)
+{
+    entityID_ = entityID;
+    iter_ = 0;
+    slowNum_ = 0;
+    ++stat_.entityNum_;
+
+    if (adaptive_)
+    {
+        for (int i = 0; i < OptiStageNum; ++i)
+        {
+            if (enabled_[i])
+            {
+                stage_ = static_cast<OptiStage>(i);
+                break;
+            }
+        }
+    }
+    else
+    {
+        for (int i = OptiStageNum - 1; i >= 0; --i)
+        {
+            if (enabled_[i])
+            {
+                stage_ = static_cast<OptiStage>(i);
+                break;
+            }
+        }
+    }
+    return stage_;
+}
+
+bool OptiStageScheduler::update(double fPrev, double fCur)
+{
+    ++iter_;
+    ++stat_.iterNum_[static_cast<int>(stage_)];
+    if (!adaptive_)
+        return false;
+
+    // 相对下降率，与 epsF_ 判断使用相同的归一化方式
+    double rate = (fPrev - fCur) / std::max({std::fabs(fPrev), std::fabs(fCur), 1.});
+    if (rate >= switchRate_)
+    {
+        slowNum_ = 0;
+        return false;
+    }
+    if (++slowNum_ < switchWindow_)
+        return false;
+
+    for (int i = static_cast<int>(stage_) + 1; i < OptiStageNum; ++i)
+    {
+        if (!enabled_[i])
+            continue;
+
+        OptiSwitchEvent event;
+        event.entityID_ = entityID_;
+        event.iter_ = iter_;
+        event.from_ = stage_;
+        event.to_ = static_cast<OptiStage>(i);
+        event.rate_ = rate;
+        if (sink_)
+            sink_(LogLevel::Stat, eventToString(event));
+        else
+            events_.push_back(event);
+
+        stage_ = event.to_;
+        ++stat_.switchNum_[i];
+        slowNum_ = 0;
+        return true;
+    }
+    return false;
+}
+
+std::vector<OptiSwitchEvent> OptiStageScheduler::takeEvents()
+{
+    std::vector<OptiSwitchEvent> out;
+    out.swap(events_);
+    return out;
+}
+
+void OptiStageScheduler::flushStat()
+{
+    if (!sink_)
+        return;
+    for (const auto &event : takeEvents())
+        sink_(LogLevel::Stat, eventToString(event));
+    sink_(LogLevel::Stat, statToString(stat_));
+}
+
+std::string OptiStageScheduler::stageToString(OptiStage stage)
+{
+    switch (stage)
+    {
+    case OptiStage::GD:
+        return "GD";
+    case OptiStage::CG:
+        return "CG";
+    case OptiStage::QN:
+        return "QN";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+std::string OptiStageScheduler::eventToString(const OptiSwitchEvent &event)
+{
+    std::ostringstream oss;
+    oss << "entity=" << event.entityID_
+        << " iter=" << event.iter_
+        << " from=" << stageToString(event.from_)
+        << " to=" << stageToString(event.to_)
+        << " rate=" << event.rate_;
+    return oss.str();
+}
+
+std::string OptiStageScheduler::statToString(const OptiStageStat &stat)
+{
+    std::ostringstream oss;
+    oss << "entities=" << stat.entityNum_;
+    for (int i = 0; i < OptiStageNum; ++i)
+    {
+        std::string name = stageToString(static_cast<OptiStage>(i));
+        oss << " iter" << name << "=" << stat.iterNum_[i]
+            << " switch2" << name << "=" << stat.switchNum_[i];
+    }
+    return oss.str();
+}
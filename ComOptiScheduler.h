@@ -0,0 +1,130 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComOptiScheduler.h
+// 摘    要：局部优化算法自适应切换调度器，按下降率从 GD 逐级升级到 CG / QN
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMOPTISCHEDULER_H_
+#define EMMPMESH_COMMON_COMOPTISCHEDULER_H_
+
+#include "ComConstants.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 优化算法阶段，按代价从低到高排列
+enum class OptiStage
+{
+    GD = 0, // 梯度下降法
+    CG = 1, // 共轭梯度法
+    QN = 2, // 拟牛顿法
+};
+inline const int OptiStageNum = 3;
+
+// 一次算法切换记录，以 LogLevel::Stat 输出
+struct OptiSwitchEvent
+{
+    int entityID_ = -1;              // 顶点 / 单元 / patch 编号
+    int iter_ = 0;                   // 切换发生时的迭代步
+    OptiStage from_ = OptiStage::GD; // 切换前算法
+    OptiStage to_ = OptiStage::GD;   // 切换后算法
+    double rate_ = 0.;               // 触发切换的相对下降率
+};
+
+// 调度统计：各阶段消耗的迭代步数与切换次数
+struct OptiStageStat
+{
+    long long iterNum_[OptiStageNum] = {0, 0, 0};  // 各阶段迭代步数
+    long long switchNum_[OptiStageNum] = {0, 0, 0}; // 升级到各阶段的次数
+    long long entityNum_ = 0;                       // 调度的优化对象个数
+
+    /************************************************************************
+    * 功能描述：合并另一个线程的统计
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void merge(const OptiStageStat &other);
+};
+
+// 自适应切换调度器，每个线程一个实例，对每个优化对象调用 begin() 后逐步调用 update()
+class OptiStageScheduler
+{
+public:
+    /************************************************************************
+    * 功能描述：构造函数，按 useGD_ / useCG_ / useQN_ 确定可用阶段
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    explicit OptiStageScheduler(const MeshOptiAlgorithmOptions &opts);
+
+    /************************************************************************
+    * 功能描述：开始调度一个新的优化对象，返回初始算法（最低代价的可用算法）
+    *           未开启 adaptiveSwitch_ 时返回最高代价的可用算法且不再切换
+    * 返回值：OptiStage
+    * 作者：邓龙威
+    /************************************************************************/
+    OptiStage begin(int entityID);
+
+    /************************************************************************
+    * 功能描述：完成一步迭代后更新下降率，连续 switchWindow_ 步下降率低于
+    *           switchRate_ 时升级到下一个可用算法
+    * 返回值：bool - 本步是否发生切换（调用方需重置方向 / 历史）
+    * 作者：邓龙威
+    /************************************************************************/
+    bool update(double fPrev, double fCur);
+
+    OptiStage stage() const { return stage_; }
+    const OptiStageStat &stat() const { return stat_; }
+
+    /************************************************************************
+    * 功能描述：设置日志输出回调。设置后每次切换立即以 LogLevel::Stat 输出 eventToString，
+    *           不再进入切换记录；回调由调度器所在线程调用，需自行保证线程安全
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setLogSink(ComLogSink sink) { sink_ = std::move(sink); }
+
+    /************************************************************************
+    * 功能描述：以 LogLevel::Stat 输出未输出的切换记录与调度统计，未设置回调时不输出
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void flushStat();
+
+    /************************************************************************
+    * 功能描述：获取并清空自上次调用以来的切换记录（未设置日志输出回调时使用）
+    * 返回值：std::vector<OptiSwitchEvent>
+    * 作者：邓龙威
+    /************************************************************************/
+    std::vector<OptiSwitchEvent> takeEvents();
+
+    /************************************************************************
+    * 功能描述：切换记录与统计的日志消息，key=value 形式，可直接作为日志 extras
+    * 返回值：std::string
+    * 作者：邓龙威
+    /************************************************************************/
+    static std::string eventToString(const OptiSwitchEvent &event);
+    static std::string statToString(const OptiStageStat &stat);
+    static std::string stageToString(OptiStage stage);
+
+private:
+    bool enabled_[OptiStageNum]; // 各阶段是否可用
+    bool adaptive_;              // 是否自适应切换
+    double switchRate_;          // 下降率阈值
+    int switchWindow_;           // 判断窗口
+
+    OptiStage stage_ = OptiStage::GD; // 当前算法
+    int entityID_ = -1;               // 当前优化对象
+    int iter_ = 0;                    // 当前对象的迭代步
+    int slowNum_ = 0;                 // 连续慢速下降步数
+
+    OptiStageStat stat_;                  // 调度统计
+    std::vector<OptiSwitchEvent> events_; // 未输出的切换记录
+    ComLogSink sink_;                     // 日志输出回调
+};
+
+#endif // EMMPMESH_COMMON_COMOPTISCHEDULER_H_
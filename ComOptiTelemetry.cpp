@@ -0,0 +1,212 @@
+#include "pch.h"
+
+#include "ComOptiTelemetry.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+long long Log2Histogram::quantile(double q) const
+{
+    long long total = 0;
+    for (int k = 0; k < BinNum; ++k)
+        total += bins_[k];
+    if (total == 0)
+        return 0;
+
+    long long target = static_cast<long long>(std::ceil(q * static_cast<double>(total)));
+    target = std::max(1LL, std::min(total, target));
+    long long acc = 0;
+    for (int k = 0; k < BinNum; ++k)
+    {
+        acc += bins_[k];
+        if (acc >= target)
+            return k == 0 ? 0 : (1LL << k) - 1;
+    }
+    return (1LL << (BinNum - 1)) - 1;
+}
+
+void OptiTelemetryStat::merge(const OptiTelemetryStat &other)
+{
+    solveNum_ += other.solveNum_;
+    sampledNum_ += other.sampledNum_;
+    for (int i = 0; i < OptiStopReasonNum; ++i)
+        stopNum_[i] += other.stopNum_[i];
+    iterNum_ += other.iterNum_;
+    funcEvalNum_ += other.funcEvalNum_;
+    gradEvalNum_ += other.gradEvalNum_;
+    lineSearchNum_ += other.lineSearchNum_;
+    sampledSeconds_ += other.sampledSeconds_;
+    iterHist_.merge(other.iterHist_);
+    funcEvalHist_.merge(other.funcEvalHist_);
+    timeHist_.merge(other.timeHist_);
+}
+
+void OptiTelemetry::end(OptiSolveScope scope, int iterNum, int funcEvalNum, int gradEvalNum, int lineSearchNum,
+                        OptiStopReason reason)
+{
+    OptiTelemetryStat &s = stat_[static_cast<int>(scope)];
+    ++s.solveNum_;
+    ++s.stopNum_[static_cast<int>(reason)];
+    s.iterNum_ += iterNum;
+    s.funcEvalNum_ += funcEvalNum;
+    s.gradEvalNum_ += gradEvalNum;
+    s.lineSearchNum_ += lineSearchNum;
+    if (!sampled_)
+        return;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    ++s.sampledNum_;
+    s.sampledSeconds_ += seconds;
+    s.iterHist_.add(iterNum);
+    s.funcEvalHist_.add(funcEvalNum);
+    s.timeHist_.add(static_cast<long long>(seconds * 1e6));
+    sampled_ = false;
+}
+
+OptiTelemetryStat OptiTelemetry::merge(const std::vector<OptiTelemetry> &threads, OptiSolveScope scope)
+{
+    OptiTelemetryStat total;
+    for (const auto &t : threads)
+        total.merge(t.stat(scope));
+    return total;
+}
+
+std::string OptiTelemetry::stopReasonToString(OptiStopReason reason)
+{
+    switch (reason)
+    {
+    case OptiStopReason::EPS_G:
+        return "epsG";
+    case OptiStopReason::EPS_F:
+        return "epsF";
+    case OptiStopReason::EPS_X:
+        return "epsX";
+    case OptiStopReason::MAX_ITER:
+        return "maxIter";
+    case OptiStopReason::LINE_SEARCH_FAIL:
+        return "lineSearchFail";
+    case OptiStopReason::OTHER:
+        return "other";
+    default:
+        return "unknown";
+    }
+}
+
+std::string OptiTelemetry::scopeToString(OptiSolveScope scope)
+{
+    switch (scope)
+    {
+    case OptiSolveScope::LOCAL:
+        return "local";
+    case OptiSolveScope::GLOBAL:
+        return "global";
+    default:
+        return "unknown";
+    }
+}
+
+// 是否可作为 JSON 数值直接输出：strtod 完整读取、有限值，且符合 JSON 数值语法
+// （不接受 "-"、"e"、"+1"、".5"、"1."、十六进制、nan / inf 等）
+static bool ComJsonNumber(const std::string &s)
+{
+    if (s.empty() || s.find_first_not_of("0123456789.-+eE") != std::string::npos)
+        return false;
+    size_t digit = s[0] == '-' ? 1 : 0;
+    if (digit >= s.size() || s[digit] < '0' || s[digit] > '9' || s.back() == '.')
+        return false;
+    if (s[digit] == '0' && digit + 1 < s.size() && s[digit + 1] >= '0' && s[digit + 1] <= '9')
+        return false;
+    size_t dot = s.find('.');
+    if (dot != std::string::npos && (dot + 1 >= s.size() || s[dot + 1] < '0' || s[dot + 1] > '9'))
+        return false;
+
+    const char *begin = s.c_str();
+    char *end = nullptr;
+    errno = 0;
+    double v = std::strtod(begin, &end);
+    return end == begin + s.size() && errno != ERANGE && std::isfinite(v);
+}
+
+// JSON 字符串转义
+static std::string ComJsonString(const std::string &s)
+{
+    std::string out;
+    out.reserve(s.size() + 2);
+    out += '"';
+    for (char ch : s)
+    {
+        if (ch == '"' || ch == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(ch) < 0x20)
+            out += ' ';
+        else
+            out += ch;
+    }
+    out += '"';
+    return out;
+}
+
+std::string ComTelemetryFields(const std::vector<std::pair<std::string, std::string>> &fields, LogFileFormat format)
+{
+    std::ostringstream oss;
+    if (format == LogFileFormat::Json)
+    {
+        oss << "{";
+        for (size_t i = 0; i < fields.size(); ++i)
+        {
+            oss << (i ? "," : "") << ComJsonString(fields[i].first) << ":";
+            if (ComJsonNumber(fields[i].second))
+                oss << fields[i].second;
+            else
+                oss << ComJsonString(fields[i].second);
+        }
+        oss << "}";
+    }
+    else
+    {
+        for (size_t i = 0; i < fields.size(); ++i)
+            oss << (i ? " " : "") << fields[i].first << "=" << fields[i].second;
+    }
+    return oss.str();
+}
+
+std::string OptiTelemetry::formatStat(const OptiTelemetryStat &stat, OptiSolveScope scope, LogFileFormat format)
+{
+    double n = stat.solveNum_ > 0 ? static_cast<double>(stat.solveNum_) : 1.;
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"scope", scopeToString(scope)},
+        {"solves", ComTelemetryValue(stat.solveNum_)},
+        {"sampled", ComTelemetryValue(stat.sampledNum_)},
+    };
+    for (int i = 0; i < OptiStopReasonNum; ++i)
+        fields.push_back({"stop." + stopReasonToString(static_cast<OptiStopReason>(i)), ComTelemetryValue(stat.stopNum_[i])});
+    fields.push_back({"iter.avg", ComTelemetryValue(stat.iterNum_ / n)});
+    fields.push_back({"iter.p50", ComTelemetryValue(stat.iterHist_.quantile(0.5))});
+    fields.push_back({"iter.p99", ComTelemetryValue(stat.iterHist_.quantile(0.99))});
+    fields.push_back({"fEval.avg", ComTelemetryValue(stat.funcEvalNum_ / n)});
+    fields.push_back({"fEval.p50", ComTelemetryValue(stat.funcEvalHist_.quantile(0.5))});
+    fields.push_back({"fEval.p99", ComTelemetryValue(stat.funcEvalHist_.quantile(0.99))});
+    fields.push_back({"gEval.avg", ComTelemetryValue(stat.gradEvalNum_ / n)});
+    fields.push_back({"lineSearch.avg", ComTelemetryValue(stat.lineSearchNum_ / n)});
+    return ComTelemetryFields(fields, format);
+}
+
+std::string OptiTelemetry::formatPerf(const OptiTelemetryStat &stat, OptiSolveScope scope, LogFileFormat format)
+{
+    double avgUs = stat.sampledNum_ > 0 ? stat.sampledSeconds_ * 1e6 / static_cast<double>(stat.sampledNum_) : 0.;
+    // 按采样比例外推全部求解耗时
+    double estSeconds = stat.sampledNum_ > 0 ? avgUs * 1e-6 * static_cast<double>(stat.solveNum_) : 0.;
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"scope", scopeToString(scope)},
+        {"sampled", ComTelemetryValue(stat.sampledNum_)},
+        {"sampledSeconds", ComTelemetryValue(stat.sampledSeconds_)},
+        {"estSeconds", ComTelemetryValue(estSeconds)},
+        {"us.avg", ComTelemetryValue(avgUs)},
+        {"us.p50", ComTelemetryValue(stat.timeHist_.quantile(0.5))},
+        {"us.p90", ComTelemetryValue(stat.timeHist_.quantile(0.9))},
+        {"us.p99", ComTelemetryValue(stat.timeHist_.quantile(0.99))},
+    };
+    return ComTelemetryFields(fields, format);
+}
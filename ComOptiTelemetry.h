@@ -0,0 +1,202 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComOptiTelemetry.h
+// 摘    要：优化求解遥测：每线程计数器记录迭代步数、函数 / 梯度求值次数、线搜索试探次数、
+//           停止原因与耗时，按采样率记录直方图，合并后按 LogFileFormat 格式化输出
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMOPTITELEMETRY_H_
+#define EMMPMESH_COMMON_COMOPTITELEMETRY_H_
+
+#include "ComConstants.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 优化求解停止原因
+enum class OptiStopReason
+{
+    EPS_G = 0,            // ||∇F(k)||<=epsG_
+    EPS_F = 1,            // |F(k+1)-F(k)|<=epsF_*max{|F(k)|,|F(k+1)|,1}
+    EPS_X = 2,            // ||X(k+1)-X(k)||<=epsX_
+    MAX_ITER = 3,         // 达到 maxIter_
+    LINE_SEARCH_FAIL = 4, // 线搜索失败（步长低于 alphaMin_ 或无下降方向）
+    OTHER = 5,            // 其他（非法网格回退、取消等）
+};
+inline const int OptiStopReasonNum = 6;
+
+// 求解范围
+enum class OptiSolveScope
+{
+    LOCAL = 0,  // 局部求解（SIGLE_VERT / PATCH_REGION）
+    GLOBAL = 1, // 全局求解（ALL_REGION）
+};
+inline const int OptiSolveScopeNum = 2;
+
+/************************************************************************
+* 功能描述：按 eps / maxIter 判定停止原因，判定顺序与注释中的停止条件一致。
+*           Opts 为 GradientDescentOptions / ConjugateGradientOptions / QuasiNewtonOptions，
+*           iter 为已完成的迭代步数，xStep 为 ||X(k+1)-X(k)||
+* 返回值：bool - 是否停止；停止时写入 reason
+* 作者：邓龙威
+/************************************************************************/
+template <typename Opts>
+bool ComCheckStop(const Opts &opts, int iter, double gNorm, double fPrev, double fCur, double xStep,
+                  OptiStopReason &reason)
+{
+    if (gNorm <= opts.epsG_)
+        reason = OptiStopReason::EPS_G;
+    else if (std::fabs(fCur - fPrev) <= opts.epsF_ * std::max({std::fabs(fPrev), std::fabs(fCur), 1.}))
+        reason = OptiStopReason::EPS_F;
+    else if (xStep <= opts.epsX_)
+        reason = OptiStopReason::EPS_X;
+    else if (opts.maxIter_ > 0 && iter >= opts.maxIter_)
+        reason = OptiStopReason::MAX_ITER;
+    else
+        return false;
+    return true;
+}
+
+// 以 2 为底的对数直方图：第 0 个桶为 v <= 0，第 k 个桶为 [2^(k-1), 2^k)
+struct Log2Histogram
+{
+    static const int BinNum = 40;
+    long long bins_[BinNum] = {};
+
+    void add(long long v)
+    {
+        int k = 0;
+        while (v > 0 && k < BinNum - 1)
+        {
+            v >>= 1;
+            ++k;
+        }
+        ++bins_[k];
+    }
+
+    void merge(const Log2Histogram &other)
+    {
+        for (int k = 0; k < BinNum; ++k)
+            bins_[k] += other.bins_[k];
+    }
+
+    /************************************************************************
+    * 功能描述：q 分位数所在桶的上界（2^k - 1），无样本时返回 0
+    * 返回值：long long
+    * 作者：邓龙威
+    /************************************************************************/
+    long long quantile(double q) const;
+};
+
+// 单个范围的遥测统计
+struct OptiTelemetryStat
+{
+    long long solveNum_ = 0;                           // 求解次数（全部计数）
+    long long sampledNum_ = 0;                         // 采样求解次数（计时与直方图只统计采样求解）
+    long long stopNum_[OptiStopReasonNum] = {};        // 各停止原因次数
+    long long iterNum_ = 0;                            // 迭代步数之和
+    long long funcEvalNum_ = 0;                        // 函数求值次数之和
+    long long gradEvalNum_ = 0;                        // 梯度求值次数之和
+    long long lineSearchNum_ = 0;                      // 线搜索试探次数之和
+    double sampledSeconds_ = 0.;                       // 采样求解耗时之和（秒）
+    Log2Histogram iterHist_, funcEvalHist_, timeHist_; // 采样求解的迭代步数、函数求值次数与耗时（微秒）直方图
+
+    /************************************************************************
+    * 功能描述：合并另一个线程的统计
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void merge(const OptiTelemetryStat &other);
+};
+
+// 优化遥测计数器，每个线程一个实例，无共享写入。
+// 计数与停止原因对每次求解都累加；计时与直方图每 sampleRate 次求解采样一次，
+// 未采样的求解不读取时钟
+class OptiTelemetry
+{
+public:
+    explicit OptiTelemetry(int sampleRate = 1) : sampleRate_(sampleRate < 1 ? 1 : sampleRate) {}
+
+    /************************************************************************
+    * 功能描述：开始一次求解，决定是否采样，采样时记录起始时间
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void begin()
+    {
+        sampled_ = ++counter_ >= sampleRate_;
+        if (sampled_)
+        {
+            counter_ = 0;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    /************************************************************************
+    * 功能描述：结束一次求解，累加计数；采样时记录耗时与直方图
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void end(OptiSolveScope scope, int iterNum, int funcEvalNum, int gradEvalNum, int lineSearchNum,
+             OptiStopReason reason);
+
+    const OptiTelemetryStat &stat(OptiSolveScope scope) const { return stat_[static_cast<int>(scope)]; }
+
+    /************************************************************************
+    * 功能描述：合并各线程的统计
+    * 返回值：OptiTelemetryStat
+    * 作者：邓龙威
+    /************************************************************************/
+    static OptiTelemetryStat merge(const std::vector<OptiTelemetry> &threads, OptiSolveScope scope);
+
+    /************************************************************************
+    * 功能描述：LogLevel::Stat 消息：求解次数、停止原因分布、平均与分位迭代步数 / 求值次数
+    *           LogLevel::Perf 消息：采样耗时之和、平均与分位耗时
+    *           format 为 Text / Logfmt 时为 key=value 串（空格分隔），Json 时为 JSON 对象
+    * 返回值：std::string
+    * 作者：邓龙威
+    /************************************************************************/
+    static std::string formatStat(const OptiTelemetryStat &stat, OptiSolveScope scope, LogFileFormat format);
+    static std::string formatPerf(const OptiTelemetryStat &stat, OptiSolveScope scope, LogFileFormat format);
+
+    static std::string stopReasonToString(OptiStopReason reason);
+    static std::string scopeToString(OptiSolveScope scope);
+
+private:
+    int sampleRate_;       // 采样间隔
+    int counter_ = 0;      // 距上次采样的求解次数
+    bool sampled_ = false; // 当前求解是否采样
+
+    std::chrono::steady_clock::time_point start_; // 采样求解的起始时间
+    OptiTelemetryStat stat_[OptiSolveScopeNum];   // 各范围统计
+};
+
+/************************************************************************
+* 功能描述：按日志格式拼接字段，Text / Logfmt 时为 key=value 串（空格分隔），Json 时为
+*           JSON 对象；Json 时只有完整且有限的 JSON 数值不加引号，其余值（含 nan / inf）按字符串转义输出
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComTelemetryFields(const std::vector<std::pair<std::string, std::string>> &fields, LogFileFormat format);
+
+/************************************************************************
+* 功能描述：将数值格式化为 ComTelemetryFields 的字段值（默认流格式）
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+template <typename T>
+std::string ComTelemetryValue(const T &v)
+{
+    std::ostringstream oss;
+    oss << v;
+    return oss.str();
+}
+
+#endif // EMMPMESH_COMMON_COMOPTITELEMETRY_H_
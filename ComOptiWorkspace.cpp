@@ -0,0 +1,156 @@
+#include "pch.h"
+
+#include "ComOptiWorkspace.h"
+#include "ComParallel.h"
+
+void OptiWorkspace::resize(int varNum, int m)
+{
+    varNum_ = varNum;
+    // std::vector::resize 在容量足够时不重新分配内存
+    x_.resize(varNum);
+    xPrev_.resize(varNum);
+    xTrial_.resize(varNum);
+    g_.resize(varNum);
+    gPrev_.resize(varNum);
+    d_.resize(varNum);
+    alpha_.resize(m);
+}
+
+void LbfgsHistory::reset(int varNum, int m)
+{
+    varNum_ = varNum;
+    m_ = m;
+    s_.resize(static_cast<size_t>(varNum) * m);
+    y_.resize(static_cast<size_t>(varNum) * m);
+    rho_.resize(m);
+    clear();
+}
+
+bool LbfgsHistory::push(const double *s, const double *y, double eps)
+{
+    if (m_ <= 0)
+        return false;
+
+    double ys = 0., yy = 0.;
+    for (int i = 0; i < varNum_; ++i)
+    {
+        ys += y[i] * s[i];
+        yy += y[i] * y[i];
+    }
+    if (ys <= eps * yy)
+        return false;
+
+    double *sDst = s_.data() + static_cast<size_t>(head_) * varNum_;
+    double *yDst = y_.data() + static_cast<size_t>(head_) * varNum_;
+    std::copy(s, s + varNum_, sDst);
+    std::copy(y, y + varNum_, yDst);
+    rho_[head_] = 1. / ys;
+
+    head_ = (head_ + 1) % m_;
+    if (size_ < m_)
+        ++size_;
+    return true;
+}
+
+void LbfgsHistory::twoLoop(const double *g, double *d, double *alpha) const
+{
+    for (int i = 0; i < varNum_; ++i)
+        d[i] = -g[i];
+    if (size_ == 0)
+        return;
+
+    // 第一次循环：从最新到最旧
+    for (int k = 0; k < size_; ++k)
+    {
+        int idx = (head_ - 1 - k + m_) % m_;
+        const double *s = s_.data() + static_cast<size_t>(idx) * varNum_;
+        const double *y = y_.data() + static_cast<size_t>(idx) * varNum_;
+        double a = 0.;
+        for (int i = 0; i < varNum_; ++i)
+            a += s[i] * d[i];
+        a *= rho_[idx];
+        alpha[idx] = a;
+        for (int i = 0; i < varNum_; ++i)
+            d[i] -= a * y[i];
+    }
+
+    // 初始海森矩阵近似 H0 = (s·y)/(y·y) I，取最新一组曲率对
+    {
+        int idx = (head_ - 1 + m_) % m_;
+        const double *y = y_.data() + static_cast<size_t>(idx) * varNum_;
+        double yy = 0.;
+        for (int i = 0; i < varNum_; ++i)
+            yy += y[i] * y[i];
+        double gamma = 1. / (rho_[idx] * yy);
+        for (int i = 0; i < varNum_; ++i)
+            d[i] *= gamma;
+    }
+
+    // 第二次循环：从最旧到最新
+    for (int k = size_ - 1; k >= 0; --k)
+    {
+        int idx = (head_ - 1 - k + m_) % m_;
+        const double *s = s_.data() + static_cast<size_t>(idx) * varNum_;
+        const double *y = y_.data() + static_cast<size_t>(idx) * varNum_;
+        double b = 0.;
+        for (int i = 0; i < varNum_; ++i)
+            b += y[i] * d[i];
+        b *= rho_[idx];
+        for (int i = 0; i < varNum_; ++i)
+            d[i] += (alpha[idx] - b) * s[i];
+    }
+}
+
+void OptiWorkspacePool::init(int threadNum, int maxVarNum, const QuasiNewtonOptions &qnOpts, int patchNum)
+{
+    threadNum = ComThreadNum(threadNum);
+    maxVarNum_ = maxVarNum;
+    m_ = qnOpts.m_;
+    warmStart_ = qnOpts.warmStart_;
+
+    int m = std::min(m_, maxVarNum_);
+    workspaces_.assign(threadNum, OptiWorkspace{});
+    threadHistory_.assign(threadNum, LbfgsHistory{});
+    for (int t = 0; t < threadNum; ++t)
+    {
+        // 按最大空腔一次性分配，之后的 resize 不再触发内存分配
+        workspaces_[t].resize(maxVarNum_, m);
+        threadHistory_[t].reset(maxVarNum_, m);
+    }
+
+    patchHistory_.clear();
+    if (warmStart_)
+        patchHistory_.resize(patchNum);
+}
+
+OptiWorkspace &OptiWorkspacePool::workspace(int threadId, int varNum)
+{
+    OptiWorkspace &ws = workspaces_[threadId];
+    ws.resize(varNum, std::min(m_, varNum));
+    return ws;
+}
+
+LbfgsHistory &OptiWorkspacePool::history(int threadId, int patchID, int varNum)
+{
+    int m = std::min(m_, varNum);
+    if (warmStart_ && patchID >= 0 && patchID < static_cast<int>(patchHistory_.size()))
+    {
+        LbfgsHistory &hist = patchHistory_[patchID];
+        if (hist.varNum_ != varNum || hist.m_ != m)
+            hist.reset(varNum, m);
+        return hist;
+    }
+
+    LbfgsHistory &hist = threadHistory_[threadId];
+    if (hist.varNum_ != varNum || hist.m_ != m)
+        hist.reset(varNum, m);
+    else
+        hist.clear();
+    return hist;
+}
+
+void OptiWorkspacePool::clearHistory()
+{
+    for (auto &hist : patchHistory_)
+        hist.clear();
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComOptiWorkspace.h
+// 摘    要：局部优化工作空间池，按线程复用梯度、方向与 L-BFGS 历史向量
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMOPTIWORKSPACE_H_
+#define EMMPMESH_COMMON_COMOPTIWORKSPACE_H_
+
+#include "ComConstants.h"
+
+#include <vector>
+
+// 单次局部优化（顶点 / 单元 / patch）所需的工作向量，容量只增不减
+struct OptiWorkspace
+{
+    std::vector<double> x_;      // 当前变量 X(k)
+    std::vector<double> xPrev_;  // 上一步变量 X(k-1)
+    std::vector<double> xTrial_; // 线搜索试探点
+    std::vector<double> g_;      // 当前梯度 ∇F(k)
+    std::vector<double> gPrev_;  // 上一步梯度 ∇F(k-1)
+    std::vector<double> d_;      // 搜索方向
+    std::vector<double> alpha_;  // L-BFGS 双循环递推系数，长度为 m
+    int varNum_ = 0;             // 当前使用的变量个数
+
+    /************************************************************************
+    * 功能描述：按变量个数与历史个数调整工作向量，只在容量不足时重新分配
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void resize(int varNum, int m);
+};
+
+// L-BFGS 曲率对 (s, y) 的环形缓冲
+struct LbfgsHistory
+{
+    std::vector<double> s_;   // m 组 s = X(k+1)-X(k)，按行存储
+    std::vector<double> y_;   // m 组 y = ∇F(k+1)-∇F(k)，按行存储
+    std::vector<double> rho_; // 1 / (y·s)
+    int varNum_ = 0;          // 变量个数
+    int m_ = 0;               // 最大存储个数
+    int head_ = 0;            // 下一次写入位置
+    int size_ = 0;            // 当前有效个数
+
+    /************************************************************************
+    * 功能描述：按变量个数与历史个数重置缓冲区，清空已有曲率对
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void reset(int varNum, int m);
+
+    /************************************************************************
+    * 功能描述：清空已有曲率对，不释放内存
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void clear()
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    /************************************************************************
+    * 功能描述：加入一组曲率对，y·s <= eps*||y||^2 时视为不满足曲率条件而丢弃
+    * 返回值：bool - 是否成功加入
+    * 作者：邓龙威
+    /************************************************************************/
+    bool push(const double *s, const double *y, double eps);
+
+    /************************************************************************
+    * 功能描述：L-BFGS 双循环递推，计算 d = -H·g；无历史时退化为 d = -g
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void twoLoop(const double *g, double *d, double *alpha) const;
+};
+
+// 按线程划分的局部优化工作空间池
+class OptiWorkspacePool
+{
+public:
+    OptiWorkspacePool() = default;
+
+    /************************************************************************
+    * 功能描述：按线程数与最大空腔变量个数一次性分配所有工作空间
+    *           warmStart 为 true 时，为每个 patch 保留 L-BFGS 历史，使得
+    *           ConsecuIterNum_ 次连续迭代之间曲率对不被丢弃
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void init(int threadNum, int maxVarNum, const QuasiNewtonOptions &qnOpts, int patchNum = 0);
+
+    /************************************************************************
+    * 功能描述：获取线程 threadId 的工作空间，并调整到 varNum 个变量
+    * 返回值：OptiWorkspace& - 工作空间引用
+    * 作者：邓龙威
+    /************************************************************************/
+    OptiWorkspace &workspace(int threadId, int varNum);
+
+    /************************************************************************
+    * 功能描述：获取 L-BFGS 历史。开启 warmStart 且 patchID 在 init 给定的 patchNum 范围内时，
+    *           返回 patchID 对应的持久历史（变量个数变化时自动重置）；否则返回线程私有且已清空的历史。
+    *           持久历史只在 init 中分配，本函数不改变容器大小，可由多个线程并发调用
+    * 返回值：LbfgsHistory& - 历史引用
+    * 作者：邓龙威
+    /************************************************************************/
+    LbfgsHistory &history(int threadId, int patchID, int varNum);
+
+    /************************************************************************
+    * 功能描述：清空所有持久 L-BFGS 历史（网格拓扑变化后调用）
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void clearHistory();
+
+    int threadNum() const { return static_cast<int>(workspaces_.size()); }
+    int maxVarNum() const { return maxVarNum_; }
+    bool warmStart() const { return warmStart_; }
+
+private:
+    std::vector<OptiWorkspace> workspaces_;    // 每个线程一个工作空间
+    std::vector<LbfgsHistory> threadHistory_;  // 每个线程一个临时历史
+    std::vector<LbfgsHistory> patchHistory_;   // 每个 patch 一个持久历史（warmStart_ 时使用）
+    int maxVarNum_ = 0;                        // 最大空腔变量个数
+    int m_ = 0;                                // L-BFGS 历史个数
+    bool warmStart_ = false;                   // 是否保留 L-BFGS 历史
+};
+
+#endif // EMMPMESH_COMMON_COMOPTIWORKSPACE_H_
@@ -16,8 +16,30 @@ ComOptionsManager::~ComOptionsManager()
 
 void ComOptionsManager::setQualityLevel(MeshQualityLevel level)
 {
-    currentLevel_ = level;
     resetToDefaults();
+    applyQualityLevel(level);
+}
+
+void ComOptionsManager::applyQualityLevel(MeshQualityLevel level)
+{
+    currentLevel_ = level;
+
+    // 各级别涉及的选项恢复为默认值（即 Balanced），其余选项保持不变
+    const MeshOptiOptions moDefault{};
+    const MeshOptiAlgorithmOptions moaDefault{};
+    gradientDescentOptions_.maxIter_ = GradientDescentOptions{}.maxIter_;
+    conjugateGradientOptions_.maxIter_ = ConjugateGradientOptions{}.maxIter_;
+    quasiNewtonOptions_.maxIter_ = QuasiNewtonOptions{}.maxIter_;
+    meshOptiOptions_.ConsecuIterNum_ = moDefault.ConsecuIterNum_;
+    meshOptiOptions_.badRegionQuality_ = moDefault.badRegionQuality_;
+    meshOptiOptions_.smoothType_ = moDefault.smoothType_;
+    meshOptiOptions_.smoothWay_ = moDefault.smoothWay_;
+    meshOptiOptions_.meshLegality_ = moDefault.meshLegality_;
+    meshOptiOptions_.useLogBarrier_ = moDefault.useLogBarrier_;
+    meshOptiAlgorithmOptions_.useGD_ = moaDefault.useGD_;
+    meshOptiAlgorithmOptions_.useCG_ = moaDefault.useCG_;
+    meshOptiAlgorithmOptions_.useQN_ = moaDefault.useQN_;
+    meshOptiAlgorithmOptions_.adaptiveSwitch_ = moaDefault.adaptiveSwitch_;
 
     switch (level)
     {
@@ -66,6 +88,7 @@ void ComOptionsManager::setQualityLevel(MeshQualityLevel level)
             meshOptiAlgorithmOptions_.useGD_ = true;
             meshOptiAlgorithmOptions_.useCG_ = true;
             meshOptiAlgorithmOptions_.useQN_ = false;
+            meshOptiAlgorithmOptions_.adaptiveSwitch_ = true;
             break;
         }
     case MeshQualityLevel::VeryHighQuality:
@@ -83,6 +106,7 @@ void ComOptionsManager::setQualityLevel(MeshQualityLevel level)
             meshOptiAlgorithmOptions_.useGD_ = true;
             meshOptiAlgorithmOptions_.useCG_ = true;
             meshOptiAlgorithmOptions_.useQN_ = true;
+            meshOptiAlgorithmOptions_.adaptiveSwitch_ = true;
             break;
         }
     }
@@ -217,6 +241,37 @@ int ComOptionsManager::loadFromFile(const std::string &filePath)
                 quasiNewtonOptions_.varNum_ = std::stoi(value);
             else if (key == "m")
                 quasiNewtonOptions_.m_ = std::stoi(value);
+            else if (key == "warmStart")
+                quasiNewtonOptions_.warmStart_ = stringToBool(value);
+        }
+        else if (currentSection == "MinNLCOptions")
+        {
+            if (key == "rho")
+                minNLCOptions_.rho_ = std::stod(value);
+            else if (key == "rhoFactor")
+                minNLCOptions_.rhoFactor_ = std::stod(value);
+            else if (key == "rhoDecrease")
+                minNLCOptions_.rhoDecrease_ = std::stod(value);
+            else if (key == "rhoMax")
+                minNLCOptions_.rhoMax_ = std::stod(value);
+            else if (key == "feasTol")
+                minNLCOptions_.feasTol_ = std::stod(value);
+            else if (key == "minVolume")
+                minNLCOptions_.minVolume_ = std::stod(value);
+            else if (key == "outerIter")
+                minNLCOptions_.outerIter_ = std::stoi(value);
+            else if (key == "epsG")
+                minNLCOptions_.epsG_ = std::stod(value);
+            else if (key == "epsF")
+                minNLCOptions_.epsF_ = std::stod(value);
+            else if (key == "epsX")
+                minNLCOptions_.epsX_ = std::stod(value);
+            else if (key == "maxIter")
+                minNLCOptions_.maxIter_ = std::stoi(value);
+            else if (key == "varNum")
+                minNLCOptions_.varNum_ = std::stoi(value);
+            else if (key == "m")
+                minNLCOptions_.m_ = std::stoi(value);
         }
         else if (currentSection == "MeshOptiAlgorithmOptions")
         {
@@ -226,6 +281,12 @@ int ComOptionsManager::loadFromFile(const std::string &filePath)
                 meshOptiAlgorithmOptions_.useCG_ = stringToBool(value);
             else if (key == "useQN")
                 meshOptiAlgorithmOptions_.useQN_ = stringToBool(value);
+            else if (key == "adaptiveSwitch")
+                meshOptiAlgorithmOptions_.adaptiveSwitch_ = stringToBool(value);
+            else if (key == "switchRate")
+                meshOptiAlgorithmOptions_.switchRate_ = std::stod(value);
+            else if (key == "switchWindow")
+                meshOptiAlgorithmOptions_.switchWindow_ = std::stoi(value);
         }
         else if (currentSection == "MeshOptiOptions")
         {
@@ -235,18 +296,61 @@ int ComOptionsManager::loadFromFile(const std::string &filePath)
                 meshOptiOptions_.p_ = std::stod(value);
             else if (key == "meshLegality")
                 meshOptiOptions_.meshLegality_ = stringToBool(value);
+            else if (key == "legalityScan")
+                meshOptiOptions_.legalityScan_ = stringToBool(value);
             else if (key == "useLogBarrier")
                 meshOptiOptions_.useLogBarrier_ = stringToBool(value);
             else if (key == "logBarrier")
                 meshOptiOptions_.logBarrier_ = std::stod(value);
+            else if (key == "incrementalObjective")
+                meshOptiOptions_.incrementalObjective_ = stringToBool(value);
+            else if (key == "objectiveRecomputeInterval")
+                meshOptiOptions_.objectiveRecomputeInterval_ = std::stoi(value);
+            else if (key == "autoDiff")
+                meshOptiOptions_.autoDiff_ = stringToBool(value);
             else if (key == "smoothType")
                 meshOptiOptions_.smoothType_ = stringToMeshSmoothType(value);
             else if (key == "smoothWay")
                 meshOptiOptions_.smoothWay_ = stringToMeshSmoothWay(value);
             else if (key == "badRegionQuality")
                 meshOptiOptions_.badRegionQuality_ = std::stod(value);
+            else if (key == "paramSmooth")
+                meshOptiOptions_.paramSmooth_ = stringToBool(value);
             else if (key == "ConsecuIterNum")
                 meshOptiOptions_.ConsecuIterNum_ = std::stoi(value);
+            else if (key == "threadNum")
+                meshOptiOptions_.threadNum_ = std::stoi(value);
+            else if (key == "deterministic")
+                meshOptiOptions_.deterministic_ = stringToBool(value);
+            else if (key == "multilevelNum")
+                meshOptiOptions_.multilevelNum_ = std::stoi(value);
+            else if (key == "multilevelMinVert")
+                meshOptiOptions_.multilevelMinVert_ = std::stoi(value);
+            else if (key == "topoOptiInterval")
+                meshOptiOptions_.topoOptiInterval_ = std::stoi(value);
+            else if (key == "localRemesh")
+                meshOptiOptions_.localRemesh_ = stringToBool(value);
+            else if (key == "remeshGrowLayer")
+                meshOptiOptions_.remeshGrowLayer_ = std::stoi(value);
+            else if (key == "remeshMaxClusterSize")
+                meshOptiOptions_.remeshMaxClusterSize_ = std::stoi(value);
+            else if (key == "telemetry")
+                meshOptiOptions_.telemetry_ = stringToBool(value);
+            else if (key == "telemetrySample")
+                meshOptiOptions_.telemetrySample_ = std::stoi(value);
+            else if (key == "activeSet")
+                meshOptiOptions_.activeSet_ = stringToBool(value);
+        }
+        else if (currentSection == "MeshTopoOptiOptions")
+        {
+            if (key == "useFlip23")
+                meshOptiOptions_.topoOptiOptions_.useFlip23_ = stringToBool(value);
+            else if (key == "useEdgeRemoval")
+                meshOptiOptions_.topoOptiOptions_.useEdgeRemoval_ = stringToBool(value);
+            else if (key == "maxEdgeRing")
+                meshOptiOptions_.topoOptiOptions_.maxEdgeRing_ = std::stoi(value);
+            else if (key == "minImprove")
+                meshOptiOptions_.topoOptiOptions_.minImprove_ = std::stod(value);
         }
         else if (currentSection == "MeshTetViewIOOptions")
         {
@@ -263,6 +367,14 @@ int ComOptionsManager::loadFromFile(const std::string &filePath)
                 meshVTKIOOptions_.xml_ = stringToBool(value);
             else if (key == "binary")
                 meshVTKIOOptions_.binary_ = stringToBool(value);
+            else if (key == "compressor")
+                meshVTKIOOptions_.compressor_ = stringToVTKCompressor(value);
+            else if (key == "compressLevel")
+                meshVTKIOOptions_.compressLevel_ = std::stoi(value);
+            else if (key == "blockSize")
+                meshVTKIOOptions_.blockSize_ = std::stoi(value);
+            else if (key == "threadNum")
+                meshVTKIOOptions_.threadNum_ = std::stoi(value);
         }
         else if (currentSection == "MeshOBJIOOptions")
         {
@@ -396,6 +508,29 @@ int ComOptionsManager::loadFromFile(const std::string &filePath)
                 meshGenerationOptions_.adaptiveMeshOptions_.selfAdaption_ = std::stoi(value);
             else if (key == "highCurvatureSampling")
                 meshGenerationOptions_.adaptiveMeshOptions_.highCurvatureSampling_ = std::stod(value);
+            else if (key == "octreeMaxDepth")
+                meshGenerationOptions_.adaptiveMeshOptions_.octreeMaxDepth_ = std::stoi(value);
+            else if (key == "sizingThreadNum")
+                meshGenerationOptions_.adaptiveMeshOptions_.sizingThreadNum_ = std::stoi(value);
+            else if (key == "sizingCacheFile")
+                meshGenerationOptions_.adaptiveMeshOptions_.sizingCacheFile_ = value;
+        }
+        else if (currentSection == "EdgeMeshGenerationOptions")
+        {
+            if (key == "tableSegmentNum")
+                meshGenerationOptions_.edgeMeshGenerationOptions_.tableSegmentNum_ = std::stoi(value);
+            else if (key == "maxTableSegmentNum")
+                meshGenerationOptions_.edgeMeshGenerationOptions_.maxTableSegmentNum_ = std::stoi(value);
+            else if (key == "tableTolerance")
+                meshGenerationOptions_.edgeMeshGenerationOptions_.tableTolerance_ = std::stod(value);
+            else if (key == "tableMaxTurnAngle")
+                meshGenerationOptions_.edgeMeshGenerationOptions_.tableMaxTurnAngle_ = std::stod(value);
+            else if (key == "curvatureSizing")
+                meshGenerationOptions_.edgeMeshGenerationOptions_.curvatureSizing_ = stringToBool(value);
+            else if (key == "minSegmentNum")
+                meshGenerationOptions_.edgeMeshGenerationOptions_.minSegmentNum_ = std::stoi(value);
+            else if (key == "threadNum")
+                meshGenerationOptions_.edgeMeshGenerationOptions_.threadNum_ = std::stoi(value);
         }
         else if (currentSection == "SurfMeshGenerationOptions")
         {
@@ -405,11 +540,36 @@ int ComOptionsManager::loadFromFile(const std::string &filePath)
                 meshGenerationOptions_.surfMeshGenerationOptions_.meshOptimization_ = stringToBool(value);
             else if (key == "efficiency")
                 meshGenerationOptions_.surfMeshGenerationOptions_.efficiency_ = stringToBool(value);
+            else if (key == "threadNum")
+                meshGenerationOptions_.surfMeshGenerationOptions_.threadNum_ = std::stoi(value);
+            else if (key == "incremental")
+                meshGenerationOptions_.surfMeshGenerationOptions_.incremental_ = stringToBool(value);
+            else if (key == "meshCacheDir")
+                meshGenerationOptions_.surfMeshGenerationOptions_.meshCacheDir_ = value;
         }
         else if (currentSection == "VolumMeshGenerationOptions")
         {
             if (key == "meshOptimization")
                 meshGenerationOptions_.volumMeshGenerationOptions_.meshOptimization_ = stringToBool(value);
+            else if (key == "threadNum")
+                meshGenerationOptions_.volumMeshGenerationOptions_.threadNum_ = std::stoi(value);
+            else if (key == "partitionNum")
+                meshGenerationOptions_.volumMeshGenerationOptions_.partitionNum_ = std::stoi(value);
+            else if (key == "insertOrder")
+                meshGenerationOptions_.volumMeshGenerationOptions_.insertOrder_ = stringToDelaunayInsertOrder(value);
+            else if (key == "insertSeed")
+                meshGenerationOptions_.volumMeshGenerationOptions_.insertSeed_ = static_cast<unsigned int>(std::stoul(value));
+        }
+        else if (currentSection == "MeshTimeBudgetOptions")
+        {
+            if (key == "timeBudget")
+                meshGenerationOptions_.timeBudgetOptions_.timeBudget_ = std::stod(value);
+            else if (key == "budgetMargin")
+                meshGenerationOptions_.timeBudgetOptions_.budgetMargin_ = std::stod(value);
+            else if (key == "autoDegrade")
+                meshGenerationOptions_.timeBudgetOptions_.autoDegrade_ = stringToBool(value);
+            else if (key == "hardDeadline")
+                meshGenerationOptions_.timeBudgetOptions_.hardDeadline_ = stringToBool(value);
         }
     }
 
@@ -477,6 +637,24 @@ int ComOptionsManager::saveToFile(const std::string &filePath) const
     file << "maxIter = " << quasiNewtonOptions_.maxIter_ << "\n";
     file << "varNum = " << quasiNewtonOptions_.varNum_ << "\n";
     file << "m = " << quasiNewtonOptions_.m_ << "\n";
+    file << "warmStart = " << (quasiNewtonOptions_.warmStart_ ? "true" : "false") << "\n";
+
+    // MinNLCOptions
+    file << "\n\n";
+    file << "=============================== MinNLCOptions ===============================\n";
+    file << "rho = " << minNLCOptions_.rho_ << "\n";
+    file << "rhoFactor = " << minNLCOptions_.rhoFactor_ << "\n";
+    file << "rhoDecrease = " << minNLCOptions_.rhoDecrease_ << "\n";
+    file << "rhoMax = " << minNLCOptions_.rhoMax_ << "\n";
+    file << "feasTol = " << minNLCOptions_.feasTol_ << "\n";
+    file << "minVolume = " << minNLCOptions_.minVolume_ << "\n";
+    file << "outerIter = " << minNLCOptions_.outerIter_ << "\n";
+    file << "epsG = " << minNLCOptions_.epsG_ << "\n";
+    file << "epsF = " << minNLCOptions_.epsF_ << "\n";
+    file << "epsX = " << minNLCOptions_.epsX_ << "\n";
+    file << "maxIter = " << minNLCOptions_.maxIter_ << "\n";
+    file << "varNum = " << minNLCOptions_.varNum_ << "\n";
+    file << "m = " << minNLCOptions_.m_ << "\n";
 
     // MeshOptiAlgorithmOptions
     file << "\n\n";
@@ -484,6 +662,9 @@ int ComOptionsManager::saveToFile(const std::string &filePath) const
     file << "useGD = " << (meshOptiAlgorithmOptions_.useGD_ ? "true" : "false") << "\n";
     file << "useCG = " << (meshOptiAlgorithmOptions_.useCG_ ? "true" : "false") << "\n";
     file << "useQN = " << (meshOptiAlgorithmOptions_.useQN_ ? "true" : "false") << "\n";
+    file << "adaptiveSwitch = " << (meshOptiAlgorithmOptions_.adaptiveSwitch_ ? "true" : "false") << "\n";
+    file << "switchRate = " << meshOptiAlgorithmOptions_.switchRate_ << "\n";
+    file << "switchWindow = " << meshOptiAlgorithmOptions_.switchWindow_ << "\n";
 
     // MeshOptiOptions
     file << "\n\n";
@@ -491,12 +672,36 @@ int ComOptionsManager::saveToFile(const std::string &filePath) const
     file << "calculateWay = " << calculateWayToString(meshOptiOptions_.calculateWay_) << "\n";
     file << "p = " << meshOptiOptions_.p_ << "\n";
     file << "meshLegality = " << (meshOptiOptions_.meshLegality_ ? "true" : "false") << "\n";
+    file << "legalityScan = " << (meshOptiOptions_.legalityScan_ ? "true" : "false") << "\n";
     file << "useLogBarrier = " << (meshOptiOptions_.useLogBarrier_ ? "true" : "false") << "\n";
     file << "logBarrier = " << meshOptiOptions_.logBarrier_ << "\n";
+    file << "incrementalObjective = " << (meshOptiOptions_.incrementalObjective_ ? "true" : "false") << "\n";
+    file << "objectiveRecomputeInterval = " << meshOptiOptions_.objectiveRecomputeInterval_ << "\n";
+    file << "autoDiff = " << (meshOptiOptions_.autoDiff_ ? "true" : "false") << "\n";
     file << "smoothType = " << meshSmoothTypeToString(meshOptiOptions_.smoothType_) << "\n";
     file << "smoothWay = " << meshSmoothWayToString(meshOptiOptions_.smoothWay_) << "\n";
     file << "badRegionQuality = " << meshOptiOptions_.badRegionQuality_ << "\n";
+    file << "paramSmooth = " << (meshOptiOptions_.paramSmooth_ ? "true" : "false") << "\n";
     file << "ConsecuIterNum = " << meshOptiOptions_.ConsecuIterNum_ << "\n";
+    file << "threadNum = " << meshOptiOptions_.threadNum_ << "\n";
+    file << "deterministic = " << (meshOptiOptions_.deterministic_ ? "true" : "false") << "\n";
+    file << "multilevelNum = " << meshOptiOptions_.multilevelNum_ << "\n";
+    file << "multilevelMinVert = " << meshOptiOptions_.multilevelMinVert_ << "\n";
+    file << "topoOptiInterval = " << meshOptiOptions_.topoOptiInterval_ << "\n";
+    file << "localRemesh = " << (meshOptiOptions_.localRemesh_ ? "true" : "false") << "\n";
+    file << "remeshGrowLayer = " << meshOptiOptions_.remeshGrowLayer_ << "\n";
+    file << "remeshMaxClusterSize = " << meshOptiOptions_.remeshMaxClusterSize_ << "\n";
+    file << "telemetry = " << (meshOptiOptions_.telemetry_ ? "true" : "false") << "\n";
+    file << "telemetrySample = " << meshOptiOptions_.telemetrySample_ << "\n";
+    file << "activeSet = " << (meshOptiOptions_.activeSet_ ? "true" : "false") << "\n";
+
+    // MeshTopoOptiOptions
+    file << "\n\n";
+    file << "=============================== MeshTopoOptiOptions ===============================\n";
+    file << "useFlip23 = " << (meshOptiOptions_.topoOptiOptions_.useFlip23_ ? "true" : "false") << "\n";
+    file << "useEdgeRemoval = " << (meshOptiOptions_.topoOptiOptions_.useEdgeRemoval_ ? "true" : "false") << "\n";
+    file << "maxEdgeRing = " << meshOptiOptions_.topoOptiOptions_.maxEdgeRing_ << "\n";
+    file << "minImprove = " << meshOptiOptions_.topoOptiOptions_.minImprove_ << "\n";
 
     // MeshTetViewIOOptions
     file << "\n\n";
@@ -510,6 +715,10 @@ int ComOptionsManager::saveToFile(const std::string &filePath) const
     file << "=============================== MeshVTKIOOptions ===============================\n";
     file << "xml = " << (meshVTKIOOptions_.xml_ ? "true" : "false") << "\n";
     file << "binary = " << (meshVTKIOOptions_.binary_ ? "true" : "false") << "\n";
+    file << "compressor = " << vtkCompressorToString(meshVTKIOOptions_.compressor_) << "\n";
+    file << "compressLevel = " << meshVTKIOOptions_.compressLevel_ << "\n";
+    file << "blockSize = " << meshVTKIOOptions_.blockSize_ << "\n";
+    file << "threadNum = " << meshVTKIOOptions_.threadNum_ << "\n";
 
     // MeshOBJIOOptions
     file << "\n\n";
@@ -599,6 +808,20 @@ int ComOptionsManager::saveToFile(const std::string &filePath) const
     file << "ratioFactor = " << meshGenerationOptions_.adaptiveMeshOptions_.ratioFactor_ << "\n";
     file << "selfAdaption = " << meshGenerationOptions_.adaptiveMeshOptions_.selfAdaption_ << "\n";
     file << "highCurvatureSampling = " << meshGenerationOptions_.adaptiveMeshOptions_.highCurvatureSampling_ << "\n";
+    file << "octreeMaxDepth = " << meshGenerationOptions_.adaptiveMeshOptions_.octreeMaxDepth_ << "\n";
+    file << "sizingThreadNum = " << meshGenerationOptions_.adaptiveMeshOptions_.sizingThreadNum_ << "\n";
+    file << "sizingCacheFile = " << meshGenerationOptions_.adaptiveMeshOptions_.sizingCacheFile_ << "\n";
+
+    // EdgeMeshGenerationOptions
+    file << "\n\n";
+    file << "=============================== EdgeMeshGenerationOptions ===============================\n";
+    file << "tableSegmentNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.tableSegmentNum_ << "\n";
+    file << "maxTableSegmentNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.maxTableSegmentNum_ << "\n";
+    file << "tableTolerance = " << meshGenerationOptions_.edgeMeshGenerationOptions_.tableTolerance_ << "\n";
+    file << "tableMaxTurnAngle = " << meshGenerationOptions_.edgeMeshGenerationOptions_.tableMaxTurnAngle_ << "\n";
+    file << "curvatureSizing = " << (meshGenerationOptions_.edgeMeshGenerationOptions_.curvatureSizing_ ? "true" : "false") << "\n";
+    file << "minSegmentNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.minSegmentNum_ << "\n";
+    file << "threadNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.threadNum_ << "\n";
 
     // SurfMeshGenerationOptions
     file << "\n\n";
@@ -606,11 +829,26 @@ int ComOptionsManager::saveToFile(const std::string &filePath) const
     file << "selfAdaption = " << (meshGenerationOptions_.surfMeshGenerationOptions_.selfAdaption_ ? "true" : "false") << "\n";
     file << "meshOptimization = " << (meshGenerationOptions_.surfMeshGenerationOptions_.meshOptimization_ ? "true" : "false") << "\n";
     file << "efficiency = " << (meshGenerationOptions_.surfMeshGenerationOptions_.efficiency_ ? "true" : "false") << "\n";
+    file << "threadNum = " << meshGenerationOptions_.surfMeshGenerationOptions_.threadNum_ << "\n";
+    file << "incremental = " << (meshGenerationOptions_.surfMeshGenerationOptions_.incremental_ ? "true" : "false") << "\n";
+    file << "meshCacheDir = " << meshGenerationOptions_.surfMeshGenerationOptions_.meshCacheDir_ << "\n";
 
     // VolumMeshGenerationOptions
     file << "\n\n";
     file << "=============================== VolumMeshGenerationOptions ===============================\n";
     file << "meshOptimization = " << (meshGenerationOptions_.volumMeshGenerationOptions_.meshOptimization_ ? "true" : "false") << "\n";
+    file << "threadNum = " << meshGenerationOptions_.volumMeshGenerationOptions_.threadNum_ << "\n";
+    file << "partitionNum = " << meshGenerationOptions_.volumMeshGenerationOptions_.partitionNum_ << "\n";
+    file << "insertOrder = " << delaunayInsertOrderToString(meshGenerationOptions_.volumMeshGenerationOptions_.insertOrder_) << "\n";
+    file << "insertSeed = " << meshGenerationOptions_.volumMeshGenerationOptions_.insertSeed_ << "\n";
+
+    // MeshTimeBudgetOptions
+    file << "\n\n";
+    file << "=============================== MeshTimeBudgetOptions ===============================\n";
+    file << "timeBudget = " << meshGenerationOptions_.timeBudgetOptions_.timeBudget_ << "\n";
+    file << "budgetMargin = " << meshGenerationOptions_.timeBudgetOptions_.budgetMargin_ << "\n";
+    file << "autoDegrade = " << (meshGenerationOptions_.timeBudgetOptions_.autoDegrade_ ? "true" : "false") << "\n";
+    file << "hardDeadline = " << (meshGenerationOptions_.timeBudgetOptions_.hardDeadline_ ? "true" : "false") << "\n";
 
     file.close();
     return 0;
@@ -634,6 +872,7 @@ void ComOptionsManager::printAllOptions() const
     printGradientDescentOptions();
     printConjugateGradientOptions();
     printQuasiNewtonOptions();
+    printMinNLCOptions();
     printMeshOptiAlgorithmOptions();
     printMeshOptiOptions();
     printMeshTetViewIOOptions();
@@ -692,7 +931,26 @@ void ComOptionsManager::printQuasiNewtonOptions() const
     std::cout << "epsX = " << quasiNewtonOptions_.epsX_ << "\n";
     std::cout << "maxIter = " << quasiNewtonOptions_.maxIter_ << "\n";
     std::cout << "varNum = " << quasiNewtonOptions_.varNum_ << "\n";
-    std::cout << "m = " << quasiNewtonOptions_.m_ << "\n\n";
+    std::cout << "m = " << quasiNewtonOptions_.m_ << "\n";
+    std::cout << "warmStart = " << (quasiNewtonOptions_.warmStart_ ? "true" : "false") << "\n\n";
+}
+
+void ComOptionsManager::printMinNLCOptions() const
+{
+    std::cout << "=============================== MinNLCOptions ===============================\n";
+    std::cout << "rho = " << minNLCOptions_.rho_ << "\n";
+    std::cout << "rhoFactor = " << minNLCOptions_.rhoFactor_ << "\n";
+    std::cout << "rhoDecrease = " << minNLCOptions_.rhoDecrease_ << "\n";
+    std::cout << "rhoMax = " << minNLCOptions_.rhoMax_ << "\n";
+    std::cout << "feasTol = " << minNLCOptions_.feasTol_ << "\n";
+    std::cout << "minVolume = " << minNLCOptions_.minVolume_ << "\n";
+    std::cout << "outerIter = " << minNLCOptions_.outerIter_ << "\n";
+    std::cout << "epsG = " << minNLCOptions_.epsG_ << "\n";
+    std::cout << "epsF = " << minNLCOptions_.epsF_ << "\n";
+    std::cout << "epsX = " << minNLCOptions_.epsX_ << "\n";
+    std::cout << "maxIter = " << minNLCOptions_.maxIter_ << "\n";
+    std::cout << "varNum = " << minNLCOptions_.varNum_ << "\n";
+    std::cout << "m = " << minNLCOptions_.m_ << "\n\n";
 }
 
 void ComOptionsManager::printMeshOptiAlgorithmOptions() const
@@ -700,7 +958,10 @@ void ComOptionsManager::printMeshOptiAlgorithmOptions() const
     std::cout << "=============================== MeshOptiAlgorithmOptions ===============================\n";
     std::cout << "useGD = " << (meshOptiAlgorithmOptions_.useGD_ ? "true" : "false") << "\n";
     std::cout << "useCG = " << (meshOptiAlgorithmOptions_.useCG_ ? "true" : "false") << "\n";
-    std::cout << "useQN = " << (meshOptiAlgorithmOptions_.useQN_ ? "true" : "false") << "\n\n";
+    std::cout << "useQN = " << (meshOptiAlgorithmOptions_.useQN_ ? "true" : "false") << "\n";
+    std::cout << "adaptiveSwitch = " << (meshOptiAlgorithmOptions_.adaptiveSwitch_ ? "true" : "false") << "\n";
+    std::cout << "switchRate = " << meshOptiAlgorithmOptions_.switchRate_ << "\n";
+    std::cout << "switchWindow = " << meshOptiAlgorithmOptions_.switchWindow_ << "\n\n";
 }
 
 void ComOptionsManager::printMeshOptiOptions() const
@@ -709,12 +970,34 @@ void ComOptionsManager::printMeshOptiOptions() const
     std::cout << "calculateWay = " << calculateWayToString(meshOptiOptions_.calculateWay_) << "\n";
     std::cout << "p = " << meshOptiOptions_.p_ << "\n";
     std::cout << "meshLegality = " << (meshOptiOptions_.meshLegality_ ? "true" : "false") << "\n";
+    std::cout << "legalityScan = " << (meshOptiOptions_.legalityScan_ ? "true" : "false") << "\n";
     std::cout << "useLogBarrier = " << (meshOptiOptions_.useLogBarrier_ ? "true" : "false") << "\n";
     std::cout << "logBarrier = " << meshOptiOptions_.logBarrier_ << "\n";
+    std::cout << "incrementalObjective = " << (meshOptiOptions_.incrementalObjective_ ? "true" : "false") << "\n";
+    std::cout << "objectiveRecomputeInterval = " << meshOptiOptions_.objectiveRecomputeInterval_ << "\n";
+    std::cout << "autoDiff = " << (meshOptiOptions_.autoDiff_ ? "true" : "false") << "\n";
     std::cout << "smoothType = " << meshSmoothTypeToString(meshOptiOptions_.smoothType_) << "\n";
     std::cout << "smoothWay = " << meshSmoothWayToString(meshOptiOptions_.smoothWay_) << "\n";
     std::cout << "badRegionQuality = " << meshOptiOptions_.badRegionQuality_ << "\n";
-    std::cout << "ConsecuIterNum = " << meshOptiOptions_.ConsecuIterNum_ << "\n\n";
+    std::cout << "paramSmooth = " << (meshOptiOptions_.paramSmooth_ ? "true" : "false") << "\n";
+    std::cout << "ConsecuIterNum = " << meshOptiOptions_.ConsecuIterNum_ << "\n";
+    std::cout << "threadNum = " << meshOptiOptions_.threadNum_ << "\n";
+    std::cout << "deterministic = " << (meshOptiOptions_.deterministic_ ? "true" : "false") << "\n";
+    std::cout << "multilevelNum = " << meshOptiOptions_.multilevelNum_ << "\n";
+    std::cout << "multilevelMinVert = " << meshOptiOptions_.multilevelMinVert_ << "\n";
+    std::cout << "topoOptiInterval = " << meshOptiOptions_.topoOptiInterval_ << "\n";
+    std::cout << "localRemesh = " << (meshOptiOptions_.localRemesh_ ? "true" : "false") << "\n";
+    std::cout << "remeshGrowLayer = " << meshOptiOptions_.remeshGrowLayer_ << "\n";
+    std::cout << "remeshMaxClusterSize = " << meshOptiOptions_.remeshMaxClusterSize_ << "\n";
+    std::cout << "telemetry = " << (meshOptiOptions_.telemetry_ ? "true" : "false") << "\n";
+    std::cout << "telemetrySample = " << meshOptiOptions_.telemetrySample_ << "\n";
+    std::cout << "activeSet = " << (meshOptiOptions_.activeSet_ ? "true" : "false") << "\n";
+
+    std::cout << "\n--- MeshTopoOptiOptions ---\n";
+    std::cout << "useFlip23 = " << (meshOptiOptions_.topoOptiOptions_.useFlip23_ ? "true" : "false") << "\n";
+    std::cout << "useEdgeRemoval = " << (meshOptiOptions_.topoOptiOptions_.useEdgeRemoval_ ? "true" : "false") << "\n";
+    std::cout << "maxEdgeRing = " << meshOptiOptions_.topoOptiOptions_.maxEdgeRing_ << "\n";
+    std::cout << "minImprove = " << meshOptiOptions_.topoOptiOptions_.minImprove_ << "\n\n";
 }
 
 void ComOptionsManager::printMeshTetViewIOOptions() const
@@ -729,7 +1012,11 @@ void ComOptionsManager::printMeshVTKIOOptions() const
 {
     std::cout << "=============================== MeshVTKIOOptions ===============================\n";
     std::cout << "xml = " << (meshVTKIOOptions_.xml_ ? "true" : "false") << "\n";
-    std::cout << "binary = " << (meshVTKIOOptions_.binary_ ? "true" : "false") << "\n\n";
+    std::cout << "binary = " << (meshVTKIOOptions_.binary_ ? "true" : "false") << "\n";
+    std::cout << "compressor = " << vtkCompressorToString(meshVTKIOOptions_.compressor_) << "\n";
+    std::cout << "compressLevel = " << meshVTKIOOptions_.compressLevel_ << "\n";
+    std::cout << "blockSize = " << meshVTKIOOptions_.blockSize_ << "\n";
+    std::cout << "threadNum = " << meshVTKIOOptions_.threadNum_ << "\n\n";
 }
 
 void ComOptionsManager::printMeshOBJIOOptions() const
@@ -829,14 +1116,39 @@ void ComOptionsManager::printMeshGenerationOptions() const
     std::cout << "ratioFactor = " << meshGenerationOptions_.adaptiveMeshOptions_.ratioFactor_ << "\n";
     std::cout << "selfAdaption = " << meshGenerationOptions_.adaptiveMeshOptions_.selfAdaption_ << "\n";
     std::cout << "highCurvatureSampling = " << meshGenerationOptions_.adaptiveMeshOptions_.highCurvatureSampling_ << "\n";
+    std::cout << "octreeMaxDepth = " << meshGenerationOptions_.adaptiveMeshOptions_.octreeMaxDepth_ << "\n";
+    std::cout << "sizingThreadNum = " << meshGenerationOptions_.adaptiveMeshOptions_.sizingThreadNum_ << "\n";
+    std::cout << "sizingCacheFile = " << meshGenerationOptions_.adaptiveMeshOptions_.sizingCacheFile_ << "\n";
+
+    std::cout << "\n--- EdgeMeshGenerationOptions ---\n";
+    std::cout << "tableSegmentNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.tableSegmentNum_ << "\n";
+    std::cout << "maxTableSegmentNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.maxTableSegmentNum_ << "\n";
+    std::cout << "tableTolerance = " << meshGenerationOptions_.edgeMeshGenerationOptions_.tableTolerance_ << "\n";
+    std::cout << "tableMaxTurnAngle = " << meshGenerationOptions_.edgeMeshGenerationOptions_.tableMaxTurnAngle_ << "\n";
+    std::cout << "curvatureSizing = " << (meshGenerationOptions_.edgeMeshGenerationOptions_.curvatureSizing_ ? "true" : "false") << "\n";
+    std::cout << "minSegmentNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.minSegmentNum_ << "\n";
+    std::cout << "threadNum = " << meshGenerationOptions_.edgeMeshGenerationOptions_.threadNum_ << "\n";
 
     std::cout << "\n--- SurfMeshGenerationOptions ---\n";
     std::cout << "selfAdaption = " << (meshGenerationOptions_.surfMeshGenerationOptions_.selfAdaption_ ? "true" : "false") << "\n";
     std::cout << "meshOptimization = " << (meshGenerationOptions_.surfMeshGenerationOptions_.meshOptimization_ ? "true" : "false") << "\n";
     std::cout << "efficiency = " << (meshGenerationOptions_.surfMeshGenerationOptions_.efficiency_ ? "true" : "false") << "\n";
+    std::cout << "threadNum = " << meshGenerationOptions_.surfMeshGenerationOptions_.threadNum_ << "\n";
+    std::cout << "incremental = " << (meshGenerationOptions_.surfMeshGenerationOptions_.incremental_ ? "true" : "false") << "\n";
+    std::cout << "meshCacheDir = " << meshGenerationOptions_.surfMeshGenerationOptions_.meshCacheDir_ << "\n";
 
     std::cout << "\n--- VolumMeshGenerationOptions ---\n";
-    std::cout << "meshOptimization = " << (meshGenerationOptions_.volumMeshGenerationOptions_.meshOptimization_ ? "true" : "false") << "\n\n";
+    std::cout << "meshOptimization = " << (meshGenerationOptions_.volumMeshGenerationOptions_.meshOptimization_ ? "true" : "false") << "\n";
+    std::cout << "threadNum = " << meshGenerationOptions_.volumMeshGenerationOptions_.threadNum_ << "\n";
+    std::cout << "partitionNum = " << meshGenerationOptions_.volumMeshGenerationOptions_.partitionNum_ << "\n";
+    std::cout << "insertOrder = " << delaunayInsertOrderToString(meshGenerationOptions_.volumMeshGenerationOptions_.insertOrder_) << "\n";
+    std::cout << "insertSeed = " << meshGenerationOptions_.volumMeshGenerationOptions_.insertSeed_ << "\n";
+
+    std::cout << "\n--- MeshTimeBudgetOptions ---\n";
+    std::cout << "timeBudget = " << meshGenerationOptions_.timeBudgetOptions_.timeBudget_ << "\n";
+    std::cout << "budgetMargin = " << meshGenerationOptions_.timeBudgetOptions_.budgetMargin_ << "\n";
+    std::cout << "autoDegrade = " << (meshGenerationOptions_.timeBudgetOptions_.autoDegrade_ ? "true" : "false") << "\n";
+    std::cout << "hardDeadline = " << (meshGenerationOptions_.timeBudgetOptions_.hardDeadline_ ? "true" : "false") << "\n\n";
 }
 
 void ComOptionsManager::resetToDefaults()
@@ -845,6 +1157,7 @@ void ComOptionsManager::resetToDefaults()
     gradientDescentOptions_ = GradientDescentOptions{};
     conjugateGradientOptions_ = ConjugateGradientOptions{};
     quasiNewtonOptions_ = QuasiNewtonOptions{};
+    minNLCOptions_ = MinNLCOptions{};
     meshOptiAlgorithmOptions_ = MeshOptiAlgorithmOptions{};
     meshOptiOptions_ = MeshOptiOptions{};
     meshTetViewIOOptions_ = MeshTetViewIOOptions{};
@@ -1354,3 +1667,59 @@ ModelFileFormat ComOptionsManager::stringToModelFileFormat(const std::string &st
         return ModelFileFormat::STEP;
     return ModelFileFormat::SAT;
 }
+
+std::string ComOptionsManager::delaunayInsertOrderToString(DelaunayInsertOrder order) const
+{
+    switch (order)
+    {
+    case DelaunayInsertOrder::INPUT:
+        return "INPUT";
+    case DelaunayInsertOrder::RANDOM:
+        return "RANDOM";
+    case DelaunayInsertOrder::HILBERT:
+        return "HILBERT";
+    case DelaunayInsertOrder::BRIO:
+        return "BRIO";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+DelaunayInsertOrder ComOptionsManager::stringToDelaunayInsertOrder(const std::string &str) const
+{
+    if (str == "INPUT")
+        return DelaunayInsertOrder::INPUT;
+    if (str == "RANDOM")
+        return DelaunayInsertOrder::RANDOM;
+    if (str == "HILBERT")
+        return DelaunayInsertOrder::HILBERT;
+    if (str == "BRIO")
+        return DelaunayInsertOrder::BRIO;
+    return DelaunayInsertOrder::BRIO;
+}
+
+std::string ComOptionsManager::vtkCompressorToString(VTKCompressor compressor) const
+{
+    switch (compressor)
+    {
+    case VTKCompressor::NONE:
+        return "NONE";
+    case VTKCompressor::ZLIB:
+        return "ZLIB";
+    case VTKCompressor::LZ4:
+        return "LZ4";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+VTKCompressor ComOptionsManager::stringToVTKCompressor(const std::string &str) const
+{
+    if (str == "NONE")
+        return VTKCompressor::NONE;
+    if (str == "ZLIB")
+        return VTKCompressor::ZLIB;
+    if (str == "LZ4")
+        return VTKCompressor::LZ4;
+    return VTKCompressor::NONE;
+}
@@ -64,7 +64,17 @@ public:
     void setQualityLevel(MeshQualityLevel level);
 
     /************************************************************************
-    * 功能描述：获取当前的质量级别（如果是自定义设置则返回 Balanced）
+    * 功能描述：只切换质量级别涉及的选项（迭代次数、光滑化方法与方式、算法开关等），
+    *           先将这些选项恢复为默认值再按 level 设置，其余选项保持不变。
+    *           用于生成过程中按时间预算降级（ComTimeBudget.h），应在两个生成阶段之间调用
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void applyQualityLevel(MeshQualityLevel level);
+
+    /************************************************************************
+    * 功能描述：获取实际应用的质量级别，即 setQualityLevel / applyQualityLevel 最后一次
+    *           设置的级别（按时间预算降级后为降级后的级别；如果是自定义设置则返回 Balanced）
     * 返回值：MeshQualityLevel
     * 作者：邓龙威
     /************************************************************************/
@@ -107,6 +117,13 @@ public:
     /************************************************************************/
     void setQuasiNewtonOptions(const QuasiNewtonOptions &qnOpts) { quasiNewtonOptions_ = qnOpts; }
 
+    /************************************************************************
+    * 功能描述：设置带约束优化选项
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setMinNLCOptions(const MinNLCOptions &nlcOpts) { minNLCOptions_ = nlcOpts; }
+
     /************************************************************************
     * 功能描述：设置网格优化算法选项
     * 返回值：无
@@ -228,6 +245,13 @@ public:
     /************************************************************************/
     const QuasiNewtonOptions &getQuasiNewtonOptions() const { return quasiNewtonOptions_; }
 
+    /************************************************************************
+    * 功能描述：获取带约束优化选项
+    * 返回值：const MinNLCOptions& - 带约束优化选项的常量引用
+    * 作者：邓龙威
+    /************************************************************************/
+    const MinNLCOptions &getMinNLCOptions() const { return minNLCOptions_; }
+
     /************************************************************************
     * 功能描述：获取网格优化算法选项
     * 返回值：const MeshOptiAlgorithmOptions& - 网格优化算法选项的常量引用
@@ -372,6 +396,13 @@ public:
     /************************************************************************/
     void printQuasiNewtonOptions() const;
 
+    /************************************************************************
+    * 功能描述：打印带约束优化选项
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void printMinNLCOptions() const;
+
     /************************************************************************
     * 功能描述：打印网格优化算法选项
     * 返回值：无
@@ -489,6 +520,8 @@ private:
     std::string logFileFormatToString(LogFileFormat format) const;
     std::string logFileLanguageToString(LogFileLanguage lang) const;
     std::string modelFileFormatToString(ModelFileFormat format) const;
+    std::string delaunayInsertOrderToString(DelaunayInsertOrder order) const;
+    std::string vtkCompressorToString(VTKCompressor compressor) const;
 
     /************************************************************************
     * 功能描述：将字符串转换为枚举
@@ -506,6 +539,8 @@ private:
     LogFileFormat stringToLogFileFormat(const std::string &str) const;
     LogFileLanguage stringToLogFileLanguage(const std::string &str) const;
     ModelFileFormat stringToModelFileFormat(const std::string &str) const;
+    DelaunayInsertOrder stringToDelaunayInsertOrder(const std::string &str) const;
+    VTKCompressor stringToVTKCompressor(const std::string &str) const;
 
     /************************************************************************
     * 功能描述：字符串处理辅助函数
@@ -521,6 +556,7 @@ private:
     GradientDescentOptions gradientDescentOptions_;
     ConjugateGradientOptions conjugateGradientOptions_;
     QuasiNewtonOptions quasiNewtonOptions_;
+    MinNLCOptions minNLCOptions_;
     MeshOptiAlgorithmOptions meshOptiAlgorithmOptions_;
     MeshOptiOptions meshOptiOptions_;
     MeshTetViewIOOptions meshTetViewIOOptions_;
@@ -0,0 +1,317 @@
+#include "pch.h"
+
+#include "ComOptionsTuner.h"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+// a 是否支配 b：耗时不多于且质量不低于，且至少一项严格更优
+static bool ComTunerDominates(const TunerResult &a, const TunerResult &b)
+{
+    return a.seconds_ <= b.seconds_ && a.quality_ >= b.quality_ &&
+           (a.seconds_ < b.seconds_ || a.quality_ > b.quality_);
+}
+
+// 非支配排序层级，0 为 Pareto 前沿
+static std::vector<int> ComTunerParetoRank(const std::vector<TunerResult> &rs)
+{
+    int n = static_cast<int>(rs.size());
+    std::vector<int> rank(n, -1);
+    int assigned = 0;
+    for (int level = 0; assigned < n; ++level)
+    {
+        std::vector<int> current;
+        for (int i = 0; i < n; ++i)
+        {
+            if (rank[i] >= 0)
+                continue;
+            bool dominated = false;
+            for (int j = 0; j < n && !dominated; ++j)
+                dominated = j != i && rank[j] < 0 && ComTunerDominates(rs[j], rs[i]);
+            if (!dominated)
+                current.push_back(i);
+        }
+        for (int i : current)
+            rank[i] = level;
+        assigned += static_cast<int>(current.size());
+    }
+    return rank;
+}
+
+static std::string ComTunerSmoothType(MeshSmoothType type)
+{
+    switch (type)
+    {
+    case MeshSmoothType::CONJUGATE_GRADIENT:
+        return "CONJUGATE_GRADIENT";
+    case MeshSmoothType::LBFGS:
+        return "LBFGS";
+    case MeshSmoothType::MinNLC:
+        return "MinNLC";
+    case MeshSmoothType::GD:
+        return "GD";
+    case MeshSmoothType::CG:
+        return "CG";
+    case MeshSmoothType::QN:
+        return "QN";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+static std::string ComTunerSmoothWay(MeshSmoothWay way)
+{
+    switch (way)
+    {
+    case MeshSmoothWay::SIGLE_VERT:
+        return "SIGLE_VERT";
+    case MeshSmoothWay::SIGLE_REGION:
+        return "SIGLE_REGION";
+    case MeshSmoothWay::PATCH_REGION:
+        return "PATCH_REGION";
+    case MeshSmoothWay::ALL_REGION:
+        return "ALL_REGION";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+static auto ComTunerKey(const TunerConfig &c)
+{
+    return std::make_tuple(c.maxIter_, c.m_, c.cgType_, static_cast<int>(c.smoothType_),
+                           static_cast<int>(c.smoothWay_), c.p_, c.ConsecuIterNum_);
+}
+
+TunerConfig OptionsTuner::capture(const ComOptionsManager &manager)
+{
+    TunerConfig config;
+    const MeshOptiOptions &mo = manager.getMeshOptiOptions();
+    config.smoothType_ = mo.smoothType_;
+    config.smoothWay_ = mo.smoothWay_;
+    config.p_ = mo.p_;
+    config.ConsecuIterNum_ = mo.ConsecuIterNum_;
+    config.m_ = manager.getQuasiNewtonOptions().m_;
+    config.cgType_ = manager.getConjugateGradientOptions().cgType_;
+
+    // maxIter_ 取当前光滑化方法对应的算法
+    switch (mo.smoothType_)
+    {
+    case MeshSmoothType::GD:
+        config.maxIter_ = manager.getGradientDescentOptions().maxIter_;
+        break;
+    case MeshSmoothType::LBFGS:
+    case MeshSmoothType::QN:
+        config.maxIter_ = manager.getQuasiNewtonOptions().maxIter_;
+        break;
+    default:
+        config.maxIter_ = manager.getConjugateGradientOptions().maxIter_;
+        break;
+    }
+    return config;
+}
+
+void OptionsTuner::apply(const TunerConfig &config, ComOptionsManager &manager)
+{
+    GradientDescentOptions gd = manager.getGradientDescentOptions();
+    ConjugateGradientOptions cg = manager.getConjugateGradientOptions();
+    QuasiNewtonOptions qn = manager.getQuasiNewtonOptions();
+    gd.maxIter_ = config.maxIter_;
+    cg.maxIter_ = config.maxIter_;
+    cg.cgType_ = config.cgType_;
+    qn.maxIter_ = config.maxIter_;
+    qn.m_ = config.m_;
+    manager.setGradientDescentOptions(gd);
+    manager.setConjugateGradientOptions(cg);
+    manager.setQuasiNewtonOptions(qn);
+
+    MeshOptiAlgorithmOptions moa = manager.getMeshOptiAlgorithmOptions();
+    moa.gdOptions_.maxIter_ = config.maxIter_;
+    moa.cgOptions_.maxIter_ = config.maxIter_;
+    moa.cgOptions_.cgType_ = config.cgType_;
+    moa.qnOptions_.maxIter_ = config.maxIter_;
+    moa.qnOptions_.m_ = config.m_;
+    manager.setMeshOptiAlgorithmOptions(moa);
+
+    MeshOptiOptions mo = manager.getMeshOptiOptions();
+    mo.smoothType_ = config.smoothType_;
+    mo.smoothWay_ = config.smoothWay_;
+    mo.p_ = config.p_;
+    mo.ConsecuIterNum_ = config.ConsecuIterNum_;
+    mo.meshOptiAlgorithmOptions_.gdOptions_.maxIter_ = config.maxIter_;
+    mo.meshOptiAlgorithmOptions_.cgOptions_.maxIter_ = config.maxIter_;
+    mo.meshOptiAlgorithmOptions_.cgOptions_.cgType_ = config.cgType_;
+    mo.meshOptiAlgorithmOptions_.qnOptions_.maxIter_ = config.maxIter_;
+    mo.meshOptiAlgorithmOptions_.qnOptions_.m_ = config.m_;
+    manager.setMeshOptiOptions(mo);
+}
+
+int OptionsTuner::run(ComOptionsManager &manager, const ComTunerRun &runFunc)
+{
+    results_.clear();
+    finalRung_ = -1;
+    int eta = std::max(2, opts_.eta_);
+    int candidateNum = std::max(1, opts_.candidateNum_);
+
+    // 候选：当前配置 + 随机采样（去重）
+    std::vector<TunerConfig> candidates = {capture(manager)};
+    std::set<decltype(ComTunerKey(candidates[0]))> seen = {ComTunerKey(candidates[0])};
+    std::mt19937 rng(opts_.seed_);
+    auto pick = [&](const auto &values, auto fallback) {
+        if (values.empty())
+            return fallback;
+        return values[std::uniform_int_distribution<size_t>(0, values.size() - 1)(rng)];
+    };
+    for (int attempt = 0; static_cast<int>(candidates.size()) < candidateNum && attempt < 100 * candidateNum; ++attempt)
+    {
+        const TunerConfig &base = candidates[0];
+        TunerConfig c;
+        c.maxIter_ = pick(space_.maxIter_, base.maxIter_);
+        c.m_ = pick(space_.m_, base.m_);
+        c.cgType_ = pick(space_.cgType_, base.cgType_);
+        c.smoothType_ = pick(space_.smoothType_, base.smoothType_);
+        c.smoothWay_ = pick(space_.smoothWay_, base.smoothWay_);
+        c.p_ = pick(space_.p_, base.p_);
+        c.ConsecuIterNum_ = pick(space_.ConsecuIterNum_, base.ConsecuIterNum_);
+        if (seen.insert(ComTunerKey(c)).second)
+            candidates.push_back(c);
+    }
+
+    // 轮数：使最后一轮至少剩 1 个候选，资源比例依次为 eta^-(R-1), ..., 1
+    int rungNum = 1;
+    for (int n = static_cast<int>(candidates.size()); n >= eta; n /= eta)
+        ++rungNum;
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+    std::vector<int> alive(candidates.size());
+    for (size_t i = 0; i < alive.size(); ++i)
+        alive[i] = static_cast<int>(i);
+
+    for (int rung = 0; rung < rungNum && !alive.empty(); ++rung)
+    {
+        double fraction = std::pow(static_cast<double>(eta), rung - (rungNum - 1));
+        std::vector<TunerResult> rungResults;
+        bool exhausted = false;
+        for (int c : alive)
+        {
+            if (opts_.timeBudget_ > 0. && elapsed() >= opts_.timeBudget_)
+            {
+                exhausted = true;
+                break;
+            }
+            TunerResult r;
+            r.candidate_ = c;
+            r.rung_ = rung;
+            r.fraction_ = fraction;
+            r.config_ = candidates[c];
+            apply(candidates[c], manager);
+            r.valid_ = runFunc(manager, fraction, r.seconds_, r.quality_);
+            results_.push_back(r);
+            if (r.valid_)
+                rungResults.push_back(r);
+        }
+        // 预算在轮中耗尽时该轮只评测了部分候选，不作为最终轮；第 0 轮未完成时以其部分结果为准
+        if (!rungResults.empty() && (!exhausted || finalRung_ < 0))
+            finalRung_ = rung;
+        if (exhausted || rung == rungNum - 1)
+            break;
+
+        // 按（Pareto 层级，质量降序，耗时升序）保留前 1/eta
+        std::vector<int> rank = ComTunerParetoRank(rungResults);
+        std::vector<int> order(rungResults.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = static_cast<int>(i);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return std::make_tuple(rank[a], -rungResults[a].quality_, rungResults[a].seconds_) <
+                   std::make_tuple(rank[b], -rungResults[b].quality_, rungResults[b].seconds_);
+        });
+        int keep = std::max(1, static_cast<int>(std::ceil(static_cast<double>(alive.size()) / eta)));
+        keep = std::min(keep, static_cast<int>(order.size()));
+        alive.clear();
+        for (int i = 0; i < keep; ++i)
+            alive.push_back(rungResults[order[i]].candidate_);
+    }
+
+    TunerResult best = winner();
+    apply(best.valid_ ? best.config_ : candidates[0], manager);
+    return static_cast<int>(results_.size());
+}
+
+std::vector<TunerResult> OptionsTuner::paretoFront() const
+{
+    std::vector<TunerResult> last;
+    for (const auto &r : results_)
+    {
+        if (r.valid_ && r.rung_ == finalRung_)
+            last.push_back(r);
+    }
+    std::vector<int> rank = ComTunerParetoRank(last);
+    std::vector<TunerResult> front;
+    for (size_t i = 0; i < last.size(); ++i)
+    {
+        if (rank[i] == 0)
+            front.push_back(last[i]);
+    }
+    std::sort(front.begin(), front.end(), [](const TunerResult &a, const TunerResult &b) {
+        return a.seconds_ < b.seconds_;
+    });
+    return front;
+}
+
+TunerResult OptionsTuner::winner() const
+{
+    std::vector<TunerResult> front = paretoFront();
+    if (front.empty())
+        return TunerResult();
+
+    // 前沿按耗时升序、质量随之升序：取耗时上限内最后一个，均超限时取最快者
+    if (opts_.maxSeconds_ <= 0.)
+        return front.back();
+    TunerResult best = front.front();
+    for (const auto &r : front)
+    {
+        if (r.seconds_ <= opts_.maxSeconds_)
+            best = r;
+    }
+    return best;
+}
+
+int OptionsTuner::saveWinner(ComOptionsManager &manager, const std::string &filePath) const
+{
+    TunerResult best = winner();
+    if (!best.valid_)
+        return -1;
+    apply(best.config_, manager);
+    return manager.saveToFile(filePath);
+}
+
+std::string OptionsTuner::configToString(const TunerConfig &config)
+{
+    std::ostringstream oss;
+    oss << "maxIter=" << config.maxIter_
+        << " m=" << config.m_
+        << " cgType=" << config.cgType_
+        << " smoothType=" << ComTunerSmoothType(config.smoothType_)
+        << " smoothWay=" << ComTunerSmoothWay(config.smoothWay_)
+        << " p=" << config.p_
+        << " ConsecuIterNum=" << config.ConsecuIterNum_;
+    return oss.str();
+}
+
+std::string OptionsTuner::resultToString(const TunerResult &result)
+{
+    std::ostringstream oss;
+    oss << "candidate=" << result.candidate_
+        << " rung=" << result.rung_
+        << " fraction=" << result.fraction_
+        << " seconds=" << result.seconds_
+        << " quality=" << result.quality_
+        << " valid=" << (result.valid_ ? "true" : "false")
+        << " " << configToString(result.config_);
+    return oss.str();
+}
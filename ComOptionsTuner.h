@@ -0,0 +1,129 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComOptionsTuner.h
+// 摘    要：网格优化选项自动调参：在代表性网格上以逐次减半（successive halving）搜索
+//           maxIter_ / m_ / cgType_ / smoothType_ / smoothWay_ / p_ / ConsecuIterNum_，
+//           给出耗时 - 质量的 Pareto 前沿并保存最优配置
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMOPTIONSTUNER_H_
+#define EMMPMESH_COMMON_COMOPTIONSTUNER_H_
+
+#include "ComOptionsManager.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// 一组候选参数
+struct TunerConfig
+{
+    int maxIter_ = 7;                                                // GD / CG / QN 的最大迭代次数
+    int m_ = 5;                                                      // L-BFGS 历史信息个数
+    int cgType_ = 2;                                                 // 共轭梯度法类型
+    MeshSmoothType smoothType_ = MeshSmoothType::CONJUGATE_GRADIENT; // 光滑化方法
+    MeshSmoothWay smoothWay_ = MeshSmoothWay::SIGLE_VERT;            // 光滑化方式
+    double p_ = 2.0;                                                 // p 范数的 p 值
+    int ConsecuIterNum_ = 7;                                         // 连续迭代次数
+};
+
+// 搜索空间，每个参数的候选取值
+struct TunerSpace
+{
+    std::vector<int> maxIter_ = {3, 5, 7, 10, 15};
+    std::vector<int> m_ = {3, 5, 7};
+    std::vector<int> cgType_ = {0, 1, 2};
+    std::vector<MeshSmoothType> smoothType_ = {MeshSmoothType::GD, MeshSmoothType::CONJUGATE_GRADIENT, MeshSmoothType::LBFGS};
+    std::vector<MeshSmoothWay> smoothWay_ = {MeshSmoothWay::SIGLE_VERT, MeshSmoothWay::PATCH_REGION};
+    std::vector<double> p_ = {2., 4., 8.};
+    std::vector<int> ConsecuIterNum_ = {3, 5, 7, 10, 15};
+};
+
+// 调参控制参数
+struct TunerOptions
+{
+    int candidateNum_ = 81;     // 初始候选个数（含管理器当前配置）
+    int eta_ = 3;               // 减半因子：每轮保留 1/eta_ 的候选，资源比例扩大 eta_ 倍
+    double timeBudget_ = 3600.; // 调参总时间预算（秒），耗尽后以已完成的最高一轮结果为准
+    double maxSeconds_ = 0.;    // 最优配置的耗时上限（秒），0 表示不限制，只取质量最高者
+    unsigned int seed_ = 0;     // 随机采样种子
+};
+
+// 单次评测结果
+struct TunerResult
+{
+    int candidate_ = -1;    // 候选编号
+    int rung_ = 0;          // 所在轮次
+    double fraction_ = 1.;  // 资源比例
+    TunerConfig config_;    // 参数
+    double seconds_ = 0.;   // 优化耗时（秒）
+    double quality_ = 0.;   // 最终网格质量（越大越好，如最差单元质量）
+    bool valid_ = false;    // 评测是否成功
+};
+
+// 评测回调：以 manager 中的选项在代表性网格上运行优化。fraction 为资源比例（0, 1]，
+// 由调用方决定其含义（如只优化该比例的 patch）；写入耗时与最终质量，失败返回 false
+using ComTunerRun = std::function<bool(const ComOptionsManager &manager, double fraction, double &seconds, double &quality)>;
+
+// 优化选项调参器
+class OptionsTuner
+{
+public:
+    OptionsTuner(const TunerSpace &space, const TunerOptions &opts) : space_(space), opts_(opts) {}
+
+    /************************************************************************
+    * 功能描述：逐次减半搜索。第 0 个候选为 manager 的当前配置，其余在搜索空间中随机采样；
+    *           每轮按（Pareto 层级，质量降序，耗时升序）保留前 1/eta_，最后一轮资源比例为 1。
+    *           结束后 manager 被设置为最优配置
+    * 返回值：int - 评测次数
+    * 作者：邓龙威
+    /************************************************************************/
+    int run(ComOptionsManager &manager, const ComTunerRun &runFunc);
+
+    const std::vector<TunerResult> &results() const { return results_; }
+
+    /************************************************************************
+    * 功能描述：已完成的最高一轮中耗时 - 质量的 Pareto 前沿，按耗时升序
+    *           （第 0 轮即未完成时取其已评测的部分）
+    * 返回值：std::vector<TunerResult>
+    * 作者：邓龙威
+    /************************************************************************/
+    std::vector<TunerResult> paretoFront() const;
+
+    /************************************************************************
+    * 功能描述：最优配置：Pareto 前沿中耗时不超过 maxSeconds_ 的质量最高者，
+    *           均超过时取最快者；无有效结果时 valid_ 为 false
+    * 返回值：TunerResult
+    * 作者：邓龙威
+    /************************************************************************/
+    TunerResult winner() const;
+
+    /************************************************************************
+    * 功能描述：将最优配置写入 manager 并以 saveToFile 保存
+    * 返回值：0 表示成功，非 0 表示失败（无有效结果时返回 -1）
+    * 作者：邓龙威
+    /************************************************************************/
+    int saveWinner(ComOptionsManager &manager, const std::string &filePath) const;
+
+    /************************************************************************
+    * 功能描述：读取 / 写入 manager 中与候选参数对应的选项，maxIter_ 同时写入
+    *           GD / CG / QN 及 MeshOptiAlgorithmOptions 中的副本
+    * 返回值：TunerConfig / 无
+    * 作者：邓龙威
+    /************************************************************************/
+    static TunerConfig capture(const ComOptionsManager &manager);
+    static void apply(const TunerConfig &config, ComOptionsManager &manager);
+
+    static std::string configToString(const TunerConfig &config);
+    static std::string resultToString(const TunerResult &result);
+
+private:
+    TunerSpace space_;                 // 搜索空间
+    TunerOptions opts_;                // 控制参数
+    std::vector<TunerResult> results_; // 全部评测结果
+    int finalRung_ = -1;               // 全部候选均已评测的最高轮次（第 0 轮未完成时为 0）
+};
+
+#endif // EMMPMESH_COMMON_COMOPTIONSTUNER_H_
@@ -0,0 +1,100 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComParallel.h
+// 摘    要：轻量并行工具，线程数解析与静态分块并行循环
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMPARALLEL_H_
+#define EMMPMESH_COMMON_COMPARALLEL_H_
+
+#include <thread>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <exception>
+
+/************************************************************************
+* 功能描述：解析线程数设置，requested <= 0 时使用硬件并发数（至少为 1）
+* 返回值：int - 实际使用的线程数
+* 作者：邓龙威
+/************************************************************************/
+inline int ComThreadNum(int requested)
+{
+    if (requested > 0)
+        return requested;
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+/************************************************************************
+* 功能描述：静态分块并行循环，将 [begin, end) 平均划分给 threadNum 个线程，
+*           func(threadId, first, last) 处理子区间 [first, last)。
+*           线程数为 1 或区间过小时直接在调用线程中执行。
+*           func 抛出异常时等待所有线程结束后，在调用线程中重新抛出编号最小的线程的异常
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+inline void ComParallelFor(int begin, int end, int threadNum, const std::function<void(int, int, int)> &func)
+{
+    int count = end - begin;
+    if (count <= 0)
+        return;
+
+    threadNum = std::min(ComThreadNum(threadNum), count);
+    if (threadNum <= 1)
+    {
+        func(0, begin, end);
+        return;
+    }
+
+    // 线程创建失败或调用线程抛出异常时，析构前也要汇合已启动的线程，否则 std::thread 析构将调用 std::terminate
+    struct ThreadJoiner
+    {
+        std::vector<std::thread> threads_;
+        ~ThreadJoiner()
+        {
+            for (auto &th : threads_)
+            {
+                if (th.joinable())
+                    th.join();
+            }
+        }
+    } joiner;
+
+    std::vector<std::exception_ptr> errors(threadNum);
+    auto run = [&func, &errors](int t, int first, int last) {
+        try
+        {
+            func(t, first, last);
+        }
+        catch (...)
+        {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    joiner.threads_.reserve(threadNum - 1);
+    int chunk = count / threadNum;
+    int rest = count % threadNum;
+    int first = begin;
+    for (int t = 0; t < threadNum; ++t)
+    {
+        int last = first + chunk + (t < rest ? 1 : 0);
+        if (t == threadNum - 1)
+            run(t, first, last); // 最后一块由调用线程处理
+        else
+            joiner.threads_.emplace_back(run, t, first, last);
+        first = last;
+    }
+    for (auto &th : joiner.threads_)
+        th.join();
+    for (const auto &error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+#endif // EMMPMESH_COMMON_COMPARALLEL_H_
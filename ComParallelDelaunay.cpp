@@ -0,0 +1,553 @@
+#include "pch.h"
+
+#include "ComParallelDelaunay.h"
+#include "ComDelaunay.h"
+#include "ComHilbert.h"
+#include "ComParallel.h"
+#include "ComPredicates.h"
+#include "ComTetFace.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+// 均匀网格点索引，用于外接球空性检查
+struct ComPointGrid
+{
+    double lo_[3] = {0., 0., 0.}; // 网格起点
+    double cell_ = 1.;            // 单元边长
+    int dim_[3] = {1, 1, 1};      // 各方向单元个数
+    std::vector<int> start_;      // 单元内点的起始下标（CSR）
+    std::vector<int> points_;     // 点编号
+
+    void build(const double *coords, int pointNum)
+    {
+        double hi[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            lo_[j] = std::numeric_limits<double>::max();
+            hi[j] = -std::numeric_limits<double>::max();
+        }
+        for (int i = 0; i < pointNum; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                lo_[j] = std::min(lo_[j], coords[3 * i + j]);
+                hi[j] = std::max(hi[j], coords[3 * i + j]);
+            }
+        }
+        // 平均每个单元约 2 个点
+        double volume = 1.;
+        double extent = 0.;
+        for (int j = 0; j < 3; ++j)
+            extent = std::max(extent, hi[j] - lo_[j]);
+        extent = std::max(extent, 1e-30);
+        for (int j = 0; j < 3; ++j)
+            volume *= std::max(hi[j] - lo_[j], 1e-3 * extent);
+        cell_ = std::cbrt(2. * volume / std::max(pointNum, 1));
+        size_t cellNum = 1;
+        for (int j = 0; j < 3; ++j)
+        {
+            dim_[j] = std::max(1, std::min(1024, static_cast<int>((hi[j] - lo_[j]) / cell_) + 1));
+            cellNum *= dim_[j];
+        }
+
+        std::vector<int> cellOf(pointNum);
+        start_.assign(cellNum + 1, 0);
+        for (int i = 0; i < pointNum; ++i)
+        {
+            cellOf[i] = cellIndex(coords + 3 * i);
+            ++start_[cellOf[i] + 1];
+        }
+        for (size_t c = 0; c < cellNum; ++c)
+            start_[c + 1] += start_[c];
+        points_.resize(pointNum);
+        std::vector<int> pos(start_.begin(), start_.end() - 1);
+        for (int i = 0; i < pointNum; ++i)
+            points_[pos[cellOf[i]]++] = i;
+    }
+
+    // 先在浮点中截断再取整，±DBL_MAX、无穷大或超过 int 范围的坐标分别落到首末单元
+    int clampCell(double x, int j) const
+    {
+        double c = std::floor((x - lo_[j]) / cell_);
+        return static_cast<int>(std::max(0., std::min(static_cast<double>(dim_[j] - 1), c)));
+    }
+
+    int cellIndex(const double *p) const
+    {
+        return (clampCell(p[2], 2) * dim_[1] + clampCell(p[1], 1)) * dim_[0] + clampCell(p[0], 0);
+    }
+
+    // 遍历与包围盒 [lo, hi] 相交的单元内的点，func 返回 false 时提前结束
+    template <typename Func>
+    bool forEach(const double lo[3], const double hi[3], Func func) const
+    {
+        int a[3], b[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            a[j] = clampCell(lo[j], j);
+            b[j] = clampCell(hi[j], j);
+        }
+        for (int z = a[2]; z <= b[2]; ++z)
+        {
+            for (int y = a[1]; y <= b[1]; ++y)
+            {
+                for (int x = a[0]; x <= b[0]; ++x)
+                {
+                    int c = (z * dim_[1] + y) * dim_[0] + x;
+                    for (int k = start_[c]; k < start_[c + 1]; ++k)
+                    {
+                        if (!func(points_[k]))
+                            return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+
+// 四面体 v 的外接球内是否没有点（跳过自身顶点以及属于 skipPart 子区域的点）；
+// 候选点收集到 cand 后以 ComInsphereBatch 批量判断，sign 为临时数组。
+// 共球的点按全局点编号做符号扰动，与各子区域及界面剖分中的判断一致
+static bool ComEmptySphere(const double *coords, const ComPointGrid &grid, const std::vector<int> &part,
+                           const int *v, int skipPart, std::vector<int> &cand, std::vector<int> &sign)
+{
+    const double *p[4] = {coords + 3 * v[0], coords + 3 * v[1], coords + 3 * v[2], coords + 3 * v[3]};
+    double b[3], c[3], d[3];
+    for (int j = 0; j < 3; ++j)
+    {
+        b[j] = p[1][j] - p[0][j];
+        c[j] = p[2][j] - p[0][j];
+        d[j] = p[3][j] - p[0][j];
+    }
+    double cd[3] = {c[1] * d[2] - c[2] * d[1], c[2] * d[0] - c[0] * d[2], c[0] * d[1] - c[1] * d[0]};
+    double db[3] = {d[1] * b[2] - d[2] * b[1], d[2] * b[0] - d[0] * b[2], d[0] * b[1] - d[1] * b[0]};
+    double bc[3] = {b[1] * c[2] - b[2] * c[1], b[2] * c[0] - b[0] * c[2], b[0] * c[1] - b[1] * c[0]};
+    double det = 2. * (b[0] * cd[0] + b[1] * cd[1] + b[2] * cd[2]);
+    double bb = b[0] * b[0] + b[1] * b[1] + b[2] * b[2];
+    double cc = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+    double dd = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+
+    // 外接球的浮点近似只用于确定候选范围，判断由精确谓词完成；退化单元检查全部点
+    double lo[3], hi[3];
+    bool finite = det != 0.;
+    double center[3], r = 0.;
+    for (int j = 0; j < 3 && finite; ++j)
+    {
+        double o = (bb * cd[j] + cc * db[j] + dd * bc[j]) / det;
+        center[j] = p[0][j] + o;
+        r += o * o;
+        finite = std::isfinite(center[j]);
+    }
+    r = std::sqrt(r);
+    r += 1e-6 * r + 1e-12 * (std::fabs(center[0]) + std::fabs(center[1]) + std::fabs(center[2]));
+    for (int j = 0; j < 3; ++j)
+    {
+        lo[j] = finite ? center[j] - r : -std::numeric_limits<double>::max();
+        hi[j] = finite ? center[j] + r : std::numeric_limits<double>::max();
+    }
+
+    cand.clear();
+    grid.forEach(lo, hi, [&](int q) {
+        if (q != v[0] && q != v[1] && q != v[2] && q != v[3] && (skipPart < 0 || part[q] != skipPart))
+            cand.push_back(q);
+        return true;
+    });
+    sign.resize(cand.size());
+    ComInsphereBatch(p[0], p[1], p[2], p[3], coords, cand.data(), static_cast<int>(cand.size()), sign.data());
+    for (size_t i = 0; i < cand.size(); ++i)
+    {
+        int s = sign[i];
+        if (s == 0)
+        {
+            int rank[5] = {v[0], v[1], v[2], v[3], cand[i]};
+            s = ComInspherePerturbed(p[0], p[1], p[2], p[3], coords + 3 * cand[i], rank);
+        }
+        if (s > 0)
+            return false;
+    }
+    return true;
+}
+
+// 单元 v 的体积累加到 volume[0]，其浮点误差界累加到 volume[1]
+static void ComAddVolume(const double *coords, const int *v, double volume[2])
+{
+    const double *p[4] = {coords + 3 * v[0], coords + 3 * v[1], coords + 3 * v[2], coords + 3 * v[3]};
+    double len[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        double d0 = p[i + 1][0] - p[0][0], d1 = p[i + 1][1] - p[0][1], d2 = p[i + 1][2] - p[0][2];
+        len[i] = std::sqrt(d0 * d0 + d1 * d1 + d2 * d2);
+    }
+    volume[0] += ComOrient3dFast(p[0], p[1], p[2], p[3]) / 6.;
+    volume[1] += 64. * ComPredEpsilon * len[0] * len[1] * len[2];
+}
+
+// 以全局点编号为扰动序剖分 points 中的点，tets 输出有限单元（全局编号）；hull 不为空时
+// 输出排好序的凸包面（凸包内侧单元上的有向面），并将凸包体积累加到 hullVolume
+static void ComSubsetDelaunay(const double *coords, const std::vector<int> &points, DelaunayInsertOrder order,
+                              int threadNum, unsigned int seed, std::vector<int> &tets,
+                              std::vector<std::array<int, 3>> *hull, double *hullVolume, DelaunayWalkStat &walk)
+{
+    tets.clear();
+    int n = static_cast<int>(points.size());
+    std::vector<double> local(3 * points.size());
+    for (int i = 0; i < n; ++i)
+        std::copy(coords + 3 * points[i], coords + 3 * points[i] + 3, local.begin() + 3 * i);
+    DelaunayKernel kernel;
+    kernel.init(local.data(), n, points.data());
+    std::vector<int> localOrder, localTets;
+    ComInsertOrder(local.data(), n, order, threadNum, seed, localOrder);
+    for (int i : localOrder)
+        kernel.insert(i);
+    kernel.extract(localTets, hull != nullptr);
+    walk.merge(kernel.walkStat());
+
+    for (size_t t = 0; t < localTets.size(); t += 4)
+    {
+        int g[4], inf = -1;
+        for (int j = 0; j < 4; ++j)
+        {
+            inf = kernel.isInfinite(localTets[t + j]) ? j : inf;
+            g[j] = kernel.isInfinite(localTets[t + j]) ? -1 : points[localTets[t + j]];
+        }
+        if (inf < 0)
+        {
+            tets.insert(tets.end(), g, g + 4);
+            if (hullVolume)
+                ComAddVolume(coords, g, hullVolume);
+            continue;
+        }
+        const int *f = ComTetFaceVert[inf];
+        hull->push_back(ComFaceRotate(g[f[0]], g[f[2]], g[f[1]]));
+    }
+    if (hull)
+        std::sort(hull->begin(), hull->end());
+}
+
+// 并行筛选 cand 中满足 accept 且外接球为空的单元，追加到 tets
+template <typename Accept>
+static void ComKeepEmpty(const double *coords, const ComPointGrid &grid, const std::vector<int> &part,
+                         const std::vector<int> &cand, int threadNum, std::vector<int> &tets, Accept accept)
+{
+    int tetNum = static_cast<int>(cand.size() / 4);
+    std::vector<char> keep(tetNum, 0);
+    ComParallelFor(0, tetNum, threadNum, [&](int, int first, int last) {
+        std::vector<int> near, sign;
+        for (int t = first; t < last; ++t)
+        {
+            const int *g = cand.data() + 4 * t;
+            keep[t] = accept(g) && ComEmptySphere(coords, grid, part, g, -1, near, sign);
+        }
+    });
+    for (int t = 0; t < tetNum; ++t)
+    {
+        if (keep[t])
+            tets.insert(tets.end(), cand.begin() + 4 * t, cand.begin() + 4 * t + 4);
+    }
+}
+
+// tets 是否为凸包的一致剖分：每个有向面至多属于一个单元（同向出现两次即单元重叠），
+// 没有相邻单元的面恰为凸包面 hull（内部面恰属于两个单元），且单元体积之和在误差界内等于凸包体积
+static bool ComConforming(const double *coords, const std::vector<int> &tets,
+                          const std::vector<std::array<int, 3>> &hull, const double hullVolume[2])
+{
+    size_t tetNum = tets.size() / 4;
+    std::vector<std::array<int, 3>> faces(4 * tetNum);
+    double volume[2] = {0., 0.};
+    for (size_t t = 0; t < tetNum; ++t)
+    {
+        for (int i = 0; i < 4; ++i)
+            faces[4 * t + i] = ComTetFace(tets.data() + 4 * t, i);
+        ComAddVolume(coords, tets.data() + 4 * t, volume);
+    }
+    std::sort(faces.begin(), faces.end());
+    if (std::adjacent_find(faces.begin(), faces.end()) != faces.end())
+        return false;
+    size_t boundNum = 0;
+    for (const auto &f : faces)
+    {
+        if (std::binary_search(faces.begin(), faces.end(), ComFaceReverse(f)))
+            continue;
+        if (!std::binary_search(hull.begin(), hull.end(), f))
+            return false;
+        ++boundNum;
+    }
+    double tol = 1e-9 * std::fabs(hullVolume[0]) + volume[1] + hullVolume[1];
+    return boundNum == hull.size() && std::fabs(volume[0] - hullVolume[0]) <= tol;
+}
+
+ParallelDelaunayStat ComParallelDelaunay(const double *coords, int pointNum, int partNum, int threadNum,
+                                         std::vector<int> &tets, DelaunayInsertOrder order, unsigned int seed)
+{
+    ParallelDelaunayStat stat;
+    tets.clear();
+    threadNum = ComThreadNum(threadNum);
+    partNum = std::max(1, std::min(partNum > 0 ? partNum : 4 * threadNum, std::max(pointNum, 1)));
+    stat.partNum_ = partNum;
+    stat.threadNum_ = threadNum;
+    if (pointNum < 4)
+        return stat;
+
+    auto clock = std::chrono::steady_clock::now();
+    auto lap = [&clock]() {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - clock).count();
+        clock = now;
+        return seconds;
+    };
+
+    // 1. 划分：子区域内的点按输入顺序排列，插入顺序在剖分时按 order 生成
+    std::vector<int> part;
+    ComSfcPartition(coords, pointNum, partNum, threadNum, part);
+    std::vector<int> partStart(partNum + 1, 0);
+    for (int i = 0; i < pointNum; ++i)
+        ++partStart[part[i] + 1];
+    for (int k = 0; k < partNum; ++k)
+        partStart[k + 1] += partStart[k];
+    std::vector<int> partPoints(pointNum);
+    {
+        std::vector<int> pos(partStart.begin(), partStart.end() - 1);
+        for (int v = 0; v < pointNum; ++v)
+            partPoints[pos[part[v]]++] = v;
+    }
+
+    ComPointGrid grid;
+    grid.build(coords, pointNum);
+    stat.partitionSeconds_ = lap();
+
+    // 2. 并行剖分各子区域并筛选全局 Delaunay 单元
+    std::vector<std::vector<int>> kept(partNum), border(partNum);
+    std::vector<int> localTetNum(partNum, 0);
+    std::vector<DelaunayWalkStat> localWalk(partNum);
+    std::atomic<int> cursor(0);
+    ComParallelFor(0, std::min(threadNum, partNum), threadNum, [&](int, int, int) {
+        DelaunayKernel kernel;
+        std::vector<double> local;
+        std::vector<int> localTets, localOrder, cand, sign;
+        for (int k = cursor.fetch_add(1); k < partNum; k = cursor.fetch_add(1))
+        {
+            int n = partStart[k + 1] - partStart[k];
+            const int *global = partPoints.data() + partStart[k];
+            local.resize(3 * static_cast<size_t>(n));
+            for (int i = 0; i < n; ++i)
+                std::copy(coords + 3 * global[i], coords + 3 * global[i] + 3, local.begin() + 3 * i);
+            kernel.init(local.data(), n, global);
+            ComInsertOrder(local.data(), n, order, 1, seed + static_cast<unsigned int>(k), localOrder);
+            for (int i : localOrder)
+                kernel.insert(i);
+            kernel.extract(localTets, true);
+            localWalk[k] = kernel.walkStat();
+            // 子区域的点全部共面（或不足 4 个）时没有单元，全部点并入界面点集
+            if (localTets.empty())
+                border[k].insert(border[k].end(), global, global + n);
+
+            for (size_t t = 0; t < localTets.size(); t += 4)
+            {
+                int g[4];
+                bool infinite = false;
+                for (int j = 0; j < 4; ++j)
+                {
+                    infinite = infinite || kernel.isInfinite(localTets[t + j]);
+                    g[j] = kernel.isInfinite(localTets[t + j]) ? -1 : global[localTets[t + j]];
+                }
+                if (!infinite)
+                {
+                    ++localTetNum[k];
+                    if (ComEmptySphere(coords, grid, part, g, k, cand, sign))
+                    {
+                        kept[k].insert(kept[k].end(), g, g + 4);
+                        continue;
+                    }
+                }
+                for (int j = 0; j < 4; ++j)
+                {
+                    if (g[j] >= 0)
+                        border[k].push_back(g[j]);
+                }
+            }
+        }
+    });
+    for (int k = 0; k < partNum; ++k)
+    {
+        stat.localTetNum_ += localTetNum[k];
+        stat.keptTetNum_ += static_cast<int>(kept[k].size() / 4);
+        stat.walk_.merge(localWalk[k]);
+    }
+    stat.localSeconds_ = lap();
+
+    // 3. 界面点集重新剖分，同时得到全局凸包面与凸包体积（界面点集包含全部凸包上的点）
+    std::vector<char> inFace(pointNum, 0);
+    for (const auto &b : border)
+    {
+        for (int v : b)
+            inFace[v] = 1;
+    }
+    std::vector<int> facePoints;
+    for (int v = 0; v < pointNum; ++v)
+    {
+        if (inFace[v])
+            facePoints.push_back(v);
+    }
+    stat.interfacePointNum_ = static_cast<int>(facePoints.size());
+
+    std::vector<int> faceTets, localTets;
+    std::vector<std::array<int, 3>> hull;
+    double hullVolume[2] = {0., 0.};
+    ComSubsetDelaunay(coords, facePoints, order, threadNum, seed + static_cast<unsigned int>(partNum), localTets,
+                      &hull, hullVolume, stat.walk_);
+    ComKeepEmpty(coords, grid, part, localTets, threadNum, faceTets, [&part](const int *g) {
+        return part[g[0]] != part[g[1]] || part[g[0]] != part[g[2]] || part[g[0]] != part[g[3]];
+    });
+    stat.interfaceTetNum_ = static_cast<int>(faceTets.size() / 4);
+
+    for (const auto &k : kept)
+        tets.insert(tets.end(), k.begin(), k.end());
+    tets.insert(tets.end(), faceTets.begin(), faceTets.end());
+
+    // 4. 一致性检查。失败时重新剖分界面区域：界面点及与之相邻的保留单元的全部顶点，
+    //    区域外的保留单元不变，区域内取外接球为空且含界面点的单元；仍失败时串行剖分全部点
+    stat.conforming_ = hull.empty() || ComConforming(coords, tets, hull, hullVolume);
+    if (!stat.conforming_)
+    {
+        ++stat.remeshNum_;
+        std::vector<char> inRegion(inFace);
+        tets.clear();
+        for (const auto &k : kept)
+        {
+            for (size_t t = 0; t < k.size(); t += 4)
+            {
+                const int *v = k.data() + t;
+                if (!inFace[v[0]] && !inFace[v[1]] && !inFace[v[2]] && !inFace[v[3]])
+                {
+                    tets.insert(tets.end(), v, v + 4);
+                    continue;
+                }
+                for (int j = 0; j < 4; ++j)
+                    inRegion[v[j]] = 1;
+            }
+        }
+        std::vector<int> regionPoints;
+        for (int v = 0; v < pointNum; ++v)
+        {
+            if (inRegion[v])
+                regionPoints.push_back(v);
+        }
+        ComSubsetDelaunay(coords, regionPoints, order, threadNum, seed + static_cast<unsigned int>(partNum) + 1,
+                          localTets, nullptr, nullptr, stat.walk_);
+        faceTets.clear();
+        ComKeepEmpty(coords, grid, part, localTets, threadNum, faceTets, [&inFace](const int *g) {
+            return inFace[g[0]] || inFace[g[1]] || inFace[g[2]] || inFace[g[3]];
+        });
+        stat.interfaceTetNum_ = static_cast<int>(faceTets.size() / 4);
+        tets.insert(tets.end(), faceTets.begin(), faceTets.end());
+        stat.conforming_ = ComConforming(coords, tets, hull, hullVolume);
+    }
+    if (!stat.conforming_)
+    {
+        ++stat.remeshNum_;
+        std::vector<int> all(pointNum);
+        for (int v = 0; v < pointNum; ++v)
+            all[v] = v;
+        ComSubsetDelaunay(coords, all, order, threadNum, seed, tets, nullptr, nullptr, stat.walk_);
+        stat.interfaceTetNum_ = static_cast<int>(tets.size() / 4);
+        stat.conforming_ = ComConforming(coords, tets, hull, hullVolume);
+    }
+    stat.tetNum_ = static_cast<int>(tets.size() / 4);
+    stat.interfaceSeconds_ = lap();
+    return stat;
+}
+
+DelaunayLatticeCheck ComParallelDelaunayLatticeCheck(int latticeNum, int partNum, int threadNum)
+{
+    DelaunayLatticeCheck result;
+    int n = std::max(2, latticeNum);
+    result.latticeNum_ = n;
+    std::vector<double> coords;
+    coords.reserve(3 * static_cast<size_t>(n) * n * n);
+    for (int z = 0; z < n; ++z)
+    {
+        for (int y = 0; y < n; ++y)
+        {
+            for (int x = 0; x < n; ++x)
+                coords.insert(coords.end(), {static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)});
+        }
+    }
+    int pointNum = n * n * n;
+
+    std::vector<int> tets;
+    ParallelDelaunayStat stat = ComParallelDelaunay(coords.data(), pointNum, partNum, threadNum, tets);
+    result.partNum_ = stat.partNum_;
+    result.tetNum_ = stat.tetNum_;
+    result.remeshNum_ = stat.remeshNum_;
+
+    // 面的共享次数（不计方向）
+    std::vector<std::array<int, 3>> faces;
+    faces.reserve(tets.size());
+    for (size_t t = 0; t < tets.size(); t += 4)
+    {
+        const int *v = tets.data() + t;
+        result.volume_ += ComOrient3dFast(&coords[3 * v[0]], &coords[3 * v[1]], &coords[3 * v[2]], &coords[3 * v[3]]) / 6.;
+        for (int i = 0; i < 4; ++i)
+        {
+            std::array<int, 3> f = ComTetFace(v, i);
+            std::sort(f.begin(), f.end());
+            faces.push_back(f);
+        }
+    }
+    std::sort(faces.begin(), faces.end());
+    for (size_t i = 0, j = 0; i < faces.size(); i = j)
+    {
+        for (j = i + 1; j < faces.size() && faces[j] == faces[i]; ++j)
+        {
+        }
+        result.boundFaceNum_ += j - i == 1 ? 1 : 0;
+        result.overSharedFaceNum_ += j - i > 2 ? 1 : 0;
+    }
+
+    // 串行剖分（默认 rank 即点编号）作为参照，单元按顶点集合比较
+    DelaunayKernel kernel;
+    kernel.init(coords.data(), pointNum);
+    std::vector<int> index, serial;
+    ComInsertOrder(coords.data(), pointNum, DelaunayInsertOrder::BRIO, 1, 0, index);
+    for (int v : index)
+        kernel.insert(v);
+    kernel.extract(serial);
+    auto canonical = [](std::vector<int> &all) {
+        std::vector<std::array<int, 4>> sorted(all.size() / 4);
+        for (size_t t = 0; t < sorted.size(); ++t)
+        {
+            std::copy(all.begin() + 4 * t, all.begin() + 4 * t + 4, sorted[t].begin());
+            std::sort(sorted[t].begin(), sorted[t].end());
+        }
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    };
+    result.sameAsSerial_ = canonical(tets) == canonical(serial);
+
+    double cube = static_cast<double>(n - 1) * (n - 1) * (n - 1);
+    result.passed_ = std::fabs(result.volume_ - cube) <= 1e-9 * cube && result.overSharedFaceNum_ == 0 &&
+                     result.boundFaceNum_ == 12 * (n - 1) * (n - 1) && result.sameAsSerial_;
+    return result;
+}
+
+std::string ComDelaunayLatticeCheckToString(const DelaunayLatticeCheck &result, LogFileFormat format)
+{
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"lattice", ComTelemetryValue(result.latticeNum_)},
+        {"parts", ComTelemetryValue(result.partNum_)},
+        {"tets", ComTelemetryValue(result.tetNum_)},
+        {"volume", ComTelemetryValue(result.volume_)},
+        {"overSharedFaces", ComTelemetryValue(result.overSharedFaceNum_)},
+        {"boundFaces", ComTelemetryValue(result.boundFaceNum_)},
+        {"sameAsSerial", result.sameAsSerial_ ? "true" : "false"},
+        {"remesh", ComTelemetryValue(result.remeshNum_)},
+        {"passed", result.passed_ ? "true" : "false"},
+    };
+    return ComTelemetryFields(fields, format);
+}
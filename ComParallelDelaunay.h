@@ -0,0 +1,84 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComParallelDelaunay.h
+// 摘    要：区域分解并行 Delaunay 四面体剖分：按 Hilbert 曲线划分子区域并行剖分，
+//           外接球不含其他子区域点的单元直接保留，其余界面区域最后统一重新剖分
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMPARALLELDELAUNAY_H_
+#define EMMPMESH_COMMON_COMPARALLELDELAUNAY_H_
+
+#include "ComDelaunay.h"
+
+#include <string>
+#include <vector>
+
+// 并行剖分统计
+struct ParallelDelaunayStat
+{
+    int partNum_ = 0;              // 子区域个数
+    int threadNum_ = 0;            // 线程数
+    int localTetNum_ = 0;          // 各子区域剖分的单元总数（不含无穷单元）
+    int keptTetNum_ = 0;           // 子区域中直接保留的单元个数
+    int interfacePointNum_ = 0;    // 界面重剖分的点数
+    int interfaceTetNum_ = 0;      // 界面重剖分保留的单元个数
+    int tetNum_ = 0;               // 最终单元个数
+    bool conforming_ = true;       // 最终结果是否通过一致性检查
+    int remeshNum_ = 0;            // 一致性检查失败后的重新剖分次数（1 为界面区域，2 为全部点）
+    double partitionSeconds_ = 0.; // 划分耗时（秒）
+    double localSeconds_ = 0.;     // 子区域剖分与筛选耗时（秒）
+    double interfaceSeconds_ = 0.; // 界面重剖分耗时（秒）
+    DelaunayWalkStat walk_;        // 子区域与界面剖分的点定位行走统计
+};
+
+/************************************************************************
+* 功能描述：区域分解并行 Delaunay 剖分，输出 pointNum 个点的正向四面体（每个 4 个顶点编号）。
+*           1. ComSfcPartition 将点均分为 partNum 个子区域；
+*           2. 各子区域按 order 顺序（ComInsertOrder，子区域 k 的种子为 seed + k）并行剖分，
+*              有限且外接球内没有其他子区域点的单元即为全局 Delaunay 单元，直接保留；
+*              其余单元的顶点及子区域凸包上的顶点（无穷单元的有限顶点）构成界面点集，
+*              点全部共面的子区域整体并入界面点集；
+*           3. 剖分界面点集，保留外接球内没有任何点且顶点不全在同一子区域的单元；
+*           4. 检查合并结果是否为凸包的一致剖分（内部面恰属于两个单元、边界面恰为凸包面、
+*              体积守恒），失败时重新剖分界面区域，仍失败时串行剖分全部点。
+*           各处剖分与外接球检查均以全局点编号做共球的符号扰动，因此点阵等退化输入上
+*           各子区域的选择一致，结果与对全部点串行剖分（DelaunayKernel 默认 rank）相同
+* 返回值：ParallelDelaunayStat - 统计信息
+* 作者：邓龙威
+/************************************************************************/
+ParallelDelaunayStat ComParallelDelaunay(const double *coords, int pointNum, int partNum, int threadNum,
+                                         std::vector<int> &tets,
+                                         DelaunayInsertOrder order = DelaunayInsertOrder::BRIO, unsigned int seed = 0);
+
+// 结构化点阵回归检查结果
+struct DelaunayLatticeCheck
+{
+    int latticeNum_ = 0;        // 每个方向的点数 n（共 n³ 个整数点）
+    int partNum_ = 0;           // 子区域个数
+    int tetNum_ = 0;            // 并行剖分的单元个数
+    double volume_ = 0.;        // 单元体积之和，应为 (n-1)³
+    int overSharedFaceNum_ = 0; // 属于 2 个以上单元的面的个数，应为 0
+    int boundFaceNum_ = 0;      // 只属于 1 个单元的面的个数，应为 12·(n-1)²
+    bool sameAsSerial_ = false; // 单元集合是否与串行剖分相同
+    int remeshNum_ = 0;         // 并行剖分中一致性检查失败后的重新剖分次数
+    bool passed_ = false;       // 以上各项是否全部符合
+};
+
+/************************************************************************
+* 功能描述：结构化点阵回归检查：n×n×n 整数点阵处处共球，对其做 partNum 个子区域的并行剖分，
+*           检查体积守恒、面的共享次数与边界面个数，并与串行剖分逐单元比较
+* 返回值：DelaunayLatticeCheck
+* 作者：邓龙威
+/************************************************************************/
+DelaunayLatticeCheck ComParallelDelaunayLatticeCheck(int latticeNum, int partNum, int threadNum = 0);
+
+/************************************************************************
+* 功能描述：将点阵检查结果格式化为一行（Json / Logfmt，Text 同 Logfmt）
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComDelaunayLatticeCheckToString(const DelaunayLatticeCheck &result, LogFileFormat format);
+
+#endif // EMMPMESH_COMMON_COMPARALLELDELAUNAY_H_
@@ -0,0 +1,203 @@
+#include "pch.h"
+
+#include "ComParamSmooth.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void ParamSmoothCache::setGeometry(const ComCurveEval &curveEval, const ComSurfProject &surfProject)
+{
+    curveEval_ = curveEval;
+    surfProject_ = surfProject;
+}
+
+// 以法向量 n 构造切平面正交基：e1 取与 n 最不平行的坐标轴做 Gram-Schmidt，e2 = n × e1
+static void ComParamTangentAxis(const double *normal, double axis[2][3])
+{
+    double n[3] = {normal[0], normal[1], normal[2]};
+    double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (len < ZERO_30)
+    {
+        n[0] = 0., n[1] = 0., n[2] = 1.;
+        len = 1.;
+    }
+    for (double &c : n)
+        c /= len;
+
+    int k0 = 0;
+    if (std::fabs(n[1]) < std::fabs(n[k0]))
+        k0 = 1;
+    if (std::fabs(n[2]) < std::fabs(n[k0]))
+        k0 = 2;
+    double e1[3] = {0., 0., 0.};
+    e1[k0] = 1.;
+    double dot = e1[0] * n[0] + e1[1] * n[1] + e1[2] * n[2];
+    for (int k = 0; k < 3; ++k)
+        e1[k] -= dot * n[k];
+    double l1 = std::sqrt(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]);
+    for (double &c : e1)
+        c /= l1;
+
+    axis[0][0] = e1[0], axis[0][1] = e1[1], axis[0][2] = e1[2];
+    axis[1][0] = n[1] * e1[2] - n[2] * e1[1];
+    axis[1][1] = n[2] * e1[0] - n[0] * e1[2];
+    axis[1][2] = n[0] * e1[1] - n[1] * e1[0];
+}
+
+const ParamFrame &ParamSmoothCache::frame(int v, int vertType, int geomID, const double *pos, const double *normal, double tParam,
+                                          double tMin, double tMax)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = frames_.find(v);
+    if (it != frames_.end())
+        return it->second;
+
+    ParamFrame f;
+    f.vertType_ = vertType;
+    f.geomID_ = geomID;
+    f.t0_ = tParam;
+    f.tMin_ = tMin;
+    f.tMax_ = tMax;
+    for (int k = 0; k < 3; ++k)
+        f.origin_[k] = pos[k];
+
+    if (vertType == 2)
+        ComParamTangentAxis(normal, f.axis_);
+
+    return frames_.emplace(v, f).first->second;
+}
+
+void ParamSmoothCache::toXYZ(const ParamFrame &f, const double *param, double *xyz) const
+{
+    switch (f.vertType_)
+    {
+    case 0:
+        for (int k = 0; k < 3; ++k)
+            xyz[k] = f.origin_[k];
+        break;
+    case 1:
+        {
+            double dxdt[3];
+            curveEval_(f.geomID_, param[0], xyz, dxdt);
+            break;
+        }
+    case 2:
+        for (int k = 0; k < 3; ++k)
+            xyz[k] = f.origin_[k] + param[0] * f.axis_[0][k] + param[1] * f.axis_[1][k];
+        break;
+    default:
+        for (int k = 0; k < 3; ++k)
+            xyz[k] = param[k];
+        break;
+    }
+}
+
+void ParamSmoothCache::gradToParam(const ParamFrame &f, const double *param, const double *gradXYZ, double *gradParam) const
+{
+    switch (f.vertType_)
+    {
+    case 0:
+        break;
+    case 1:
+        {
+            double xyz[3], dxdt[3];
+            curveEval_(f.geomID_, param[0], xyz, dxdt);
+            gradParam[0] = gradXYZ[0] * dxdt[0] + gradXYZ[1] * dxdt[1] + gradXYZ[2] * dxdt[2];
+            break;
+        }
+    case 2:
+        for (int i = 0; i < 2; ++i)
+            gradParam[i] = gradXYZ[0] * f.axis_[i][0] + gradXYZ[1] * f.axis_[i][1] + gradXYZ[2] * f.axis_[i][2];
+        break;
+    default:
+        for (int k = 0; k < 3; ++k)
+            gradParam[k] = gradXYZ[k];
+        break;
+    }
+}
+
+void ParamSmoothCache::initParam(const ParamFrame &f, double *param) const
+{
+    switch (f.vertType_)
+    {
+    case 0:
+        break;
+    case 1:
+        param[0] = f.t0_;
+        break;
+    case 2:
+        param[0] = 0.;
+        param[1] = 0.;
+        break;
+    default:
+        for (int k = 0; k < 3; ++k)
+            param[k] = f.origin_[k];
+        break;
+    }
+}
+
+void ParamSmoothCache::bounds(const ParamFrame &f, double *lower, double *upper) const
+{
+    int n = f.varNum();
+    for (int i = 0; i < n; ++i)
+    {
+        lower[i] = -std::numeric_limits<double>::infinity();
+        upper[i] = std::numeric_limits<double>::infinity();
+    }
+    if (f.vertType_ == 1)
+    {
+        lower[0] = f.tMin_;
+        upper[0] = f.tMax_;
+    }
+}
+
+void ParamSmoothCache::finalize(int v, const double *param, double *xyz, double *tParam, const double *normal)
+{
+    ParamFrame *f = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = frames_.find(v);
+        if (it == frames_.end())
+            return;
+        f = &it->second; // unordered_map 插入不使已有元素的引用失效，顶点 v 只由一个线程优化
+    }
+
+    // 模型边参数截断到参数区间内，避免在区间外求值
+    double clamped[3] = {0., 0., 0.};
+    for (int i = 0; i < f->varNum(); ++i)
+        clamped[i] = param[i];
+    if (f->vertType_ == 1)
+        clamped[0] = std::max(f->tMin_, std::min(f->tMax_, param[0]));
+    param = clamped;
+
+    toXYZ(*f, param, xyz);
+    if (f->vertType_ == 1 && tParam)
+        *tParam = param[0];
+    if (f->vertType_ == 2 && surfProject_)
+    {
+        // 切平面上的位移只在优化结束后投影回模型面一次
+        surfProject_(f->geomID_, xyz);
+        ++projectNum_;
+    }
+
+    // 以最终位置重新设置参数化，否则下一次光滑从旧的 origin_ / t0_ 开始，丢弃本次位移
+    if (f->vertType_ == 1)
+        f->t0_ = param[0];
+    for (int k = 0; k < 3; ++k)
+        f->origin_[k] = xyz[k];
+    if (f->vertType_ == 2 && normal)
+        ComParamTangentAxis(normal, f->axis_);
+}
+
+void ParamSmoothCache::invalidate(int v)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    frames_.erase(v);
+}
+
+void ParamSmoothCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    frames_.clear();
+}
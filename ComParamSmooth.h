@@ -0,0 +1,130 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComParamSmooth.h
+// 摘    要：边界顶点参数空间光滑，模型边上的顶点沿 tParam 一维优化，
+//           模型面上的顶点在缓存的局部 (u,v) 参数化中二维优化
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMPARAMSMOOTH_H_
+#define EMMPMESH_COMMON_COMPARAMSMOOTH_H_
+
+#include "ComConstants.h"
+
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <mutex>
+
+// 模型边求值：给定模型边 edgeID 与参数 t，返回坐标 xyz 与一阶导数 dxdt（由几何内核提供）
+using ComCurveEval = std::function<void(int edgeID, double t, double *xyz, double *dxdt)>;
+
+// 模型面投影：将 xyz 投影回模型面 faceID，结果写回 xyz（由几何内核提供）
+using ComSurfProject = std::function<void(int faceID, double *xyz)>;
+
+// 单个边界顶点的局部参数化
+struct ParamFrame
+{
+    int vertType_ = 3;                                       // 顶点类型（同 "vertType"）：0 模型点，1 模型边，2 模型面，3 模型体
+    int geomID_ = -1;                                        // 所在模型边 / 面编号
+    double origin_[3] = {};                                  // 面：局部参数化原点（优化前顶点位置）
+    double axis_[2][3] = {};                                 // 面：切平面正交基 e1, e2
+    double t0_ = 0.;                                         // 边：优化前参数
+    double tMin_ = -std::numeric_limits<double>::infinity(); // 边：参数下界（模型边参数区间起点）
+    double tMax_ = std::numeric_limits<double>::infinity();  // 边：参数上界（模型边参数区间终点）
+
+    /************************************************************************
+    * 功能描述：优化变量个数：模型点 0，模型边 1，模型面 2，模型体 3
+    * 返回值：int
+    * 作者：邓龙威
+    /************************************************************************/
+    int varNum() const { return vertType_ == 0 ? 0 : (vertType_ == 1 ? 1 : (vertType_ == 2 ? 2 : 3)); }
+};
+
+// 边界顶点参数化缓存：每个顶点的局部参数化在一次光滑中只建立一次
+class ParamSmoothCache
+{
+public:
+    ParamSmoothCache() = default;
+
+    /************************************************************************
+    * 功能描述：设置几何内核回调，curveEval 用于模型边求值，surfProject 用于模型面最终投影
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setGeometry(const ComCurveEval &curveEval, const ComSurfProject &surfProject);
+
+    /************************************************************************
+    * 功能描述：获取（必要时建立）顶点 v 的局部参数化。
+    *           模型面顶点以 normal 构造切平面正交基；模型边顶点记录 tParam 与所在模型边的
+    *           参数区间 [tMin, tMax]（默认不限）
+    * 返回值：const ParamFrame& - 参数化引用
+    * 作者：邓龙威
+    /************************************************************************/
+    const ParamFrame &frame(int v, int vertType, int geomID, const double *pos, const double *normal, double tParam,
+                            double tMin = -std::numeric_limits<double>::infinity(),
+                            double tMax = std::numeric_limits<double>::infinity());
+
+    /************************************************************************
+    * 功能描述：由参数 param（长度 varNum）计算顶点坐标 xyz
+    *           模型边：xyz = C(t)，无需投影；模型面：xyz = origin + u*e1 + v*e2
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void toXYZ(const ParamFrame &f, const double *param, double *xyz) const;
+
+    /************************************************************************
+    * 功能描述：链式法则将三维梯度 gradXYZ 转换为参数空间梯度 gradParam
+    *           模型边：dF/dt = ∇F·C'(t)；模型面：dF/du = ∇F·e1，dF/dv = ∇F·e2
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void gradToParam(const ParamFrame &f, const double *param, const double *gradXYZ, double *gradParam) const;
+
+    /************************************************************************
+    * 功能描述：参数空间初值（模型边为 t0，模型面为 (0,0)）
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void initParam(const ParamFrame &f, double *param) const;
+
+    /************************************************************************
+    * 功能描述：参数空间的盒约束（长度 varNum），可直接作为 NLCProblem::lower_ / upper_：
+    *           模型边为 [tMin_, tMax_]，其余变量不限（±∞）
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void bounds(const ParamFrame &f, double *lower, double *upper) const;
+
+    /************************************************************************
+    * 功能描述：优化结束后确定顶点 v 的最终坐标：模型边先将参数截断到 [tMin_, tMax_] 再求值，
+    *           模型面只投影一次；模型边同时返回新的 tParam。随后以最终位置重新设置 v 的参数化
+    *           （模型边 t0 = tParam，模型面原点为投影后的位置，normal 非空时以其重建切平面基），
+    *           下一次光滑从移动后的位置开始，参数初值 initParam 与新位置一致。
+    *           v 没有参数化时不做任何处理
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void finalize(int v, const double *param, double *xyz, double *tParam, const double *normal = nullptr);
+
+    /************************************************************************
+    * 功能描述：使顶点 v 的参数化失效（顶点被投影或拓扑改变后调用）
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void invalidate(int v);
+    void clear();
+
+    long long projectNum() const { return projectNum_; }
+
+private:
+    ComCurveEval curveEval_;                       // 模型边求值
+    ComSurfProject surfProject_;                   // 模型面投影
+    std::unordered_map<int, ParamFrame> frames_;   // 顶点 -> 局部参数化
+    std::mutex mutex_;                             // 保护 frames_ 的查找与插入
+    mutable std::atomic<long long> projectNum_{0}; // 模型面投影次数统计
+};
+
+#endif // EMMPMESH_COMMON_COMPARAMSMOOTH_H_
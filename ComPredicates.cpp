@@ -0,0 +1,556 @@
+#include "pch.h"
+
+#include "ComPredicates.h"
+
+#include <algorithm>
+#include <cmath>
+
+void ComTwoSum(double a, double b, double &x, double &y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+void ComTwoDiff(double a, double b, double &x, double &y)
+{
+    x = a - b;
+    double bv = a - x;
+    double av = x + bv;
+    y = (a - av) + (bv - b);
+}
+
+void ComTwoProduct(double a, double b, double &x, double &y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// 扩展加上一个 double（GROW-EXPANSION，消去零分量）
+static void ComExpansionGrow(const std::vector<double> &e, double b, std::vector<double> &h)
+{
+    h.clear();
+    double q = b;
+    for (double ei : e)
+    {
+        double qNew, hh;
+        ComTwoSum(q, ei, qNew, hh);
+        q = qNew;
+        if (hh != 0.)
+            h.push_back(hh);
+    }
+    if (q != 0. || h.empty())
+        h.push_back(q);
+}
+
+void ComExpansionSum(const std::vector<double> &e, const std::vector<double> &f, std::vector<double> &h)
+{
+    h = e;
+    std::vector<double> tmp;
+    for (double fi : f)
+    {
+        ComExpansionGrow(h, fi, tmp);
+        h.swap(tmp);
+    }
+}
+
+void ComExpansionScale(const std::vector<double> &e, double b, std::vector<double> &h)
+{
+    h.clear();
+    if (e.empty())
+        return;
+
+    double q, hh;
+    ComTwoProduct(e[0], b, q, hh);
+    if (hh != 0.)
+        h.push_back(hh);
+    for (size_t i = 1; i < e.size(); ++i)
+    {
+        double p1, p0, sum;
+        ComTwoProduct(e[i], b, p1, p0);
+        ComTwoSum(q, p0, sum, hh);
+        if (hh != 0.)
+            h.push_back(hh);
+        ComTwoSum(p1, sum, q, hh);
+        if (hh != 0.)
+            h.push_back(hh);
+    }
+    if (q != 0. || h.empty())
+        h.push_back(q);
+}
+
+void ComExpansionProduct(const std::vector<double> &e, const std::vector<double> &f, std::vector<double> &h)
+{
+    h.assign(1, 0.);
+    std::vector<double> part, tmp;
+    for (double fi : f)
+    {
+        ComExpansionScale(e, fi, part);
+        ComExpansionSum(h, part, tmp);
+        h.swap(tmp);
+    }
+}
+
+int ComExpansionSign(const std::vector<double> &e)
+{
+    for (size_t i = e.size(); i > 0; --i)
+    {
+        if (e[i - 1] > 0.)
+            return 1;
+        if (e[i - 1] < 0.)
+            return -1;
+    }
+    return 0;
+}
+
+double ComOrient3dFast(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    double ux = pb[0] - pa[0], uy = pb[1] - pa[1], uz = pb[2] - pa[2];
+    double vx = pc[0] - pa[0], vy = pc[1] - pa[1], vz = pc[2] - pa[2];
+    double wx = pd[0] - pa[0], wy = pd[1] - pa[1], wz = pd[2] - pa[2];
+    return ux * (vy * wz - vz * wy) + uy * (vz * wx - vx * wz) + uz * (vx * wy - vy * wx);
+}
+
+// 两数之差的扩展表示
+static std::vector<double> ComDiffExpansion(double a, double b)
+{
+    double x, y;
+    ComTwoDiff(a, b, x, y);
+    std::vector<double> e;
+    if (y != 0.)
+        e.push_back(y);
+    e.push_back(x);
+    return e;
+}
+
+// 2x2 子式 a*d - b*c 的扩展表示
+static void ComMinorExpansion(const std::vector<double> &a, const std::vector<double> &d,
+                              const std::vector<double> &b, const std::vector<double> &c,
+                              std::vector<double> &h)
+{
+    std::vector<double> ad, bc;
+    ComExpansionProduct(a, d, ad);
+    ComExpansionProduct(b, c, bc);
+    for (auto &x : bc)
+        x = -x;
+    ComExpansionSum(ad, bc, h);
+}
+
+double ComOrient2dFast(const double *pa, const double *pb, const double *pc)
+{
+    return (pa[0] - pc[0]) * (pb[1] - pc[1]) - (pa[1] - pc[1]) * (pb[0] - pc[0]);
+}
+
+int ComOrient2dExact(const double *pa, const double *pb, const double *pc)
+{
+    std::vector<double> acx = ComDiffExpansion(pa[0], pc[0]), acy = ComDiffExpansion(pa[1], pc[1]);
+    std::vector<double> bcx = ComDiffExpansion(pb[0], pc[0]), bcy = ComDiffExpansion(pb[1], pc[1]);
+    std::vector<double> det;
+    ComMinorExpansion(acx, bcy, acy, bcx, det);
+    return ComExpansionSign(det);
+}
+
+// 二维方向过滤值：det 与误差界 bound，输入为 a、b 相对 c 的差向量
+static inline void ComOrient2dFilter(double acx, double acy, double bcx, double bcy, double &det, double &bound)
+{
+    double left = acx * bcy, right = acy * bcx;
+    det = left - right;
+    bound = ComOrient2dErrBound * (std::fabs(left) + std::fabs(right));
+}
+
+int ComOrient2d(const double *pa, const double *pb, const double *pc)
+{
+    double det, errBound;
+    ComOrient2dFilter(pa[0] - pc[0], pa[1] - pc[1], pb[0] - pc[0], pb[1] - pc[1], det, errBound);
+    if (det > errBound)
+        return 1;
+    if (-det > errBound)
+        return -1;
+    return ComOrient2dExact(pa, pb, pc);
+}
+
+// 外接圆过滤值：提升行列式 det（圆内为正）与误差界 bound，输入为 a、b、c 相对 d 的差向量
+static inline void ComIncircleFilter(double adx, double ady, double bdx, double bdy, double cdx, double cdy,
+                                     double &det, double &bound)
+{
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+    double alift = adx * adx + ady * ady;
+    double blift = bdx * bdx + bdy * bdy;
+    double clift = cdx * cdx + cdy * cdy;
+    det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift +
+                       (std::fabs(cdxady) + std::fabs(adxcdy)) * blift +
+                       (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+    bound = ComIncircleErrBound * permanent;
+}
+
+double ComIncircleFast(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    double det, bound;
+    ComIncircleFilter(pa[0] - pd[0], pa[1] - pd[1], pb[0] - pd[0], pb[1] - pd[1], pc[0] - pd[0], pc[1] - pd[1],
+                      det, bound);
+    return det;
+}
+
+int ComIncircleExact(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    const double *p[3] = {pa, pb, pc};
+    std::vector<double> x[3], y[3], lift[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        x[i] = ComDiffExpansion(p[i][0], pd[0]);
+        y[i] = ComDiffExpansion(p[i][1], pd[1]);
+        std::vector<double> xx, yy;
+        ComExpansionProduct(x[i], x[i], xx);
+        ComExpansionProduct(y[i], y[i], yy);
+        ComExpansionSum(xx, yy, lift[i]);
+    }
+
+    // det = Σ lift[i] · (x[j]·y[k] - x[k]·y[j])，(i, j, k) 为 (0, 1, 2) 的轮换
+    std::vector<double> det, m, term, sum;
+    for (int i = 0; i < 3; ++i)
+    {
+        int j = (i + 1) % 3, k = (i + 2) % 3;
+        ComMinorExpansion(x[j], y[k], x[k], y[j], m);
+        ComExpansionProduct(lift[i], m, term);
+        ComExpansionSum(det, term, sum);
+        det.swap(sum);
+    }
+    return ComExpansionSign(det);
+}
+
+int ComIncircle(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    double det, errBound;
+    ComIncircleFilter(pa[0] - pd[0], pa[1] - pd[1], pb[0] - pd[0], pb[1] - pd[1], pc[0] - pd[0], pc[1] - pd[1],
+                      det, errBound);
+    if (det > errBound)
+        return 1;
+    if (-det > errBound)
+        return -1;
+    return ComIncircleExact(pa, pb, pc, pd);
+}
+
+int ComOrient3dExact(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    std::vector<double> u[3], v[3], w[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        u[k] = ComDiffExpansion(pb[k], pa[k]);
+        v[k] = ComDiffExpansion(pc[k], pa[k]);
+        w[k] = ComDiffExpansion(pd[k], pa[k]);
+    }
+
+    // det = u·(v×w)
+    std::vector<double> cx, cy, cz, tx, ty, tz, sum, det;
+    ComMinorExpansion(v[1], w[2], v[2], w[1], cx);
+    ComMinorExpansion(v[2], w[0], v[0], w[2], cy);
+    ComMinorExpansion(v[0], w[1], v[1], w[0], cz);
+    ComExpansionProduct(u[0], cx, tx);
+    ComExpansionProduct(u[1], cy, ty);
+    ComExpansionProduct(u[2], cz, tz);
+    ComExpansionSum(tx, ty, sum);
+    ComExpansionSum(sum, tz, det);
+    return ComExpansionSign(det);
+}
+
+int ComOrient3d(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    double ux = pb[0] - pa[0], uy = pb[1] - pa[1], uz = pb[2] - pa[2];
+    double vx = pc[0] - pa[0], vy = pc[1] - pa[1], vz = pc[2] - pa[2];
+    double wx = pd[0] - pa[0], wy = pd[1] - pa[1], wz = pd[2] - pa[2];
+
+    double m1 = vy * wz, m2 = vz * wy;
+    double m3 = vz * wx, m4 = vx * wz;
+    double m5 = vx * wy, m6 = vy * wx;
+    double det = ux * (m1 - m2) + uy * (m3 - m4) + uz * (m5 - m6);
+
+    double permanent = std::fabs(ux) * (std::fabs(m1) + std::fabs(m2)) +
+                       std::fabs(uy) * (std::fabs(m3) + std::fabs(m4)) +
+                       std::fabs(uz) * (std::fabs(m5) + std::fabs(m6));
+    double errBound = ComOrient3dErrBound * permanent;
+    if (det > errBound)
+        return 1;
+    if (-det > errBound)
+        return -1;
+    return ComOrient3dExact(pa, pb, pc, pd);
+}
+
+// 外接球行列式：以 e 为原点的提升行列式，展开为 (d·abc - c·dab) + (b·cda - a·bcd)，
+// 其中 xyz 为对应三点的 3x3 子式，结果取反使正向四面体的球内点为正
+double ComInsphereFast(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe)
+{
+    double aex = pa[0] - pe[0], aey = pa[1] - pe[1], aez = pa[2] - pe[2];
+    double bex = pb[0] - pe[0], bey = pb[1] - pe[1], bez = pb[2] - pe[2];
+    double cex = pc[0] - pe[0], cey = pc[1] - pe[1], cez = pc[2] - pe[2];
+    double dex = pd[0] - pe[0], dey = pd[1] - pe[1], dez = pd[2] - pe[2];
+
+    double ab = aex * bey - bex * aey;
+    double bc = bex * cey - cex * bey;
+    double cd = cex * dey - dex * cey;
+    double da = dex * aey - aex * dey;
+    double ac = aex * cey - cex * aey;
+    double bd = bex * dey - dex * bey;
+
+    double abc = aez * bc - bez * ac + cez * ab;
+    double bcd = bez * cd - cez * bd + dez * bc;
+    double cda = cez * da + dez * ac + aez * cd;
+    double dab = dez * ab + aez * bd + bez * da;
+
+    double alift = aex * aex + aey * aey + aez * aez;
+    double blift = bex * bex + bey * bey + bez * bez;
+    double clift = cex * cex + cey * cey + cez * cez;
+    double dlift = dex * dex + dey * dey + dez * dez;
+
+    return -((dlift * abc - clift * dab) + (blift * cda - alift * bcd));
+}
+
+int ComInsphereExact(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe)
+{
+    const double *p[4] = {pa, pb, pc, pd};
+    std::vector<double> x[4], y[4], z[4], lift[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        x[i] = ComDiffExpansion(p[i][0], pe[0]);
+        y[i] = ComDiffExpansion(p[i][1], pe[1]);
+        z[i] = ComDiffExpansion(p[i][2], pe[2]);
+        std::vector<double> xx, yy, zz, sum;
+        ComExpansionProduct(x[i], x[i], xx);
+        ComExpansionProduct(y[i], y[i], yy);
+        ComExpansionProduct(z[i], z[i], zz);
+        ComExpansionSum(xx, yy, sum);
+        ComExpansionSum(sum, zz, lift[i]);
+    }
+
+    // 3x3 子式 det[x y z](i, j, k)
+    auto minor3 = [&](int i, int j, int k, std::vector<double> &h) {
+        std::vector<double> m, t0, t1, t2, sum;
+        ComMinorExpansion(y[j], z[k], z[j], y[k], m);
+        ComExpansionProduct(x[i], m, t0);
+        ComMinorExpansion(y[k], z[i], z[k], y[i], m);
+        ComExpansionProduct(x[j], m, t1);
+        ComMinorExpansion(y[i], z[j], z[i], y[j], m);
+        ComExpansionProduct(x[k], m, t2);
+        ComExpansionSum(t0, t1, sum);
+        ComExpansionSum(sum, t2, h);
+    };
+
+    // 4x4 提升行列式按最后一列展开：det = -l0·M(1,2,3) + l1·M(0,2,3) - l2·M(0,1,3) + l3·M(0,1,2)
+    std::vector<double> det, term, m;
+    const int rows[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+    for (int i = 0; i < 4; ++i)
+    {
+        minor3(rows[i][0], rows[i][1], rows[i][2], m);
+        ComExpansionProduct(lift[i], m, term);
+        if (i % 2 == 0)
+        {
+            for (auto &v : term)
+                v = -v;
+        }
+        std::vector<double> sum;
+        ComExpansionSum(det, term, sum);
+        det.swap(sum);
+    }
+    // 提升行列式与 ComInsphereFast 中的展开式同号，取反后球内为正
+    return -ComExpansionSign(det);
+}
+
+// 外接球过滤值：提升行列式 det（球内为负）与误差界 bound，输入为 a..d 相对 e 的差向量
+static inline void ComInsphereFilter(double aex, double aey, double aez, double bex, double bey, double bez,
+                                     double cex, double cey, double cez, double dex, double dey, double dez,
+                                     double &det, double &bound)
+{
+    double aexbey = aex * bey, bexaey = bex * aey;
+    double bexcey = bex * cey, cexbey = cex * bey;
+    double cexdey = cex * dey, dexcey = dex * cey;
+    double dexaey = dex * aey, aexdey = aex * dey;
+    double aexcey = aex * cey, cexaey = cex * aey;
+    double bexdey = bex * dey, dexbey = dex * bey;
+    double ab = aexbey - bexaey, bc = bexcey - cexbey, cd = cexdey - dexcey;
+    double da = dexaey - aexdey, ac = aexcey - cexaey, bd = bexdey - dexbey;
+
+    double abc = aez * bc - bez * ac + cez * ab;
+    double bcd = bez * cd - cez * bd + dez * bc;
+    double cda = cez * da + dez * ac + aez * cd;
+    double dab = dez * ab + aez * bd + bez * da;
+
+    double alift = aex * aex + aey * aey + aez * aez;
+    double blift = bex * bex + bey * bey + bez * bez;
+    double clift = cex * cex + cey * cey + cez * cez;
+    double dlift = dex * dex + dey * dey + dez * dez;
+
+    det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+    double aezp = std::fabs(aez), bezp = std::fabs(bez), cezp = std::fabs(cez), dezp = std::fabs(dez);
+    double abp = std::fabs(aexbey) + std::fabs(bexaey), bcp = std::fabs(bexcey) + std::fabs(cexbey);
+    double cdp = std::fabs(cexdey) + std::fabs(dexcey), dap = std::fabs(dexaey) + std::fabs(aexdey);
+    double acp = std::fabs(aexcey) + std::fabs(cexaey), bdp = std::fabs(bexdey) + std::fabs(dexbey);
+    double permanent = ((cdp * bezp + bdp * cezp + bcp * dezp) * alift +
+                        (dap * cezp + acp * dezp + cdp * aezp) * blift) +
+                       ((abp * dezp + bdp * aezp + dap * bezp) * clift +
+                        (bcp * aezp + acp * bezp + abp * cezp) * dlift);
+    bound = ComInsphereErrBound * permanent;
+}
+
+int ComInsphere(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe)
+{
+    double det, errBound;
+    ComInsphereFilter(pa[0] - pe[0], pa[1] - pe[1], pa[2] - pe[2], pb[0] - pe[0], pb[1] - pe[1], pb[2] - pe[2],
+                      pc[0] - pe[0], pc[1] - pe[1], pc[2] - pe[2], pd[0] - pe[0], pd[1] - pe[1], pd[2] - pe[2],
+                      det, errBound);
+    if (det > errBound)
+        return -1;
+    if (-det > errBound)
+        return 1;
+    return ComInsphereExact(pa, pb, pc, pd, pe);
+}
+
+int ComInspherePerturbed(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe,
+                         const int rank[5])
+{
+    int s = ComInsphere(pa, pb, pc, pd, pe);
+    if (s != 0)
+        return s;
+    int order[5] = {0, 1, 2, 3, 4};
+    std::sort(order, order + 5, [rank](int a, int b) { return rank[a] > rank[b]; });
+    for (int i : order)
+    {
+        if (i == 4)
+            break;
+        const double *p[4] = {pa, pb, pc, pd};
+        p[i] = pe;
+        int o = ComOrient3d(p[0], p[1], p[2], p[3]);
+        if (o != 0)
+            return o;
+    }
+    return -1;
+}
+
+int ComInsphereBatch(const double *pa, const double *pb, const double *pc, const double *pd,
+                     const double *coords, const int *points, int num, int *sign)
+{
+    int exactNum = 0;
+    for (int first = 0; first < num; first += ComPredBatch)
+    {
+        int n = std::min(ComPredBatch, num - first);
+        // SoA 布局：查询点坐标，尾部以 pa 填充，保证定长循环
+        double ex[ComPredBatch], ey[ComPredBatch], ez[ComPredBatch];
+        for (int i = 0; i < ComPredBatch; ++i)
+        {
+            const double *pe = i < n ? coords + 3 * static_cast<size_t>(points[first + i]) : pa;
+            ex[i] = pe[0], ey[i] = pe[1], ez[i] = pe[2];
+        }
+
+        // 定长、无分支的内层循环，由编译器向量化
+        double det[ComPredBatch], bound[ComPredBatch];
+        for (int i = 0; i < ComPredBatch; ++i)
+        {
+            ComInsphereFilter(pa[0] - ex[i], pa[1] - ey[i], pa[2] - ez[i], pb[0] - ex[i], pb[1] - ey[i], pb[2] - ez[i],
+                              pc[0] - ex[i], pc[1] - ey[i], pc[2] - ez[i], pd[0] - ex[i], pd[1] - ey[i], pd[2] - ez[i],
+                              det[i], bound[i]);
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (det[i] > bound[i])
+                sign[first + i] = -1;
+            else if (-det[i] > bound[i])
+                sign[first + i] = 1;
+            else
+            {
+                sign[first + i] = ComInsphereExact(pa, pb, pc, pd, coords + 3 * static_cast<size_t>(points[first + i]));
+                ++exactNum;
+            }
+        }
+    }
+    return exactNum;
+}
+
+int ComIncircleBatch(const double *pa, const double *pb, const double *pc,
+                     const double *coords, const int *points, int num, int *sign)
+{
+    int exactNum = 0;
+    for (int first = 0; first < num; first += ComPredBatch)
+    {
+        int n = std::min(ComPredBatch, num - first);
+        double dx[ComPredBatch], dy[ComPredBatch];
+        for (int i = 0; i < ComPredBatch; ++i)
+        {
+            const double *pd = i < n ? coords + 2 * static_cast<size_t>(points[first + i]) : pa;
+            dx[i] = pd[0], dy[i] = pd[1];
+        }
+
+        double det[ComPredBatch], bound[ComPredBatch];
+        for (int i = 0; i < ComPredBatch; ++i)
+        {
+            ComIncircleFilter(pa[0] - dx[i], pa[1] - dy[i], pb[0] - dx[i], pb[1] - dy[i], pc[0] - dx[i], pc[1] - dy[i],
+                              det[i], bound[i]);
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (det[i] > bound[i])
+                sign[first + i] = 1;
+            else if (-det[i] > bound[i])
+                sign[first + i] = -1;
+            else
+            {
+                sign[first + i] = ComIncircleExact(pa, pb, pc, coords + 2 * static_cast<size_t>(points[first + i]));
+                ++exactNum;
+            }
+        }
+    }
+    return exactNum;
+}
+
+int ComOrient2dBatch(const double *coords, const int *tris, int triNum, int *sign)
+{
+    int exactNum = 0;
+    for (int first = 0; first < triNum; first += ComPredBatch)
+    {
+        int n = std::min(ComPredBatch, triNum - first);
+        // SoA 布局：a、b 相对 c 的差向量，尾部填充为单位正三角形
+        double acx[ComPredBatch], acy[ComPredBatch], bcx[ComPredBatch], bcy[ComPredBatch];
+        for (int i = 0; i < ComPredBatch; ++i)
+        {
+            if (i < n)
+            {
+                const int *t = tris + 3 * static_cast<size_t>(first + i);
+                const double *pa = coords + 2 * static_cast<size_t>(t[0]);
+                const double *pb = coords + 2 * static_cast<size_t>(t[1]);
+                const double *pc = coords + 2 * static_cast<size_t>(t[2]);
+                acx[i] = pa[0] - pc[0], acy[i] = pa[1] - pc[1];
+                bcx[i] = pb[0] - pc[0], bcy[i] = pb[1] - pc[1];
+            }
+            else
+            {
+                acx[i] = 1., acy[i] = 0.;
+                bcx[i] = 0., bcy[i] = 1.;
+            }
+        }
+
+        double det[ComPredBatch], bound[ComPredBatch];
+        for (int i = 0; i < ComPredBatch; ++i)
+            ComOrient2dFilter(acx[i], acy[i], bcx[i], bcy[i], det[i], bound[i]);
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (det[i] > bound[i])
+                sign[first + i] = 1;
+            else if (-det[i] > bound[i])
+                sign[first + i] = -1;
+            else
+            {
+                const int *t = tris + 3 * static_cast<size_t>(first + i);
+                sign[first + i] = ComOrient2dExact(coords + 2 * static_cast<size_t>(t[0]),
+                                                   coords + 2 * static_cast<size_t>(t[1]),
+                                                   coords + 2 * static_cast<size_t>(t[2]));
+                ++exactNum;
+            }
+        }
+    }
+    return exactNum;
+}
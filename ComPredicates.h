@@ -0,0 +1,221 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComPredicates.h
+// 摘    要：鲁棒几何谓词（orient2d / orient3d / incircle / insphere），浮点误差过滤 + 精确扩展算术回退；
+//           批量接口按 SoA 定长批次计算过滤值，便于编译器向量化
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMPREDICATES_H_
+#define EMMPMESH_COMMON_COMPREDICATES_H_
+
+#include <vector>
+
+// 双精度机器精度 2^-53，用于误差界
+inline const double ComPredEpsilon = 1.1102230246251565e-16;
+
+// orient3d 静态误差界系数（Shewchuk, 1997）
+inline const double ComOrient3dErrBound = (7.0 + 56.0 * ComPredEpsilon) * ComPredEpsilon;
+
+// insphere 静态误差界系数（Shewchuk, 1997）
+inline const double ComInsphereErrBound = (16.0 + 224.0 * ComPredEpsilon) * ComPredEpsilon;
+
+// orient2d 静态误差界系数（Shewchuk, 1997）
+inline const double ComOrient2dErrBound = (3.0 + 16.0 * ComPredEpsilon) * ComPredEpsilon;
+
+// incircle 静态误差界系数（Shewchuk, 1997）
+inline const double ComIncircleErrBound = (10.0 + 96.0 * ComPredEpsilon) * ComPredEpsilon;
+
+// 批量谓词的批处理宽度：每批按 SoA 布局计算的查询个数，定长内层循环便于编译器向量化
+inline const int ComPredBatch = 8;
+
+// =============================== 扩展算术 ===============================
+// 扩展（expansion）为按绝对值递增、互不重叠的 double 序列，其和精确表示一个实数
+
+/************************************************************************
+* 功能描述：两数之和的精确表示 a + b = x + y
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComTwoSum(double a, double b, double &x, double &y);
+
+/************************************************************************
+* 功能描述：两数之差的精确表示 a - b = x + y
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComTwoDiff(double a, double b, double &x, double &y);
+
+/************************************************************************
+* 功能描述：两数之积的精确表示 a * b = x + y（基于 fma）
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComTwoProduct(double a, double b, double &x, double &y);
+
+/************************************************************************
+* 功能描述：扩展之和 h = e + f，消去零分量
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComExpansionSum(const std::vector<double> &e, const std::vector<double> &f, std::vector<double> &h);
+
+/************************************************************************
+* 功能描述：扩展与标量之积 h = e * b，消去零分量
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComExpansionScale(const std::vector<double> &e, double b, std::vector<double> &h);
+
+/************************************************************************
+* 功能描述：扩展之积 h = e * f，消去零分量
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComExpansionProduct(const std::vector<double> &e, const std::vector<double> &f, std::vector<double> &h);
+
+/************************************************************************
+* 功能描述：扩展的符号（最高位非零分量的符号）
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComExpansionSign(const std::vector<double> &e);
+
+// =============================== 二维谓词 ===============================
+// 约定：pa, pb, pc, pd 各为 2 个 double；orient2d 返回 2 倍有向面积 (a-c)×(b-c) 的值或符号，
+// abc 逆时针时为正；三角形 abc 逆时针时，incircle 在 pd 位于其外接圆内为正、圆外为负、圆上为 0
+
+/************************************************************************
+* 功能描述：直接浮点计算 2 倍有向面积，不做误差控制
+* 返回值：double
+* 作者：邓龙威
+/************************************************************************/
+double ComOrient2dFast(const double *pa, const double *pb, const double *pc);
+
+/************************************************************************
+* 功能描述：精确计算 2 倍有向面积的符号（扩展算术）
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComOrient2dExact(const double *pa, const double *pb, const double *pc);
+
+/************************************************************************
+* 功能描述：带浮点过滤的 2 倍有向面积符号，|det| 超过误差界时直接返回，否则回退精确计算
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComOrient2d(const double *pa, const double *pb, const double *pc);
+
+/************************************************************************
+* 功能描述：直接浮点计算外接圆行列式，不做误差控制
+* 返回值：double
+* 作者：邓龙威
+/************************************************************************/
+double ComIncircleFast(const double *pa, const double *pb, const double *pc, const double *pd);
+
+/************************************************************************
+* 功能描述：精确计算外接圆行列式的符号（扩展算术）
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComIncircleExact(const double *pa, const double *pb, const double *pc, const double *pd);
+
+/************************************************************************
+* 功能描述：带浮点过滤的外接圆行列式符号，|det| 超过误差界时直接返回，否则回退精确计算
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComIncircle(const double *pa, const double *pb, const double *pc, const double *pd);
+
+// =============================== 方向谓词 ===============================
+// 约定：pa, pb, pc, pd 各为 3 个 double；返回 6 倍有向体积 (b-a)·((c-a)×(d-a)) 的值或符号，
+// 四面体 abcd 为正向（体积为正）时结果为正
+
+/************************************************************************
+* 功能描述：直接浮点计算 6 倍有向体积，不做误差控制
+* 返回值：double
+* 作者：邓龙威
+/************************************************************************/
+double ComOrient3dFast(const double *pa, const double *pb, const double *pc, const double *pd);
+
+/************************************************************************
+* 功能描述：精确计算 6 倍有向体积的符号（扩展算术）
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComOrient3dExact(const double *pa, const double *pb, const double *pc, const double *pd);
+
+/************************************************************************
+* 功能描述：带浮点过滤的 6 倍有向体积符号，|det| 超过误差界时直接返回，否则回退精确计算
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComOrient3d(const double *pa, const double *pb, const double *pc, const double *pd);
+
+// =============================== 外接球谓词 ===============================
+// 约定：四面体 abcd 为正向（ComOrient3d > 0）时，pe 位于其外接球内结果为正、球外为负、球面上为 0
+
+/************************************************************************
+* 功能描述：直接浮点计算外接球行列式，不做误差控制
+* 返回值：double
+* 作者：邓龙威
+/************************************************************************/
+double ComInsphereFast(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe);
+
+/************************************************************************
+* 功能描述：精确计算外接球行列式的符号（扩展算术）
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComInsphereExact(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe);
+
+/************************************************************************
+* 功能描述：带浮点过滤的外接球行列式符号，|det| 超过误差界时直接返回，否则回退精确计算
+* 返回值：int - 1、-1 或 0
+* 作者：邓龙威
+/************************************************************************/
+int ComInsphere(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe);
+
+/************************************************************************
+* 功能描述：带符号扰动的外接球判断。ComInsphere 为 0（五点共球）时模拟提升高度的扰动：
+*           rank（5 个点的全序编号，如全局点编号）越大扰动越占优，按 rank 从大到小以 pe
+*           替换该顶点求 ComOrient3d，首个非零值即结果，轮到 pe 自身时为球外。
+*           同一组点在各处调用须给出相同的 rank，判断才能一致
+* 返回值：int - 1 或 -1
+* 作者：邓龙威
+/************************************************************************/
+int ComInspherePerturbed(const double *pa, const double *pb, const double *pc, const double *pd, const double *pe,
+                         const int rank[5]);
+
+// =============================== 批量谓词 ===============================
+// 同一组固定顶点对多个查询点求符号，过滤值按 ComPredBatch 定长批次无分支计算，
+// 误差界内的查询逐个回退精确谓词；结果与逐个调用标量谓词相同
+
+/************************************************************************
+* 功能描述：批量外接球判断：sign[i] = ComInsphere(pa, pb, pc, pd, coords + 3·points[i])，
+*           coords 为三维点坐标，points 为 num 个查询点编号
+* 返回值：int - 回退精确计算的查询个数
+* 作者：邓龙威
+/************************************************************************/
+int ComInsphereBatch(const double *pa, const double *pb, const double *pc, const double *pd,
+                     const double *coords, const int *points, int num, int *sign);
+
+/************************************************************************
+* 功能描述：批量外接圆判断：sign[i] = ComIncircle(pa, pb, pc, coords + 2·points[i])，
+*           coords 为二维点坐标（如模型面参数域 (u,v)）
+* 返回值：int - 回退精确计算的查询个数
+* 作者：邓龙威
+/************************************************************************/
+int ComIncircleBatch(const double *pa, const double *pb, const double *pc,
+                     const double *coords, const int *points, int num, int *sign);
+
+/************************************************************************
+* 功能描述：批量二维方向判断：sign[i] = ComOrient2d(coords + 2·tris[3i], ...)，
+*           用于参数域三角形的翻转检查
+* 返回值：int - 回退精确计算的三角形个数
+* 作者：邓龙威
+/************************************************************************/
+int ComOrient2dBatch(const double *coords, const int *tris, int triNum, int *sign);
+
+#endif // EMMPMESH_COMMON_COMPREDICATES_H_
@@ -0,0 +1,313 @@
+#include "pch.h"
+
+#include "ComReduce.h"
+#include "ComOptiTelemetry.h"
+#include "ComParallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+
+// 各块结果按固定二叉树两两合并
+static double ComTreeCombine(std::vector<double> &partial)
+{
+    if (partial.empty())
+        return 0.;
+    size_t n = partial.size();
+    while (n > 1)
+    {
+        size_t half = (n + 1) / 2;
+        for (size_t i = 0; i < n / 2; ++i)
+            partial[i] = partial[2 * i] + partial[2 * i + 1];
+        if (n % 2 == 1)
+            partial[n / 2] = partial[n - 1];
+        n = half;
+    }
+    return partial[0];
+}
+
+// 对每个固定分块计算 func 映射后的补偿和，再做树形合并
+template <typename Func>
+static double ComBlockReduce(const double *x, int n, int threadNum, Func func)
+{
+    int blockNum = (n + ComReduceBlock - 1) / ComReduceBlock;
+    std::vector<double> partial(blockNum, 0.);
+    ComParallelFor(0, blockNum, threadNum, [&](int, int first, int last) {
+        for (int b = first; b < last; ++b)
+        {
+            NeumaierSum s;
+            int end = std::min(n, (b + 1) * ComReduceBlock);
+            for (int i = b * ComReduceBlock; i < end; ++i)
+                s.add(func(x[i]));
+            partial[b] = s.value();
+        }
+    });
+    return ComTreeCombine(partial);
+}
+
+// 非确定性归约：每个线程直接累加 ComParallelFor 分给它的一段，再按线程顺序合并
+template <typename Func>
+static double ComPlainReduce(const double *x, int n, int threadNum, Func func)
+{
+    if (n <= 0)
+        return 0.;
+    threadNum = ComThreadNum(threadNum);
+    std::vector<double> partial(threadNum, 0.);
+    ComParallelFor(0, n, threadNum, [&](int t, int first, int last) {
+        double s = 0.;
+        for (int i = first; i < last; ++i)
+            s += func(x[i]);
+        partial[t] = s;
+    });
+    double sum = 0.;
+    for (double s : partial)
+        sum += s;
+    return sum;
+}
+
+double ComDeterministicSum(const double *x, int n, int threadNum)
+{
+    return ComBlockReduce(x, n, threadNum, [](double v) { return v; });
+}
+
+double ComDeterministicPowSum(const double *x, int n, double p, int threadNum)
+{
+    if (p == 2.)
+        return ComBlockReduce(x, n, threadNum, [](double v) { return v * v; });
+    return ComBlockReduce(x, n, threadNum, [p](double v) { return std::pow(std::fabs(v), p); });
+}
+
+QualityStat ComDeterministicQualityStat(const double *quality, int n, double badQuality, int threadNum)
+{
+    QualityStat stat;
+    stat.count_ = n;
+    if (n <= 0)
+        return stat;
+
+    // 最小值、最大值与计数本身与顺序无关，按块计算后合并
+    int blockNum = (n + ComReduceBlock - 1) / ComReduceBlock;
+    std::vector<double> minB(blockNum), maxB(blockNum);
+    std::vector<int> badB(blockNum, 0);
+    ComParallelFor(0, blockNum, threadNum, [&](int, int first, int last) {
+        for (int b = first; b < last; ++b)
+        {
+            int begin = b * ComReduceBlock;
+            int end = std::min(n, begin + ComReduceBlock);
+            double mn = quality[begin], mx = quality[begin];
+            int bad = 0;
+            for (int i = begin; i < end; ++i)
+            {
+                mn = std::min(mn, quality[i]);
+                mx = std::max(mx, quality[i]);
+                bad += quality[i] < badQuality ? 1 : 0;
+            }
+            minB[b] = mn;
+            maxB[b] = mx;
+            badB[b] = bad;
+        }
+    });
+
+    stat.min_ = *std::min_element(minB.begin(), minB.end());
+    stat.max_ = *std::max_element(maxB.begin(), maxB.end());
+    for (int bad : badB)
+        stat.badNum_ += bad;
+    stat.mean_ = ComDeterministicSum(quality, n, threadNum) / n;
+    return stat;
+}
+
+double ComReduceSum(const double *x, int n, int threadNum, bool deterministic)
+{
+    if (deterministic)
+        return ComDeterministicSum(x, n, threadNum);
+    return ComPlainReduce(x, n, threadNum, [](double v) { return v; });
+}
+
+double ComReducePowSum(const double *x, int n, double p, int threadNum, bool deterministic)
+{
+    if (deterministic)
+        return ComDeterministicPowSum(x, n, p, threadNum);
+    if (p == 2.)
+        return ComPlainReduce(x, n, threadNum, [](double v) { return v * v; });
+    return ComPlainReduce(x, n, threadNum, [p](double v) { return std::pow(std::fabs(v), p); });
+}
+
+QualityStat ComReduceQualityStat(const double *quality, int n, double badQuality, int threadNum, bool deterministic)
+{
+    if (deterministic || n <= 0)
+        return ComDeterministicQualityStat(quality, n, badQuality, threadNum);
+
+    // 最小值、最大值与计数与顺序无关，只有均值的求和随线程数变化
+    threadNum = ComThreadNum(threadNum);
+    std::vector<double> minT(threadNum, quality[0]), maxT(threadNum, quality[0]), sumT(threadNum, 0.);
+    std::vector<int> badT(threadNum, 0);
+    ComParallelFor(0, n, threadNum, [&](int t, int first, int last) {
+        double mn = quality[first], mx = quality[first], s = 0.;
+        int bad = 0;
+        for (int i = first; i < last; ++i)
+        {
+            mn = std::min(mn, quality[i]);
+            mx = std::max(mx, quality[i]);
+            s += quality[i];
+            bad += quality[i] < badQuality ? 1 : 0;
+        }
+        minT[t] = mn;
+        maxT[t] = mx;
+        sumT[t] = s;
+        badT[t] = bad;
+    });
+
+    QualityStat stat;
+    stat.count_ = n;
+    stat.min_ = *std::min_element(minT.begin(), minT.end());
+    stat.max_ = *std::max_element(maxT.begin(), maxT.end());
+    double sum = 0.;
+    for (int t = 0; t < threadNum; ++t)
+    {
+        sum += sumT[t];
+        stat.badNum_ += badT[t];
+    }
+    stat.mean_ = sum / n;
+    return stat;
+}
+
+void DeterministicScatter::build(const int *elems, int elemNum, int vertPerElem, int vertNum)
+{
+    vertNum_ = vertNum;
+    offset_.assign(vertNum + 1, 0);
+    for (int e = 0; e < elemNum * vertPerElem; ++e)
+        ++offset_[elems[e] + 1];
+    for (int v = 0; v < vertNum; ++v)
+        offset_[v + 1] += offset_[v];
+
+    // 按单元编号升序填充，保证每个顶点的累加顺序固定
+    slot_.resize(offset_[vertNum]);
+    std::vector<int> cursor(offset_.begin(), offset_.end() - 1);
+    for (int e = 0; e < elemNum * vertPerElem; ++e)
+        slot_[cursor[elems[e]]++] = e;
+}
+
+void DeterministicScatter::scatter(const double *elemGrad, double *vertGrad, int threadNum) const
+{
+    ComParallelFor(0, vertNum_, threadNum, [&](int, int first, int last) {
+        for (int v = first; v < last; ++v)
+        {
+            double g[3] = {0., 0., 0.};
+            for (int i = offset_[v]; i < offset_[v + 1]; ++i)
+            {
+                const double *src = elemGrad + 3 * static_cast<size_t>(slot_[i]);
+                g[0] += src[0];
+                g[1] += src[1];
+                g[2] += src[2];
+            }
+            vertGrad[3 * v] = g[0];
+            vertGrad[3 * v + 1] = g[1];
+            vertGrad[3 * v + 2] = g[2];
+        }
+    });
+}
+
+ReduceBenchResult ComReduceBench(int n, int threadNum, int repeat, unsigned int seed)
+{
+    ReduceBenchResult result;
+    result.n_ = n;
+    result.threadNum_ = ComThreadNum(threadNum);
+    result.repeat_ = std::max(1, repeat);
+    if (n <= 0)
+        return result;
+    threadNum = result.threadNum_;
+
+    // 正负混合、量级跨度 1e-6 ~ 1e6 的数据，使求和顺序对结果有可见影响
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(-6., 6.);
+    std::vector<double> x(n);
+    for (double &v : x)
+        v = std::pow(10., uni(rng)) * (rng() % 2 ? 1. : -1.);
+    int vertNum = std::max(4, n / 6);
+    std::vector<int> tets(4 * static_cast<size_t>(n));
+    for (int &v : tets)
+        v = static_cast<int>(rng() % static_cast<unsigned int>(vertNum));
+    std::vector<double> elemGrad(12 * static_cast<size_t>(n));
+    for (size_t i = 0; i < elemGrad.size(); ++i)
+        elemGrad[i] = x[i % n];
+
+    auto clock = std::chrono::steady_clock::now();
+    auto lap = [&clock]() {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - clock).count();
+        clock = now;
+        return seconds;
+    };
+
+    // 1. 求和
+    double naive = 0., det = 0.;
+    lap();
+    for (int r = 0; r < result.repeat_; ++r)
+        naive = ComReduceSum(x.data(), n, threadNum, false);
+    result.naiveSumSeconds_ = lap();
+    for (int r = 0; r < result.repeat_; ++r)
+        det = ComDeterministicSum(x.data(), n, threadNum);
+    result.detSumSeconds_ = lap();
+    result.sumDiff_ = naive - det;
+    double serial = ComDeterministicSum(x.data(), n, 1);
+    result.sumReproducible_ = std::memcmp(&serial, &det, sizeof(double)) == 0;
+
+    // 2. 梯度散射
+    std::vector<double> vertGrad(3 * static_cast<size_t>(vertNum));
+    std::unique_ptr<std::atomic<double>[]> atomicGrad(new std::atomic<double>[3 * static_cast<size_t>(vertNum)]);
+    lap();
+    for (int r = 0; r < result.repeat_; ++r)
+    {
+        for (int i = 0; i < 3 * vertNum; ++i)
+            atomicGrad[i].store(0., std::memory_order_relaxed);
+        ComParallelFor(0, n, threadNum, [&](int, int first, int last) {
+            for (int e = first; e < last; ++e)
+            {
+                for (int j = 0; j < 12; ++j)
+                {
+                    std::atomic<double> &dst = atomicGrad[3 * tets[4 * static_cast<size_t>(e) + j / 3] + j % 3];
+                    double old = dst.load(std::memory_order_relaxed);
+                    double src = elemGrad[12 * static_cast<size_t>(e) + j];
+                    while (!dst.compare_exchange_weak(old, old + src, std::memory_order_relaxed))
+                        ;
+                }
+            }
+        });
+    }
+    result.naiveScatterSeconds_ = lap();
+
+    DeterministicScatter scatter;
+    scatter.build(tets.data(), n, 4, vertNum);
+    result.buildSeconds_ = lap();
+    for (int r = 0; r < result.repeat_; ++r)
+        scatter.scatter(elemGrad.data(), vertGrad.data(), threadNum);
+    result.detScatterSeconds_ = lap();
+    std::vector<double> serialGrad(vertGrad.size());
+    scatter.scatter(elemGrad.data(), serialGrad.data(), 1);
+    result.scatterReproducible_ = std::memcmp(serialGrad.data(), vertGrad.data(), vertGrad.size() * sizeof(double)) == 0;
+    return result;
+}
+
+std::string ComReduceBenchToString(const ReduceBenchResult &result, LogFileFormat format)
+{
+    auto ratio = [](double a, double b) { return b > 0. ? a / b : 0.; };
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"n", ComTelemetryValue(result.n_)},
+        {"threads", ComTelemetryValue(result.threadNum_)},
+        {"repeat", ComTelemetryValue(result.repeat_)},
+        {"naiveSumSeconds", ComTelemetryValue(result.naiveSumSeconds_)},
+        {"detSumSeconds", ComTelemetryValue(result.detSumSeconds_)},
+        {"sumOverhead", ComTelemetryValue(ratio(result.detSumSeconds_, result.naiveSumSeconds_))},
+        {"naiveScatterSeconds", ComTelemetryValue(result.naiveScatterSeconds_)},
+        {"detScatterSeconds", ComTelemetryValue(result.detScatterSeconds_)},
+        {"scatterOverhead", ComTelemetryValue(ratio(result.detScatterSeconds_, result.naiveScatterSeconds_))},
+        {"buildSeconds", ComTelemetryValue(result.buildSeconds_)},
+        {"sumDiff", ComTelemetryValue(result.sumDiff_)},
+        {"sumReproducible", result.sumReproducible_ ? "true" : "false"},
+        {"scatterReproducible", result.scatterReproducible_ ? "true" : "false"},
+    };
+    return ComTelemetryFields(fields, format);
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComReduce.h
+// 摘    要：确定性并行归约，结果与线程数无关（逐位一致）
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMREDUCE_H_
+#define EMMPMESH_COMMON_COMREDUCE_H_
+
+#include "ComConstants.h"
+
+#include <string>
+#include <vector>
+
+// 确定性归约的固定分块大小：分块只取决于数据长度，与线程数无关
+inline const int ComReduceBlock = 4096;
+
+// Neumaier 补偿求和
+struct NeumaierSum
+{
+    double sum_ = 0.;  // 累加和
+    double comp_ = 0.; // 补偿项
+
+    void add(double x)
+    {
+        double t = sum_ + x;
+        if ((sum_ >= 0. ? sum_ : -sum_) >= (x >= 0. ? x : -x))
+            comp_ += (sum_ - t) + x;
+        else
+            comp_ += (x - t) + sum_;
+        sum_ = t;
+    }
+
+    double value() const { return sum_ + comp_; }
+};
+
+/************************************************************************
+* 功能描述：确定性求和。按固定分块做补偿求和，各块结果再按固定二叉树两两合并，
+*           因此结果只取决于数据本身，与线程数及调度顺序无关
+* 返回值：double - Σ x[i]
+* 作者：邓龙威
+/************************************************************************/
+double ComDeterministicSum(const double *x, int n, int threadNum);
+
+/************************************************************************
+* 功能描述：确定性 p 次幂和 Σ |x[i]|^p（用于 CalculateWay::P_NORM / P_NORM_LIMIT）
+* 返回值：double
+* 作者：邓龙威
+/************************************************************************/
+double ComDeterministicPowSum(const double *x, int n, double p, int threadNum);
+
+// 网格质量统计量
+struct QualityStat
+{
+    double min_ = 0.;  // 最小值
+    double max_ = 0.;  // 最大值
+    double mean_ = 0.; // 平均值
+    int count_ = 0;    // 个数
+    int badNum_ = 0;   // 低于阈值的个数
+};
+
+/************************************************************************
+* 功能描述：确定性质量统计（最小 / 最大 / 平均 / 劣质个数）
+* 返回值：QualityStat
+* 作者：邓龙威
+/************************************************************************/
+QualityStat ComDeterministicQualityStat(const double *quality, int n, double badQuality, int threadNum);
+
+/************************************************************************
+* 功能描述：按 deterministic（MeshOptiOptions::deterministic_）选择归约方式：为 true 时同
+*           ComDeterministicSum / ComDeterministicPowSum / ComDeterministicQualityStat；为 false 时
+*           每个线程直接累加连续的一段、再按线程顺序合并，开销更低，但结果随线程数变化
+* 返回值：double / QualityStat
+* 作者：邓龙威
+/************************************************************************/
+double ComReduceSum(const double *x, int n, int threadNum, bool deterministic);
+double ComReducePowSum(const double *x, int n, double p, int threadNum, bool deterministic);
+QualityStat ComReduceQualityStat(const double *quality, int n, double badQuality, int threadNum, bool deterministic);
+
+// 确定性梯度散射：单元梯度按单元编号顺序累加到顶点，避免原子加法带来的顺序不确定
+class DeterministicScatter
+{
+public:
+    DeterministicScatter() = default;
+
+    /************************************************************************
+    * 功能描述：建立顶点 -> (单元, 局部顶点) 的 CSR 关联表，按单元编号升序排列
+    *           elems 为 elemNum 个单元，每个单元 vertPerElem 个顶点编号
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void build(const int *elems, int elemNum, int vertPerElem, int vertNum);
+
+    /************************************************************************
+    * 功能描述：散射单元梯度 elemGrad（elemNum * vertPerElem * 3）到顶点梯度 vertGrad（vertNum * 3），
+    *           按顶点划分并行，每个顶点的累加顺序固定
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void scatter(const double *elemGrad, double *vertGrad, int threadNum) const;
+
+private:
+    int vertNum_ = 0;         // 顶点个数
+    std::vector<int> offset_; // CSR 偏移
+    std::vector<int> slot_;   // elem * vertPerElem + local，即 elemGrad 中的槽位
+};
+
+// 确定性归约与非确定性归约的开销对比结果
+struct ReduceBenchResult
+{
+    int n_ = 0;                        // 数据个数（求和）/ 单元个数（散射）
+    int threadNum_ = 0;                // 线程数
+    int repeat_ = 0;                   // 重复次数
+    double naiveSumSeconds_ = 0.;      // 非确定性求和耗时（每线程直接累加，按线程顺序合并）
+    double detSumSeconds_ = 0.;        // ComDeterministicSum 耗时
+    double naiveScatterSeconds_ = 0.;  // 非确定性散射耗时（按单元划分，原子加法）
+    double detScatterSeconds_ = 0.;    // DeterministicScatter::scatter 耗时（不含 build）
+    double buildSeconds_ = 0.;         // DeterministicScatter::build 耗时
+    double sumDiff_ = 0.;              // 非确定性求和与确定性求和之差
+    bool sumReproducible_ = false;     // 确定性求和在 1 个线程与 threadNum 个线程下是否逐位一致
+    bool scatterReproducible_ = false; // 确定性散射在 1 个线程与 threadNum 个线程下是否逐位一致
+};
+
+/************************************************************************
+* 功能描述：以 seed 生成 n 个正负混合、量级跨度大的随机数与 n 个随机四面体（顶点数 n / 6），
+*           分别以非确定性与确定性方式求和、散射单元梯度，重复 repeat 次计时，
+*           并检查确定性结果在单线程与 threadNum 个线程下是否逐位一致
+* 返回值：ReduceBenchResult
+* 作者：邓龙威
+/************************************************************************/
+ReduceBenchResult ComReduceBench(int n, int threadNum, int repeat = 10, unsigned int seed = 0);
+
+/************************************************************************
+* 功能描述：将测试结果格式化为一行（Json / Logfmt，Text 同 Logfmt），字段含各项耗时、
+*           sumOverhead / scatterOverhead（确定性相对非确定性的耗时比）与逐位一致检查
+* 返回值：std::string
+* 作者：邓龙威
+/************************************************************************/
+std::string ComReduceBenchToString(const ReduceBenchResult &result, LogFileFormat format);
+
+#endif // EMMPMESH_COMMON_COMREDUCE_H_
@@ -0,0 +1,346 @@
+#include "pch.h"
+
+#include "ComRemeshCache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+static const char ComRemeshMagic[8] = {'E', 'M', 'R', 'M', 'S', 'H', 'C', '1'};
+static const uint32_t ComRemeshVersion = 1;
+
+// 读取文件头并校验指纹，文件不存在返回 1，格式错误或指纹不一致返回 2
+static int ComReadHeader(std::ifstream &file, uint64_t key)
+{
+    if (!file.is_open())
+        return 1;
+    char magic[8];
+    uint32_t version = 0;
+    uint64_t fileKey = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, ComRemeshMagic, sizeof(magic)) != 0 ||
+        !file.read(reinterpret_cast<char *>(&version), sizeof(version)) || version != ComRemeshVersion ||
+        !file.read(reinterpret_cast<char *>(&fileKey), sizeof(fileKey)) || fileKey != key)
+        return 2;
+    return 0;
+}
+
+// 读取文件头之后的数组部分，内存不足或长度异常同样视为文件损坏，按未命中处理
+template <typename Reader>
+static bool ComReadCacheArrays(Reader read)
+{
+    try
+    {
+        return read();
+    }
+    catch (const std::bad_alloc &)
+    {
+        return false;
+    }
+    catch (const std::length_error &)
+    {
+        return false;
+    }
+}
+
+static void ComWriteHeader(std::ofstream &file, uint64_t key)
+{
+    file.write(ComRemeshMagic, sizeof(ComRemeshMagic));
+    file.write(reinterpret_cast<const char *>(&ComRemeshVersion), sizeof(ComRemeshVersion));
+    file.write(reinterpret_cast<const char *>(&key), sizeof(key));
+}
+
+// 写入缓存文件：先写入本线程的临时文件再改名，同一指纹被多个线程同时写入时结果仍然完整
+template <typename Writer>
+static int ComWriteCacheFile(const std::string &target, uint64_t key, Writer write)
+{
+    std::ostringstream suffix;
+    suffix << ".tmp" << std::this_thread::get_id();
+    std::string temp = target + suffix.str();
+    {
+        std::ofstream file(temp, std::ios::binary);
+        if (!file.is_open())
+            return 1;
+        ComWriteHeader(file, key);
+        write(file);
+        if (!file.good())
+            return 1;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, target, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp, ec);
+        return 1;
+    }
+    return 0;
+}
+
+int RemeshCache::open(const std::string &dir)
+{
+    dir_ = dir;
+    manifest_.clear();
+    current_.clear();
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    if (!std::filesystem::is_directory(dir_, ec))
+        return 1;
+
+    std::ifstream file(dir_ + "/manifest.txt");
+    std::string line;
+    while (std::getline(file, line))
+    {
+        // 损坏的行（编号或指纹无法完整解析）跳过，对应模型面按未缓存处理
+        std::istringstream iss(line);
+        int faceID;
+        std::string hex;
+        if (!(iss >> faceID >> hex) || hex[0] == '-')
+            continue;
+        char *end = nullptr;
+        errno = 0;
+        unsigned long long key = std::strtoull(hex.c_str(), &end, 16);
+        if (errno == 0 && end != hex.c_str() && *end == '\0')
+            manifest_[faceID] = key;
+    }
+    return 0;
+}
+
+uint64_t RemeshCache::optionsKey(const MeshGenerationOptions &opts)
+{
+    uint64_t h = ComFnvValue(ComRemeshVersion);
+    const AdaptiveMeshOptions &a = opts.adaptiveMeshOptions_;
+    h = ComFnvValue(a.sampleSize_, h);
+    h = ComFnvValue(a.curvatureAngle_, h);
+    h = ComFnvValue(a.minSize_, h);
+    h = ComFnvValue(a.maxSize_, h);
+    h = ComFnvValue(a.refinementFactor_, h);
+    h = ComFnvValue(a.ratioFactor_, h);
+    h = ComFnvValue(a.selfAdaption_, h);
+    h = ComFnvValue(a.highCurvatureSampling_, h);
+    h = ComFnvValue(a.octreeMaxDepth_, h);
+    const EdgeMeshGenerationOptions &e = opts.edgeMeshGenerationOptions_;
+    h = ComFnvValue(e.tableSegmentNum_, h);
+    h = ComFnvValue(e.maxTableSegmentNum_, h);
+    h = ComFnvValue(e.tableTolerance_, h);
+    h = ComFnvValue(e.tableMaxTurnAngle_, h);
+    h = ComFnvValue(e.curvatureSizing_, h);
+    h = ComFnvValue(e.minSegmentNum_, h);
+    const SurfMeshGenerationOptions &s = opts.surfMeshGenerationOptions_;
+    h = ComFnvValue(s.selfAdaption_, h);
+    h = ComFnvValue(s.meshOptimization_, h);
+    h = ComFnvValue(s.efficiency_, h);
+    return h;
+}
+
+uint64_t RemeshCache::geometryKey(const double *samples, size_t num, uint64_t h)
+{
+    for (size_t i = 0; i < num; ++i)
+    {
+        double v = samples[i] == 0. ? 0. : samples[i];
+        h = ComFnvValue(v, h);
+    }
+    return h;
+}
+
+uint64_t RemeshCache::edgeKey(uint64_t geomKey, uint64_t optionsKey)
+{
+    uint64_t h = ComFnv1a("edge", 4);
+    h = ComFnvValue(geomKey, h);
+    return ComFnvValue(optionsKey, h);
+}
+
+uint64_t RemeshCache::faceKey(uint64_t geomKey, uint64_t optionsKey, const FaceBoundary &boundary)
+{
+    uint64_t h = ComFnv1a("face", 4);
+    h = ComFnvValue(geomKey, h);
+    h = ComFnvValue(optionsKey, h);
+    for (int s : boundary.loopStart_)
+        h = ComFnvValue(s, h);
+    return geometryKey(boundary.coords_.data(), boundary.coords_.size(), h);
+}
+
+std::string RemeshCache::path(uint64_t key, const char *ext) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return dir_ + "/" + name + ext;
+}
+
+bool RemeshCache::loadEdge(uint64_t key, EdgeDiscretization &out)
+{
+    std::ifstream file(path(key, ".emesh"), std::ios::binary);
+    int status = ComReadHeader(file, key);
+    EdgeDiscretization disc;
+    if (status == 0 && ComReadCacheArrays([&]() {
+            return ComReadArray(file, disc.coords_) && ComReadArray(file, disc.tParam_) &&
+                   disc.coords_.size() == 3 * disc.tParam_.size();
+        }))
+    {
+        out = std::move(disc);
+        ++edgeHitNum_;
+        return true;
+    }
+    if (status != 1)
+        ++failNum_;
+    ++edgeMissNum_;
+    return false;
+}
+
+int RemeshCache::storeEdge(uint64_t key, const EdgeDiscretization &disc)
+{
+    int status = ComWriteCacheFile(path(key, ".emesh"), key, [&](std::ofstream &file) {
+        ComWriteArray(file, disc.coords_);
+        ComWriteArray(file, disc.tParam_);
+    });
+    if (status == 0)
+        ++storeNum_;
+    else
+        ++failNum_;
+    return status;
+}
+
+bool RemeshCache::loadFace(uint64_t key, FaceMeshResult &out)
+{
+    std::ifstream file(path(key, ".fmesh"), std::ios::binary);
+    int status = ComReadHeader(file, key);
+    FaceMeshResult result;
+    if (status == 0 && ComReadCacheArrays([&]() {
+            return ComReadArray(file, result.coords_) && ComReadArray(file, result.tris_) &&
+                   result.coords_.size() % 3 == 0 && result.tris_.size() % 3 == 0;
+        }))
+    {
+        out = std::move(result);
+        ++faceHitNum_;
+        return true;
+    }
+    if (status != 1)
+        ++failNum_;
+    ++faceMissNum_;
+    return false;
+}
+
+int RemeshCache::storeFace(uint64_t key, const FaceMeshResult &result)
+{
+    int status = ComWriteCacheFile(path(key, ".fmesh"), key, [&](std::ofstream &file) {
+        ComWriteArray(file, result.coords_);
+        ComWriteArray(file, result.tris_);
+    });
+    if (status == 0)
+        ++storeNum_;
+    else
+        ++failNum_;
+    return status;
+}
+
+void RemeshCache::recordFace(int faceID, uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_[faceID] = key;
+}
+
+std::vector<int> RemeshCache::changedFaces() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> changed;
+    for (const auto &c : current_)
+    {
+        auto it = manifest_.find(c.first);
+        if (it == manifest_.end() || it->second != c.second)
+            changed.push_back(c.first);
+    }
+    for (const auto &m : manifest_)
+    {
+        if (!current_.count(m.first))
+            changed.push_back(m.first);
+    }
+    std::sort(changed.begin(), changed.end());
+    return changed;
+}
+
+int RemeshCache::saveManifest()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ofstream file(dir_ + "/manifest.txt");
+    if (!file.is_open())
+        return 1;
+    char hex[32];
+    for (const auto &c : current_)
+    {
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(c.second));
+        file << c.first << " " << hex << "\n";
+    }
+    if (!file.good())
+        return 1;
+    manifest_ = current_;
+    return 0;
+}
+
+ComEdgeDiscretize RemeshCache::cachedEdgeDiscretize(const std::vector<uint64_t> &edgeGeomKeys, uint64_t optionsKey,
+                                                    const ComEdgeDiscretize &inner)
+{
+    return [this, &edgeGeomKeys, optionsKey, inner](int edgeId, EdgeDiscretization &out) {
+        uint64_t geomKey = edgeId >= 0 && edgeId < static_cast<int>(edgeGeomKeys.size()) ? edgeGeomKeys[edgeId] : 0;
+        uint64_t key = edgeKey(geomKey, optionsKey);
+        if (loadEdge(key, out))
+            return true;
+        if (!inner(edgeId, out))
+            return false;
+        storeEdge(key, out);
+        return true;
+    };
+}
+
+ComFaceMesher RemeshCache::cachedFaceMesher(const std::vector<uint64_t> &faceGeomKeys, uint64_t optionsKey,
+                                            const ComFaceMesher &inner)
+{
+    return [this, &faceGeomKeys, optionsKey, inner](int faceId, const FaceBoundary &boundary, FaceMeshResult &out) {
+        uint64_t geomKey = faceId >= 0 && faceId < static_cast<int>(faceGeomKeys.size()) ? faceGeomKeys[faceId] : 0;
+        uint64_t key = faceKey(geomKey, optionsKey, boundary);
+        recordFace(faceId, key);
+        if (loadFace(key, out))
+            return true;
+        if (!inner(faceId, boundary, out))
+            return false;
+        storeFace(key, out);
+        return true;
+    };
+}
+
+std::vector<int> RemeshCache::affectedRegions(const std::vector<std::vector<int>> &regionFaces,
+                                              const std::vector<int> &changedFaces)
+{
+    std::set<int> changed(changedFaces.begin(), changedFaces.end());
+    std::vector<int> regions;
+    for (size_t r = 0; r < regionFaces.size(); ++r)
+    {
+        for (int f : regionFaces[r])
+        {
+            if (changed.count(f))
+            {
+                regions.push_back(static_cast<int>(r));
+                break;
+            }
+        }
+    }
+    return regions;
+}
+
+RemeshCacheStat RemeshCache::stat() const
+{
+    RemeshCacheStat s;
+    s.faceHitNum_ = faceHitNum_;
+    s.faceMissNum_ = faceMissNum_;
+    s.edgeHitNum_ = edgeHitNum_;
+    s.edgeMissNum_ = edgeMissNum_;
+    s.storeNum_ = storeNum_;
+    s.failNum_ = failNum_;
+    return s;
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComRemeshCache.h
+// 摘    要：增量网格生成缓存：以 FNV-1a 指纹标识模型边 / 面的几何、边界与生成选项，
+//           离散结果按指纹持久化到缓存目录，模型修订后只重新生成指纹变化的模型边 / 面，
+//           并给出需要重新生成体网格的模型体
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMREMESHCACHE_H_
+#define EMMPMESH_COMMON_COMREMESHCACHE_H_
+
+#include "ComBinaryIO.h"
+#include "ComConstants.h"
+#include "ComSurfParallel.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 缓存统计
+struct RemeshCacheStat
+{
+    long long faceHitNum_ = 0;  // 模型面命中次数
+    long long faceMissNum_ = 0; // 模型面未命中次数
+    long long edgeHitNum_ = 0;  // 模型边命中次数
+    long long edgeMissNum_ = 0; // 模型边未命中次数
+    long long storeNum_ = 0;    // 写入文件个数
+    long long failNum_ = 0;     // 读写失败次数（按未命中处理）
+};
+
+// 增量网格生成缓存。文件名为 16 位十六进制指纹加扩展名（模型边 .emesh，模型面 .fmesh），
+// 与模型边 / 面编号无关；manifest.txt 记录上次生成时各模型面的指纹，用于判断哪些模型面发生了变化。
+// load / store 可由多个线程同时调用
+class RemeshCache
+{
+public:
+    RemeshCache() = default;
+
+    /************************************************************************
+    * 功能描述：打开缓存目录（不存在时创建）并读取上次的 manifest
+    * 返回值：0 表示成功，非 0 表示失败（1-目录无法创建）
+    * 作者：邓龙威
+    /************************************************************************/
+    int open(const std::string &dir);
+
+    /************************************************************************
+    * 功能描述：影响网格的生成选项的指纹：AdaptiveMeshOptions 的尺寸参数、
+    *           EdgeMeshGenerationOptions 的建表与布点参数、SurfMeshGenerationOptions 的生成开关；
+    *           线程数与缓存路径不参与
+    * 返回值：uint64_t
+    * 作者：邓龙威
+    /************************************************************************/
+    static uint64_t optionsKey(const MeshGenerationOptions &opts);
+
+    /************************************************************************
+    * 功能描述：几何采样（如模型边弧长表坐标、模型面采样点）的指纹，-0 与 +0 视为相同
+    * 返回值：uint64_t
+    * 作者：邓龙威
+    /************************************************************************/
+    static uint64_t geometryKey(const double *samples, size_t num, uint64_t h = ComFnvOffset);
+
+    /************************************************************************
+    * 功能描述：模型边指纹 = H(几何指纹, 选项指纹)；模型面指纹 = H(几何指纹, 选项指纹, 边界)，
+    *           边界（各环顶点坐标）相同时缓存的局部编号三角形仍然有效
+    * 返回值：uint64_t
+    * 作者：邓龙威
+    /************************************************************************/
+    static uint64_t edgeKey(uint64_t geomKey, uint64_t optionsKey);
+    static uint64_t faceKey(uint64_t geomKey, uint64_t optionsKey, const FaceBoundary &boundary);
+
+    /************************************************************************
+    * 功能描述：按指纹读取 / 写入模型边离散结果与模型面剖分结果。
+    *           写入先写临时文件再改名，读写失败计入 failNum_
+    * 返回值：load 返回是否命中；store 返回 0 表示成功，非 0 表示失败
+    * 作者：邓龙威
+    /************************************************************************/
+    bool loadEdge(uint64_t key, EdgeDiscretization &out);
+    int storeEdge(uint64_t key, const EdgeDiscretization &disc);
+    bool loadFace(uint64_t key, FaceMeshResult &out);
+    int storeFace(uint64_t key, const FaceMeshResult &result);
+
+    /************************************************************************
+    * 功能描述：记录模型面 faceID 本次的指纹（由 cachedFaceMesher 自动调用）
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void recordFace(int faceID, uint64_t key);
+
+    /************************************************************************
+    * 功能描述：本次记录的模型面中指纹与 manifest 不同（或为新增）的模型面，以及
+    *           manifest 中有而本次未记录的（已删除的）模型面，升序
+    * 返回值：std::vector<int>
+    * 作者：邓龙威
+    /************************************************************************/
+    std::vector<int> changedFaces() const;
+
+    /************************************************************************
+    * 功能描述：以本次记录的指纹覆盖 manifest 并写入缓存目录
+    * 返回值：0 表示成功，非 0 表示失败
+    * 作者：邓龙威
+    /************************************************************************/
+    int saveManifest();
+
+    /************************************************************************
+    * 功能描述：包装模型边离散 / 模型面剖分回调：先按指纹查找缓存，未命中时调用 inner 并写入缓存。
+    *           edgeGeomKeys / faceGeomKeys 按模型边 / 面编号给出几何指纹（模型边的几何指纹应同时
+    *           包含其所在区域的尺寸场信息），optionsKey 见 optionsKey。
+    *           返回的回调可直接传给 ComParallelSurfMesh，调用期间 cache 与指纹数组须保持有效
+    * 返回值：ComEdgeDiscretize / ComFaceMesher
+    * 作者：邓龙威
+    /************************************************************************/
+    ComEdgeDiscretize cachedEdgeDiscretize(const std::vector<uint64_t> &edgeGeomKeys, uint64_t optionsKey,
+                                           const ComEdgeDiscretize &inner);
+    ComFaceMesher cachedFaceMesher(const std::vector<uint64_t> &faceGeomKeys, uint64_t optionsKey,
+                                   const ComFaceMesher &inner);
+
+    /************************************************************************
+    * 功能描述：需要重新生成体网格的模型体：regionFaces[r] 为模型体 r 的边界模型面，
+    *           含任一变化模型面的模型体需要重新生成，其余模型体的体网格可直接复用
+    * 返回值：std::vector<int> - 模型体编号，升序
+    * 作者：邓龙威
+    /************************************************************************/
+    static std::vector<int> affectedRegions(const std::vector<std::vector<int>> &regionFaces,
+                                            const std::vector<int> &changedFaces);
+
+    RemeshCacheStat stat() const;
+    const std::string &dir() const { return dir_; }
+
+private:
+    std::string path(uint64_t key, const char *ext) const; // 指纹对应的文件路径
+
+    std::string dir_;                        // 缓存目录
+    std::map<int, uint64_t> manifest_;       // 上次生成的模型面指纹
+    std::map<int, uint64_t> current_;        // 本次记录的模型面指纹
+    mutable std::mutex mutex_;               // 保护 current_
+    std::atomic<long long> faceHitNum_{0};   // 模型面命中次数
+    std::atomic<long long> faceMissNum_{0};  // 模型面未命中次数
+    std::atomic<long long> edgeHitNum_{0};   // 模型边命中次数
+    std::atomic<long long> edgeMissNum_{0};  // 模型边未命中次数
+    std::atomic<long long> storeNum_{0};     // 写入文件个数
+    std::atomic<long long> failNum_{0};      // 读写失败次数
+};
+
+#endif // EMMPMESH_COMMON_COMREMESHCACHE_H_
@@ -0,0 +1,431 @@
+#include "pch.h"
+
+#include "ComSizingOctree.h"
+#include "ComBinaryIO.h"
+#include "ComGradation.h"
+#include "ComParallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+double ComCurvatureSize(double curvature, const AdaptiveMeshOptions &opts)
+{
+    if (curvature <= 0.)
+        return opts.maxSize_;
+    double theta = opts.curvatureAngle_ * 3.14159265358979323846 / 180.;
+    double h = 2. / curvature * std::sin(0.5 * theta);
+    return std::max(opts.minSize_, std::min(opts.maxSize_, h));
+}
+
+// 按 sampleSize 抽稀采样点：同一边长为 sampleSize 的网格单元内只保留尺寸最小的采样点（尺寸相同时取编号小者），
+// 保留顺序与输入一致。sampleSize <= 0 或坐标超出整数网格范围时不抽稀，返回 input 本身
+static const std::vector<SizingSample> &ComThinSamples(const std::vector<SizingSample> &input, double sampleSize,
+                                                       std::vector<SizingSample> &thinned)
+{
+    if (!(sampleSize > 0.) || input.size() < 2)
+        return input;
+
+    int num = static_cast<int>(input.size());
+    std::vector<std::array<long long, 3>> cell(num);
+    for (int i = 0; i < num; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            double c = std::floor(input[i].pos_[j] / sampleSize);
+            if (!(std::fabs(c) < 1e15))
+                return input;
+            cell[i][j] = static_cast<long long>(c);
+        }
+    }
+    std::vector<int> order(num);
+    for (int i = 0; i < num; ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        if (cell[a] != cell[b])
+            return cell[a] < cell[b];
+        if (input[a].size_ != input[b].size_)
+            return input[a].size_ < input[b].size_;
+        return a < b;
+    });
+    std::vector<char> keep(num, 0);
+    for (int k = 0; k < num; ++k)
+        keep[order[k]] = k == 0 || cell[order[k]] != cell[order[k - 1]];
+    thinned.clear();
+    for (int i = 0; i < num; ++i)
+    {
+        if (keep[i])
+            thinned.push_back(input[i]);
+    }
+    return thinned;
+}
+
+int SizingOctree::build(const std::vector<SizingSample> &input, const AdaptiveMeshOptions &opts)
+{
+    nodes_.clear();
+    leafNodes_.clear();
+    leafSize_.clear();
+    cornerSize_.clear();
+    minSize_ = opts.minSize_;
+    maxSize_ = opts.maxSize_;
+    threadNum_ = ComThreadNum(opts.sizingThreadNum_);
+    std::vector<SizingSample> thinned;
+    const std::vector<SizingSample> &samples = ComThinSamples(input, opts.sampleSize_, thinned);
+    if (samples.empty())
+        return 0;
+
+    // 节点边长不超过其内最小尺寸的 refinementFactor_ 倍时停止细分，非正值按 1 处理
+    double refine = opts.refinementFactor_ > 0. ? opts.refinementFactor_ : 1.;
+
+    // 根节点：采样点包围盒外扩 maxSize_ 后取立方体
+    double lo[3], hi[3];
+    for (int j = 0; j < 3; ++j)
+    {
+        lo[j] = std::numeric_limits<double>::max();
+        hi[j] = -std::numeric_limits<double>::max();
+    }
+    for (const auto &s : samples)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            lo[j] = std::min(lo[j], s.pos_[j]);
+            hi[j] = std::max(hi[j], s.pos_[j]);
+        }
+    }
+    SizingOctreeNode root;
+    for (int j = 0; j < 3; ++j)
+    {
+        root.center_[j] = 0.5 * (lo[j] + hi[j]);
+        root.half_ = std::max(root.half_, 0.5 * (hi[j] - lo[j]) + maxSize_);
+    }
+    nodes_.push_back(root);
+    minHalf_ = root.half_;
+
+    // 采样点按节点连续存放，range[2i, 2i+1) 为节点 i 的采样点区间
+    int sampleNum = static_cast<int>(samples.size());
+    std::vector<int> order(sampleNum), buffer(sampleNum);
+    for (int i = 0; i < sampleNum; ++i)
+        order[i] = i;
+    std::vector<int> range = {0, sampleNum};
+
+    std::vector<int> frontier = {0};
+    while (!frontier.empty())
+    {
+        int num = static_cast<int>(frontier.size());
+        std::vector<double> minSize(num);
+        std::vector<char> split(num, 0);
+        std::vector<int> childRange(9 * static_cast<size_t>(num));
+
+        // 并行：计算节点内最小尺寸并按卦限划分采样点（各节点区间互不相交）
+        ComParallelFor(0, num, threadNum_, [&](int, int first, int last) {
+            for (int f = first; f < last; ++f)
+            {
+                const SizingOctreeNode &node = nodes_[frontier[f]];
+                int b = range[2 * frontier[f]], e = range[2 * frontier[f] + 1];
+                double h = maxSize_;
+                for (int i = b; i < e; ++i)
+                    h = std::min(h, samples[order[i]].size_);
+                h = std::max(h, minSize_);
+                minSize[f] = h;
+
+                double edge = 2. * node.half_;
+                split[f] = edge > refine * h && edge > minSize_ && node.depth_ < opts.octreeMaxDepth_;
+                if (!split[f])
+                    continue;
+
+                int count[8] = {};
+                auto octant = [&](int s) {
+                    const double *p = samples[s].pos_;
+                    return (p[0] >= node.center_[0] ? 1 : 0) | (p[1] >= node.center_[1] ? 2 : 0) |
+                           (p[2] >= node.center_[2] ? 4 : 0);
+                };
+                for (int i = b; i < e; ++i)
+                    ++count[octant(order[i])];
+                int *cr = childRange.data() + 9 * static_cast<size_t>(f);
+                cr[0] = b;
+                for (int k = 0; k < 8; ++k)
+                    cr[k + 1] = cr[k] + count[k];
+                int pos[8];
+                std::copy(cr, cr + 8, pos);
+                for (int i = b; i < e; ++i)
+                    buffer[pos[octant(order[i])]++] = order[i];
+                std::copy(buffer.begin() + b, buffer.begin() + e, order.begin() + b);
+            }
+        });
+
+        // 串行：分配子节点与叶子
+        std::vector<int> next;
+        for (int f = 0; f < num; ++f)
+        {
+            int id = frontier[f];
+            if (!split[f])
+            {
+                nodes_[id].leaf_ = static_cast<int>(leafNodes_.size());
+                leafNodes_.push_back(id);
+                leafSize_.push_back(minSize[f]);
+                minHalf_ = std::min(minHalf_, nodes_[id].half_);
+                continue;
+            }
+            int child = static_cast<int>(nodes_.size());
+            nodes_[id].child_ = child;
+            SizingOctreeNode parent = nodes_[id];
+            for (int k = 0; k < 8; ++k)
+            {
+                SizingOctreeNode c;
+                c.half_ = 0.5 * parent.half_;
+                for (int j = 0; j < 3; ++j)
+                    c.center_[j] = parent.center_[j] + ((k >> j) & 1 ? c.half_ : -c.half_);
+                c.depth_ = parent.depth_ + 1;
+                nodes_.push_back(c);
+                range.push_back(childRange[9 * static_cast<size_t>(f) + k]);
+                range.push_back(childRange[9 * static_cast<size_t>(f) + k + 1]);
+                next.push_back(child + k);
+            }
+        }
+        frontier.swap(next);
+    }
+
+    // 梯度控制同时更新角点尺寸
+    if (opts.ratioFactor_ > 1.)
+    {
+        GradationStat stat = ComGradeSizingOctree(*this, opts.ratioFactor_, threadNum_);
+        if (sink_)
+            sink_(LogLevel::Perf, ComGradationPerf(stat, logFormat_));
+    }
+    else
+        updateCorners();
+    return leafNum();
+}
+
+void SizingOctree::updateCorners()
+{
+    int leafNum = static_cast<int>(leafNodes_.size());
+    cornerSize_.assign(8 * static_cast<size_t>(leafNum), maxSize_);
+    double eps = 0.5 * minHalf_;
+    const SizingOctreeNode &root = nodes_[0];
+
+    // 角点尺寸取角点周围 8 个探测点所在叶子尺寸的最小值
+    ComParallelFor(0, leafNum, threadNum_, [&](int, int first, int last) {
+        for (int l = first; l < last; ++l)
+        {
+            const SizingOctreeNode &node = nodes_[leafNodes_[l]];
+            for (int k = 0; k < 8; ++k)
+            {
+                double q[3];
+                for (int j = 0; j < 3; ++j)
+                    q[j] = node.center_[j] + ((k >> j) & 1 ? node.half_ : -node.half_);
+                double h = leafSize_[l];
+                for (int m = 0; m < 8; ++m)
+                {
+                    double probe[3];
+                    bool valid = true;
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        probe[j] = q[j] + ((m >> j) & 1 ? eps : -eps);
+                        valid = valid && std::fabs(probe[j] - root.center_[j]) <= root.half_;
+                    }
+                    if (valid)
+                        h = std::min(h, leafSize_[nodes_[descend(probe)].leaf_]);
+                }
+                cornerSize_[8 * static_cast<size_t>(l) + k] = h;
+            }
+        }
+    });
+}
+
+bool SizingOctree::inside(int node, const double p[3]) const
+{
+    const SizingOctreeNode &n = nodes_[node];
+    for (int j = 0; j < 3; ++j)
+    {
+        if (std::fabs(p[j] - n.center_[j]) > n.half_)
+            return false;
+    }
+    return true;
+}
+
+int SizingOctree::descend(const double p[3]) const
+{
+    int node = 0;
+    while (nodes_[node].child_ >= 0)
+    {
+        const SizingOctreeNode &n = nodes_[node];
+        node = n.child_ + ((p[0] >= n.center_[0] ? 1 : 0) | (p[1] >= n.center_[1] ? 2 : 0) |
+                           (p[2] >= n.center_[2] ? 4 : 0));
+    }
+    return node;
+}
+
+int SizingOctree::locate(const double p[3], SizingQueryCache *cache) const
+{
+    if (nodes_.empty())
+        return -1;
+    if (cache && cache->node_ >= 0 && cache->node_ < nodeNum() && nodes_[cache->node_].child_ < 0 &&
+        inside(cache->node_, p))
+    {
+        ++cache->hitNum_;
+        return cache->node_;
+    }
+    int node = descend(p);
+    if (cache)
+    {
+        cache->node_ = node;
+        ++cache->missNum_;
+    }
+    return node;
+}
+
+double SizingOctree::size(const double p[3], SizingQueryCache *cache) const
+{
+    if (nodes_.empty())
+        return maxSize_;
+
+    const SizingOctreeNode &root = nodes_[0];
+    double q[3];
+    for (int j = 0; j < 3; ++j)
+        q[j] = std::max(root.center_[j] - root.half_, std::min(root.center_[j] + root.half_, p[j]));
+
+    const SizingOctreeNode &node = nodes_[locate(q, cache)];
+    const double *corner = cornerSize_.data() + 8 * static_cast<size_t>(node.leaf_);
+    double t[3];
+    for (int j = 0; j < 3; ++j)
+        t[j] = std::max(0., std::min(1., (q[j] - node.center_[j] + node.half_) / (2. * node.half_)));
+
+    double h = 0.;
+    for (int k = 0; k < 8; ++k)
+    {
+        double w = ((k & 1) ? t[0] : 1. - t[0]) * ((k & 2) ? t[1] : 1. - t[1]) * ((k & 4) ? t[2] : 1. - t[2]);
+        h += w * corner[k];
+    }
+    return h;
+}
+
+// 缓存文件格式标识与版本
+static const char ComSizingMagic[8] = {'E', 'M', 'S', 'Z', 'O', 'C', 'T', '1'};
+static const uint32_t ComSizingVersion = 1;
+
+int SizingOctree::save(const std::string &filePath, uint64_t key) const
+{
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+        return 1;
+    file.write(ComSizingMagic, sizeof(ComSizingMagic));
+    file.write(reinterpret_cast<const char *>(&ComSizingVersion), sizeof(ComSizingVersion));
+    file.write(reinterpret_cast<const char *>(&key), sizeof(key));
+    file.write(reinterpret_cast<const char *>(&minSize_), sizeof(minSize_));
+    file.write(reinterpret_cast<const char *>(&maxSize_), sizeof(maxSize_));
+    file.write(reinterpret_cast<const char *>(&minHalf_), sizeof(minHalf_));
+    ComWriteArray(file, nodes_);
+    ComWriteArray(file, leafNodes_);
+    ComWriteArray(file, leafSize_);
+    ComWriteArray(file, cornerSize_);
+    return file.good() ? 0 : 1;
+}
+
+int SizingOctree::load(const std::string &filePath, uint64_t key)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+        return 1;
+
+    char magic[8];
+    uint32_t version = 0;
+    uint64_t fileKey = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, ComSizingMagic, sizeof(magic)) != 0 ||
+        !file.read(reinterpret_cast<char *>(&version), sizeof(version)) || version != ComSizingVersion ||
+        !file.read(reinterpret_cast<char *>(&fileKey), sizeof(fileKey)))
+        return 2;
+    if (fileKey != key)
+        return 3;
+
+    // 内存不足或长度异常同样视为文件损坏
+    SizingOctree tree;
+    tree.threadNum_ = threadNum_;
+    try
+    {
+        if (!file.read(reinterpret_cast<char *>(&tree.minSize_), sizeof(tree.minSize_)) ||
+            !file.read(reinterpret_cast<char *>(&tree.maxSize_), sizeof(tree.maxSize_)) ||
+            !file.read(reinterpret_cast<char *>(&tree.minHalf_), sizeof(tree.minHalf_)) ||
+            !ComReadArray(file, tree.nodes_) || !ComReadArray(file, tree.leafNodes_) ||
+            !ComReadArray(file, tree.leafSize_) || !ComReadArray(file, tree.cornerSize_))
+            return 2;
+    }
+    catch (const std::bad_alloc &)
+    {
+        return 2;
+    }
+    catch (const std::length_error &)
+    {
+        return 2;
+    }
+    if (tree.leafSize_.size() != tree.leafNodes_.size() || tree.cornerSize_.size() != 8 * tree.leafNodes_.size())
+        return 2;
+
+    // 编号检查：保证 descend 只向后下降且不越界，叶子与叶子编号一一对应
+    int nodeNum = tree.nodeNum(), leafNum = tree.leafNum();
+    if (nodeNum == 0 ? leafNum != 0 : leafNum == 0)
+        return 2;
+    for (int i = 0; i < nodeNum; ++i)
+    {
+        const SizingOctreeNode &node = tree.nodes_[i];
+        if (!(node.half_ > 0.))
+            return 2;
+        if (node.child_ >= 0)
+        {
+            if (node.child_ <= i || node.child_ > nodeNum - 8 || node.leaf_ != -1)
+                return 2;
+        }
+        else if (node.child_ != -1 || node.leaf_ < 0 || node.leaf_ >= leafNum || tree.leafNodes_[node.leaf_] != i)
+            return 2;
+    }
+    for (int l = 0; l < leafNum; ++l)
+    {
+        int node = tree.leafNodes_[l];
+        if (node < 0 || node >= nodeNum || tree.nodes_[node].leaf_ != l)
+            return 2;
+    }
+
+    *this = std::move(tree);
+    return 0;
+}
+
+uint64_t SizingOctree::cacheKey(const std::string &modelId, const std::vector<SizingSample> &samples,
+                                const AdaptiveMeshOptions &opts)
+{
+    uint64_t h = ComFnv1a(modelId.data(), modelId.size());
+    h = ComFnvValue(ComSizingVersion, h);
+    h = ComFnvValue(opts.minSize_, h);
+    h = ComFnvValue(opts.maxSize_, h);
+    h = ComFnvValue(opts.octreeMaxDepth_, h);
+    h = ComFnvValue(opts.sampleSize_, h);
+    h = ComFnvValue(opts.refinementFactor_, h);
+    h = ComFnvValue(opts.ratioFactor_, h);
+    h = ComFnvValue(static_cast<uint64_t>(samples.size()), h);
+    for (const auto &s : samples)
+    {
+        h = ComFnv1a(s.pos_, sizeof(s.pos_), h);
+        h = ComFnvValue(s.size_, h);
+    }
+    return h;
+}
+
+int SizingOctree::loadOrBuild(const std::string &modelId, const std::vector<SizingSample> &samples,
+                              const AdaptiveMeshOptions &opts)
+{
+    if (opts.sizingCacheFile_.empty())
+    {
+        build(samples, opts);
+        return 1;
+    }
+    uint64_t key = cacheKey(modelId, samples, opts);
+    threadNum_ = ComThreadNum(opts.sizingThreadNum_);
+    if (load(opts.sizingCacheFile_, key) == 0)
+        return 0;
+    build(samples, opts);
+    return save(opts.sizingCacheFile_, key) == 0 ? 1 : -1;
+}
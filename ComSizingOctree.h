@@ -0,0 +1,163 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComSizingOctree.h
+// 摘    要：八叉树背景尺寸场：由曲面曲率采样点按 AdaptiveMeshOptions 并行构建，
+//           叶子角点存储尺寸并三线性插值，支持缓存上次所在叶子的快速查询与文件复用
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMSIZINGOCTREE_H_
+#define EMMPMESH_COMMON_COMSIZINGOCTREE_H_
+
+#include "ComConstants.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 尺寸采样点
+struct SizingSample
+{
+    double pos_[3] = {0., 0., 0.}; // 坐标
+    double size_ = 0.;             // 期望尺寸
+};
+
+// 八叉树节点，子节点编号按 bit0-x、bit1-y、bit2-z 排列
+struct SizingOctreeNode
+{
+    double center_[3] = {0., 0., 0.}; // 中心
+    double half_ = 0.;                // 半边长
+    int child_ = -1;                  // 第一个子节点编号（8 个连续存放），-1 表示叶子
+    int leaf_ = -1;                   // 叶子编号（角点尺寸下标），非叶子为 -1
+    int depth_ = 0;                   // 深度
+};
+
+// 查询缓存，每个线程持有一个，连续查询落在同一叶子时不再从根节点下降
+struct SizingQueryCache
+{
+    int node_ = -1;         // 上次所在叶子节点
+    long long hitNum_ = 0;  // 命中次数
+    long long missNum_ = 0; // 未命中次数
+};
+
+/************************************************************************
+* 功能描述：由曲率计算期望尺寸：曲率半径 R = 1/κ，弦所对圆心角不超过 curvatureAngle_ 时
+*           h = 2R·sin(θ/2)，并截断到 [minSize_, maxSize_]；κ <= 0 时返回 maxSize_
+* 返回值：double - 期望尺寸
+* 作者：邓龙威
+/************************************************************************/
+double ComCurvatureSize(double curvature, const AdaptiveMeshOptions &opts);
+
+// 八叉树背景尺寸场
+class SizingOctree
+{
+public:
+    SizingOctree() = default;
+
+    /************************************************************************
+    * 功能描述：由采样点构建。sampleSize_ 大于 0 时先按边长 sampleSize_ 的网格抽稀采样点
+    *           （每个网格单元保留尺寸最小的一个）。包围盒取采样点包围盒外扩一个 maxSize_；
+    *           节点边长大于其内采样点最小尺寸（无采样点时为 maxSize_）的 refinementFactor_ 倍
+    *           且边长大于 minSize_、深度小于 octreeMaxDepth_ 时细分。逐层并行：每层的待细分
+    *           节点并行划分采样点。
+    *           ratioFactor_ 大于 1 时对叶子尺寸做梯度控制（ComGradeSizingOctree），并以
+    *           LogLevel::Perf 向日志回调输出 ComGradationPerf；叶子角点尺寸取共享该角点的
+    *           所有叶子尺寸的最小值，同样并行计算
+    * 返回值：int - 叶子个数
+    * 作者：邓龙威
+    /************************************************************************/
+    int build(const std::vector<SizingSample> &samples, const AdaptiveMeshOptions &opts);
+
+    /************************************************************************
+    * 功能描述：查询点 p 处的尺寸（三线性插值），包围盒外的点投影到包围盒上。
+    *           cache 非空时先检查上次所在叶子，否则从根节点下降，复杂度 O(深度)
+    * 返回值：double - 尺寸
+    * 作者：邓龙威
+    /************************************************************************/
+    double size(const double p[3], SizingQueryCache *cache = nullptr) const;
+
+    /************************************************************************
+    * 功能描述：查找点 p 所在叶子节点
+    * 返回值：int - 节点编号，空树返回 -1
+    * 作者：邓龙威
+    /************************************************************************/
+    int locate(const double p[3], SizingQueryCache *cache = nullptr) const;
+
+    /************************************************************************
+    * 功能描述：以二进制保存 / 加载。key 标识模型与参数（见 cacheKey），加载时 key 不一致
+    *           视为失效；节点的子节点、叶子编号须在范围内且子节点编号大于父节点，否则视为格式错误
+    * 返回值：0 表示成功，非 0 表示失败（1-文件无法打开，2-格式错误，3-key 不一致）
+    * 作者：邓龙威
+    /************************************************************************/
+    int save(const std::string &filePath, uint64_t key) const;
+    int load(const std::string &filePath, uint64_t key);
+
+    /************************************************************************
+    * 功能描述：模型标识、采样点与 build 使用的参数（minSize_、maxSize_、octreeMaxDepth_、
+    *           sampleSize_、refinementFactor_、ratioFactor_）的 FNV-1a 散列，用于判断缓存能否复用。
+    *           其余采样参数（curvatureAngle_ 等）通过采样点本身参与散列
+    * 返回值：uint64_t
+    * 作者：邓龙威
+    /************************************************************************/
+    static uint64_t cacheKey(const std::string &modelId, const std::vector<SizingSample> &samples,
+                             const AdaptiveMeshOptions &opts);
+
+    /************************************************************************
+    * 功能描述：opts.sizingCacheFile_ 非空时先按 cacheKey 加载缓存，失败（文件不存在、损坏或
+    *           key 不一致）时由 samples 构建并写回缓存；sizingCacheFile_ 为空时直接构建
+    * 返回值：int - 0-从缓存加载，1-重新构建，-1-重新构建但缓存写入失败
+    * 作者：邓龙威
+    /************************************************************************/
+    int loadOrBuild(const std::string &modelId, const std::vector<SizingSample> &samples,
+                    const AdaptiveMeshOptions &opts);
+
+    bool empty() const { return nodes_.empty(); }
+    int nodeNum() const { return static_cast<int>(nodes_.size()); }
+    int leafNum() const { return static_cast<int>(leafNodes_.size()); }
+    double minHalf() const { return minHalf_; }
+    const std::vector<SizingOctreeNode> &nodes() const { return nodes_; }
+    const std::vector<int> &leafNodes() const { return leafNodes_; }
+
+    // 叶子尺寸与角点尺寸，供梯度控制等后处理修改
+    std::vector<double> &leafSize() { return leafSize_; }
+    std::vector<double> &cornerSize() { return cornerSize_; }
+    const std::vector<double> &leafSize() const { return leafSize_; }
+    const std::vector<double> &cornerSize() const { return cornerSize_; }
+
+    /************************************************************************
+    * 功能描述：由叶子尺寸重新计算角点尺寸（共享角点的叶子尺寸最小值）
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void updateCorners();
+
+    /************************************************************************
+    * 功能描述：设置日志输出回调，build 以 LogLevel::Perf 输出按 format 格式化的梯度控制统计
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setLogSink(ComLogSink sink, LogFileFormat format = LogFileFormat::Logfmt)
+    {
+        sink_ = std::move(sink);
+        logFormat_ = format;
+    }
+
+private:
+    bool inside(int node, const double p[3]) const; // p 是否在节点（闭）包围盒内
+    int descend(const double p[3]) const;           // 从根节点下降到叶子
+
+    std::vector<SizingOctreeNode> nodes_;             // 节点，0 为根节点
+    std::vector<int> leafNodes_;                      // 叶子编号 -> 节点编号
+    std::vector<double> leafSize_;                    // 叶子尺寸
+    std::vector<double> cornerSize_;                  // 叶子角点尺寸，每个叶子 8 个
+    double minSize_ = 0.;                             // 最小尺寸
+    double maxSize_ = 0.;                             // 最大尺寸
+    double minHalf_ = 0.;                             // 最小叶子半边长
+    int threadNum_ = 1;                               // 线程数
+    ComLogSink sink_;                                 // 日志输出回调
+    LogFileFormat logFormat_ = LogFileFormat::Logfmt; // 日志消息格式
+};
+
+#endif // EMMPMESH_COMMON_COMSIZINGOCTREE_H_
@@ -0,0 +1,242 @@
+#include "pch.h"
+
+#include "ComSurfParallel.h"
+#include "ComParallel.h"
+
+#include <atomic>
+#include <chrono>
+
+// 新建长度为 n 的 TypedVectorHolder<T> 并返回数据指针
+template <typename T>
+static T *ComResizeHolder(std::unique_ptr<VectorHolder> &holder, size_t n)
+{
+    auto typed = std::make_unique<TypedVectorHolder<T>>(n);
+    typed->insert(0, n, T());
+    T *data = typed->data_typed();
+    holder = std::move(typed);
+    return data;
+}
+
+// 组装模型面边界，依赖的模型边离散失败时返回 false
+static bool ComFaceBoundary(const SurfModelFace &face, const std::vector<SurfModelEdge> &edges,
+                            const std::vector<EdgeDiscretization> &edgeDisc, const std::vector<char> &edgeOk,
+                            const std::vector<int> &edgeOffset, const std::vector<double> &modelVerts,
+                            FaceBoundary &boundary)
+{
+    boundary.loopStart_.assign(1, 0);
+    boundary.verts_.clear();
+    boundary.coords_.clear();
+    auto push = [&](int v, const double *p) {
+        boundary.verts_.push_back(v);
+        boundary.coords_.insert(boundary.coords_.end(), p, p + 3);
+    };
+
+    for (const auto &loop : face.loops_)
+    {
+        for (const auto &use : loop)
+        {
+            int e = use.first;
+            if (e < 0 || e >= static_cast<int>(edges.size()) || !edgeOk[e])
+                return false;
+            const EdgeDiscretization &disc = edgeDisc[e];
+            int num = static_cast<int>(disc.coords_.size() / 3);
+            if (!use.second)
+            {
+                push(edges[e].startVert_, modelVerts.data() + 3 * edges[e].startVert_);
+                for (int i = 0; i < num; ++i)
+                    push(edgeOffset[e] + i, disc.coords_.data() + 3 * i);
+            }
+            else
+            {
+                push(edges[e].endVert_, modelVerts.data() + 3 * edges[e].endVert_);
+                for (int i = num - 1; i >= 0; --i)
+                    push(edgeOffset[e] + i, disc.coords_.data() + 3 * i);
+            }
+        }
+        boundary.loopStart_.push_back(static_cast<int>(boundary.verts_.size()));
+    }
+    return true;
+}
+
+SurfParallelStat ComParallelSurfMesh(const std::vector<double> &modelVerts, const std::vector<SurfModelEdge> &edges,
+                                     const std::vector<SurfModelFace> &faces, const ComEdgeDiscretize &discretize,
+                                     const ComFaceMesher &mesher, int threadNum, Mesh &mesh,
+                                     MeshAttr *attr, std::vector<int> *triFace)
+{
+    SurfParallelStat stat;
+    threadNum = ComThreadNum(threadNum);
+    int modelVertNum = static_cast<int>(modelVerts.size() / 3);
+    int edgeNum = static_cast<int>(edges.size());
+    int faceNum = static_cast<int>(faces.size());
+    auto clock = std::chrono::steady_clock::now();
+    auto lap = [&clock]() {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - clock).count();
+        clock = now;
+        return seconds;
+    };
+
+    // 1. 并行离散模型边，离散开销差异大，以原子游标分发
+    std::vector<EdgeDiscretization> edgeDisc(edgeNum);
+    std::vector<char> edgeOk(edgeNum, 0);
+    std::atomic<int> edgeCursor(0);
+    ComParallelFor(0, threadNum, threadNum, [&](int, int, int) {
+        for (int e = edgeCursor.fetch_add(1); e < edgeNum; e = edgeCursor.fetch_add(1))
+        {
+            const SurfModelEdge &edge = edges[e];
+            bool valid = edge.startVert_ >= 0 && edge.startVert_ < modelVertNum &&
+                         edge.endVert_ >= 0 && edge.endVert_ < modelVertNum;
+            edgeOk[e] = valid && discretize(e, edgeDisc[e]) && edgeDisc[e].coords_.size() % 3 == 0;
+        }
+    });
+
+    std::vector<int> edgeOffset(edgeNum + 1, modelVertNum);
+    for (int e = 0; e < edgeNum; ++e)
+    {
+        if (!edgeOk[e])
+            stat.failedEdge_.push_back(e);
+        int num = edgeOk[e] ? static_cast<int>(edgeDisc[e].coords_.size() / 3) : 0;
+        edgeOffset[e + 1] = edgeOffset[e] + num;
+    }
+    stat.edgeSeconds_ = lap();
+
+    // 2. 按工作量降序并行剖分模型面
+    std::vector<double> cost(faceNum);
+    for (int f = 0; f < faceNum; ++f)
+    {
+        cost[f] = faces[f].cost_;
+        if (cost[f] > 0.)
+            continue;
+        for (const auto &loop : faces[f].loops_)
+        {
+            for (const auto &use : loop)
+                cost[f] += use.first >= 0 && use.first < edgeNum ? edgeOffset[use.first + 1] - edgeOffset[use.first] + 1 : 0;
+        }
+    }
+    std::vector<int> order(faceNum);
+    for (int f = 0; f < faceNum; ++f)
+        order[f] = f;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return cost[a] > cost[b]; });
+
+    std::vector<FaceMeshResult> results(faceNum);
+    std::vector<std::vector<int>> boundVerts(faceNum);
+    std::vector<char> faceOk(faceNum, 0);
+    std::atomic<int> faceCursor(0);
+    ComParallelFor(0, threadNum, threadNum, [&](int, int, int) {
+        FaceBoundary boundary;
+        for (int i = faceCursor.fetch_add(1); i < faceNum; i = faceCursor.fetch_add(1))
+        {
+            int f = order[i];
+            if (!ComFaceBoundary(faces[f], edges, edgeDisc, edgeOk, edgeOffset, modelVerts, boundary))
+                continue;
+            FaceMeshResult &res = results[f];
+            if (!mesher(f, boundary, res) || res.coords_.size() % 3 != 0 || res.tris_.size() % 3 != 0)
+            {
+                res = FaceMeshResult();
+                continue;
+            }
+            int localNum = static_cast<int>(boundary.verts_.size() + res.coords_.size() / 3);
+            bool valid = true;
+            for (int v : res.tris_)
+                valid = valid && v >= 0 && v < localNum;
+            if (!valid)
+            {
+                res = FaceMeshResult();
+                continue;
+            }
+            boundVerts[f] = boundary.verts_;
+            faceOk[f] = 1;
+        }
+    });
+    stat.faceSeconds_ = lap();
+
+    // 3. 按模型面编号分配全局编号，结果与调度顺序无关
+    std::vector<int> faceOffset(faceNum + 1, edgeOffset[edgeNum]);
+    std::vector<int> triOffset(faceNum + 1, 0);
+    for (int f = 0; f < faceNum; ++f)
+    {
+        if (!faceOk[f])
+            stat.failedFace_.push_back(f);
+        faceOffset[f + 1] = faceOffset[f] + static_cast<int>(results[f].coords_.size() / 3);
+        triOffset[f + 1] = triOffset[f] + static_cast<int>(results[f].tris_.size() / 3);
+    }
+    std::vector<int> segOffset(edgeNum + 1, 0);
+    for (int e = 0; e < edgeNum; ++e)
+        segOffset[e + 1] = segOffset[e] + (edgeOk[e] ? edgeOffset[e + 1] - edgeOffset[e] + 1 : 0);
+
+    stat.vertNum_ = faceOffset[faceNum];
+    stat.edgeNum_ = segOffset[edgeNum];
+    stat.triNum_ = triOffset[faceNum];
+
+    double *coords = ComResizeHolder<double>(mesh[MeshElementType::Vertex], 3 * static_cast<size_t>(stat.vertNum_));
+    int *segs = ComResizeHolder<int>(mesh[MeshElementType::Edge], 2 * static_cast<size_t>(stat.edgeNum_));
+    int *tris = ComResizeHolder<int>(mesh[MeshElementType::Face], 3 * static_cast<size_t>(stat.triNum_));
+    int *vertType = nullptr;
+    double *tParam = nullptr;
+    if (attr)
+    {
+        std::unique_ptr<VectorHolder> typeHolder, paramHolder;
+        vertType = ComResizeHolder<int>(typeHolder, stat.vertNum_);
+        tParam = ComResizeHolder<double>(paramHolder, stat.vertNum_);
+        (*attr)[MeshElementType::Vertex]["vertType"] = std::make_pair(std::move(typeHolder), MeshAttrDataType::Int);
+        (*attr)[MeshElementType::Vertex]["tParam"] = std::make_pair(std::move(paramHolder), MeshAttrDataType::Dbl);
+    }
+    if (triFace)
+        triFace->assign(stat.triNum_, -1);
+
+    std::copy(modelVerts.begin(), modelVerts.begin() + 3 * static_cast<size_t>(modelVertNum), coords);
+    if (vertType)
+        std::fill(vertType, vertType + modelVertNum, 0);
+
+    ComParallelFor(0, edgeNum, threadNum, [&](int, int first, int last) {
+        for (int e = first; e < last; ++e)
+        {
+            if (!edgeOk[e])
+                continue;
+            const EdgeDiscretization &disc = edgeDisc[e];
+            int num = edgeOffset[e + 1] - edgeOffset[e];
+            std::copy(disc.coords_.begin(), disc.coords_.end(), coords + 3 * static_cast<size_t>(edgeOffset[e]));
+            for (int i = 0; i < num; ++i)
+            {
+                if (vertType)
+                    vertType[edgeOffset[e] + i] = 1;
+                if (tParam && static_cast<int>(disc.tParam_.size()) == num)
+                    tParam[edgeOffset[e] + i] = disc.tParam_[i];
+            }
+            // 线网格：起点 - 内部点 - 终点
+            int *seg = segs + 2 * static_cast<size_t>(segOffset[e]);
+            int prev = edges[e].startVert_;
+            for (int i = 0; i <= num; ++i)
+            {
+                int cur = i < num ? edgeOffset[e] + i : edges[e].endVert_;
+                seg[2 * i] = prev;
+                seg[2 * i + 1] = cur;
+                prev = cur;
+            }
+        }
+    });
+
+    ComParallelFor(0, faceNum, threadNum, [&](int, int first, int last) {
+        for (int f = first; f < last; ++f)
+        {
+            if (!faceOk[f])
+                continue;
+            const FaceMeshResult &res = results[f];
+            const std::vector<int> &bv = boundVerts[f];
+            int boundNum = static_cast<int>(bv.size());
+            std::copy(res.coords_.begin(), res.coords_.end(), coords + 3 * static_cast<size_t>(faceOffset[f]));
+            if (vertType)
+                std::fill(vertType + faceOffset[f], vertType + faceOffset[f + 1], 2);
+            int *tri = tris + 3 * static_cast<size_t>(triOffset[f]);
+            for (size_t k = 0; k < res.tris_.size(); ++k)
+            {
+                int v = res.tris_[k];
+                tri[k] = v < boundNum ? bv[v] : faceOffset[f] + v - boundNum;
+            }
+            if (triFace)
+                std::fill(triFace->begin() + triOffset[f], triFace->begin() + triOffset[f + 1], f);
+        }
+    });
+    stat.stitchSeconds_ = lap();
+    return stat;
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComSurfParallel.h
+// 摘    要：按模型面并行的曲面网格生成：先并行离散模型边，再按工作量从大到小并行
+//           剖分各模型面，最后将各面的顶点与三角形拼接到全局网格，共享边上的顶点只保留一份
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMSURFPARALLEL_H_
+#define EMMPMESH_COMMON_COMSURFPARALLEL_H_
+
+#include "ComConstants.h"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+// 模型边：起止模型点编号（闭合边两者相同）
+struct SurfModelEdge
+{
+    int startVert_ = -1; // 起点
+    int endVert_ = -1;   // 终点
+};
+
+// 模型面：边界环，每个环为按顺序排列的（模型边编号，是否反向）
+struct SurfModelFace
+{
+    std::vector<std::vector<std::pair<int, bool>>> loops_; // 边界环，第一个为外环
+    double cost_ = 0.;                                     // 工作量估计（如面积 / 尺寸²），<= 0 时以边界点数代替
+};
+
+// 模型边离散结果：按参数递增排列的内部点（不含端点）
+struct EdgeDiscretization
+{
+    std::vector<double> coords_; // 内部点坐标，每个 3 个 double
+    std::vector<double> tParam_; // 内部点参数坐标
+};
+
+// 模型面边界：各环首尾相接的全局顶点编号与坐标（环的最后一点不重复第一点）
+struct FaceBoundary
+{
+    std::vector<int> loopStart_; // 各环在 verts_ 中的起始下标，长度为环个数 + 1
+    std::vector<int> verts_;     // 全局顶点编号
+    std::vector<double> coords_; // 坐标，每个 3 个 double
+};
+
+// 模型面剖分结果
+struct FaceMeshResult
+{
+    std::vector<double> coords_; // 面内部新增顶点坐标
+    std::vector<int> tris_;      // 三角形，每个 3 个局部编号：小于边界点数时为 FaceBoundary::verts_ 下标，否则为内部点下标 + 边界点数
+};
+
+// 模型边离散回调，失败返回 false
+using ComEdgeDiscretize = std::function<bool(int edgeId, EdgeDiscretization &out)>;
+
+// 模型面剖分回调，只能使用给定的边界点，失败返回 false
+using ComFaceMesher = std::function<bool(int faceId, const FaceBoundary &boundary, FaceMeshResult &out)>;
+
+// 曲面并行生成统计
+struct SurfParallelStat
+{
+    int vertNum_ = 0;             // 全局顶点个数
+    int edgeNum_ = 0;             // 全局线网格个数
+    int triNum_ = 0;              // 全局三角形个数
+    std::vector<int> failedEdge_; // 离散失败的模型边
+    std::vector<int> failedFace_; // 剖分失败（或依赖的模型边离散失败）的模型面
+    double edgeSeconds_ = 0.;     // 模型边离散耗时（秒）
+    double faceSeconds_ = 0.;     // 模型面剖分耗时（秒）
+    double stitchSeconds_ = 0.;   // 拼接耗时（秒）
+};
+
+/************************************************************************
+* 功能描述：按模型面并行生成曲面网格。
+*           1. 并行离散模型边，全局顶点编号依次为模型点、各模型边内部点；
+*           2. 由各面的边界环组装 FaceBoundary，按工作量降序以原子游标分发到线程，并行剖分；
+*           3. 按模型面编号串行分配面内部点的全局编号，再并行写入 mesh 的 Vertex / Edge / Face。
+*           边界点在各面间共享全局编号，不产生重复顶点；输出与线程数无关。
+*           attr 非空时写入顶点属性 "vertType"（0-模型点，1-模型边，2-模型面）与 "tParam"；
+*           triFace 非空时写入每个三角形所属的模型面编号
+* 返回值：SurfParallelStat - 统计信息
+* 作者：邓龙威
+/************************************************************************/
+SurfParallelStat ComParallelSurfMesh(const std::vector<double> &modelVerts, const std::vector<SurfModelEdge> &edges,
+                                     const std::vector<SurfModelFace> &faces, const ComEdgeDiscretize &discretize,
+                                     const ComFaceMesher &mesher, int threadNum, Mesh &mesh,
+                                     MeshAttr *attr = nullptr, std::vector<int> *triFace = nullptr);
+
+#endif // EMMPMESH_COMMON_COMSURFPARALLEL_H_
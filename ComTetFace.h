@@ -0,0 +1,40 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComTetFace.h
+// 摘    要：四面体局部面编号与有向面键，供 Delaunay 剖分、拓扑翻转与局部重剖分共用
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMTETFACE_H_
+#define EMMPMESH_COMMON_COMTETFACE_H_
+
+#include <array>
+
+// 四面体局部面编号：第 i 个面为顶点 i 的对面，顶点 i 位于该面正侧；
+// neigRegionID 的第 i 个分量即为该面的相邻单元，-1 表示网格边界
+inline const int ComTetFaceVert[4][3] = {{1, 3, 2}, {0, 2, 3}, {0, 3, 1}, {0, 1, 2}};
+
+// 有向三角形轮换到最小顶点在前，方向保持不变（用作有向面的键）
+inline std::array<int, 3> ComFaceRotate(int a, int b, int c)
+{
+    if (a < b && a < c)
+        return {a, b, c};
+    if (b < c)
+        return {b, c, a};
+    return {c, a, b};
+}
+
+// 单元 tet 的第 i 个有向面
+inline std::array<int, 3> ComTetFace(const int *tet, int i)
+{
+    return ComFaceRotate(tet[ComTetFaceVert[i][0]], tet[ComTetFaceVert[i][1]], tet[ComTetFaceVert[i][2]]);
+}
+
+// 反向面（相邻单元看到的同一个面）
+inline std::array<int, 3> ComFaceReverse(const std::array<int, 3> &f)
+{
+    return ComFaceRotate(f[0], f[2], f[1]);
+}
+
+#endif // EMMPMESH_COMMON_COMTETFACE_H_
@@ -0,0 +1,255 @@
+#include "pch.h"
+
+#include "ComThreadPool.h"
+#include "ComParallel.h"
+
+// 当前线程所属的线程池与工作线程编号，用于区分嵌套的多个线程池
+static thread_local const WorkStealPool *ComWorkerPool = nullptr;
+static thread_local int ComWorkerIndex = -1;
+
+WorkStealPool::WorkStealPool(int threadNum)
+{
+    threadNum = ComThreadNum(threadNum);
+    for (int i = 0; i < threadNum; ++i)
+        queues_.push_back(std::make_unique<TaskQueue>());
+    threads_.reserve(threadNum);
+    for (int i = 0; i < threadNum; ++i)
+        threads_.emplace_back(&WorkStealPool::workerLoop, this, i);
+}
+
+WorkStealPool::~WorkStealPool()
+{
+    // 析构函数不能抛出，未被 wait 取走的任务异常在此丢弃
+    try
+    {
+        wait();
+    }
+    catch (...)
+    {
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_.store(true);
+    }
+    sleepCv_.notify_all();
+    for (auto &th : threads_)
+        th.join();
+}
+
+int WorkStealPool::workerIndex() const
+{
+    return ComWorkerPool == this ? ComWorkerIndex : -1;
+}
+
+void WorkStealPool::submit(Task task)
+{
+    int index = workerIndex();
+    TaskQueue &q = index >= 0 ? *queues_[index] : inject_;
+
+    // 入队成功后才计数：push_back 抛出时计数不变，wait 不会因此永远等待；
+    // 计数在队列锁内完成，任务不会在计数之前被取走执行
+    {
+        std::lock_guard<std::mutex> lock(q.mutex_);
+        q.tasks_.push_back(std::move(task));
+        pendingNum_.fetch_add(1);
+    }
+    queuedNum_.fetch_add(1);
+
+    // 在 sleepMutex_ 下通知，避免工作线程检查 queuedNum_ 后、进入等待前错过唤醒
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCv_.notify_one();
+}
+
+bool WorkStealPool::take(int index, Task &task)
+{
+    int n = static_cast<int>(queues_.size());
+    if (index >= 0)
+    {
+        TaskQueue &own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex_);
+        if (!own.tasks_.empty())
+        {
+            task = std::move(own.tasks_.back());
+            own.tasks_.pop_back();
+            queuedNum_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(inject_.mutex_);
+        if (!inject_.tasks_.empty())
+        {
+            task = std::move(inject_.tasks_.front());
+            inject_.tasks_.pop_front();
+            queuedNum_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // 窃取：从其他线程队首取最早提交（通常也是最大）的任务
+    int first = index >= 0 ? index + 1 : 0;
+    for (int k = 0; k < n; ++k)
+    {
+        int victim = (first + k) % n;
+        if (victim == index)
+            continue;
+        TaskQueue &q = *queues_[victim];
+        std::lock_guard<std::mutex> lock(q.mutex_);
+        if (!q.tasks_.empty())
+        {
+            task = std::move(q.tasks_.front());
+            q.tasks_.pop_front();
+            queuedNum_.fetch_sub(1);
+            stealNum_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealPool::execute(Task &task)
+{
+    // 异常不能离开工作线程（否则 std::terminate），记录第一个异常由 wait 重新抛出
+    try
+    {
+        task();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (!error_)
+            error_ = std::current_exception();
+    }
+    taskNum_.fetch_add(1, std::memory_order_relaxed);
+    if (pendingNum_.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        doneCv_.notify_all();
+    }
+}
+
+bool WorkStealPool::runOne(int index)
+{
+    Task task;
+    if (!take(index, task))
+        return false;
+    execute(task);
+    return true;
+}
+
+void WorkStealPool::workerLoop(int index)
+{
+    ComWorkerPool = this;
+    ComWorkerIndex = index;
+    while (true)
+    {
+        if (runOne(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCv_.wait(lock, [this] { return stop_.load() || queuedNum_.load() > 0; });
+        if (stop_.load() && queuedNum_.load() == 0)
+            break;
+    }
+    ComWorkerPool = nullptr;
+    ComWorkerIndex = -1;
+}
+
+void WorkStealPool::wait()
+{
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        doneCv_.wait(lock, [this] { return pendingNum_.load() == 0; });
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        std::swap(error, error_);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void WorkStealPool::parallelFor(int begin, int end, int chunkNum, const std::function<void(int, int, int)> &func)
+{
+    int count = end - begin;
+    if (count <= 0)
+        return;
+
+    chunkNum = std::max(1, std::min(chunkNum, count));
+    if (chunkNum <= 1)
+    {
+        func(0, begin, end);
+        return;
+    }
+
+    // 本次调用的任务组：块由共享计数器认领，调用线程与提交到池中的辅助任务都只执行本组的块，
+    // 调用线程等待时不会执行池中其他作业的任务。辅助任务持有任务组的共享指针，函数返回后
+    // 才被执行的辅助任务认领不到块而直接结束，因此 func 只在本函数返回前被调用
+    struct ChunkGroup
+    {
+        const std::function<void(int, int, int)> *func_ = nullptr;
+        int begin_ = 0, chunk_ = 0, rest_ = 0, chunkNum_ = 0;
+        std::atomic<int> next_{0};               // 下一个待认领的块
+        std::atomic<int> done_{0};               // 已结束的块数
+        std::vector<std::exception_ptr> errors_; // 各块抛出的异常
+
+        // 认领并执行一个块，没有剩余块时返回 false
+        bool runOne()
+        {
+            int t = next_.fetch_add(1);
+            if (t >= chunkNum_)
+                return false;
+            int first = begin_ + t * chunk_ + std::min(t, rest_);
+            int last = first + chunk_ + (t < rest_ ? 1 : 0);
+            try
+            {
+                (*func_)(t, first, last);
+            }
+            catch (...)
+            {
+                errors_[t] = std::current_exception();
+            }
+            done_.fetch_add(1);
+            return true;
+        }
+    };
+    auto group = std::make_shared<ChunkGroup>();
+    group->func_ = &func;
+    group->begin_ = begin;
+    group->chunk_ = count / chunkNum;
+    group->rest_ = count % chunkNum;
+    group->chunkNum_ = chunkNum;
+    group->errors_.resize(chunkNum);
+
+    // 提交失败（如内存不足）时不再提交，剩余的块由调用线程执行
+    try
+    {
+        for (int t = 1; t < chunkNum; ++t)
+        {
+            submit([group] {
+                while (group->runOne())
+                {
+                }
+            });
+        }
+    }
+    catch (...)
+    {
+    }
+
+    // 调用线程执行本组尚未认领的块，再等待其他线程上正在执行的块结束
+    while (group->runOne())
+    {
+    }
+    while (group->done_.load() < chunkNum)
+        std::this_thread::yield();
+    for (const auto &error : group->errors_)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComThreadPool.h
+// 摘    要：工作窃取线程池：每个工作线程一个双端队列，本线程从队尾取任务，空闲时从其他线程队首窃取；
+//           线程池外提交的任务进入公共队列（先进先出）；parallelFor 的调用线程参与执行，
+//           可在池内任务中嵌套调用
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMTHREADPOOL_H_
+#define EMMPMESH_COMMON_COMTHREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池
+class WorkStealPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /************************************************************************
+    * 功能描述：构造函数，启动 threadNum 个工作线程（<= 0 时使用硬件并发数）
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    explicit WorkStealPool(int threadNum);
+
+    /************************************************************************
+    * 功能描述：析构函数，等待已提交的任务完成后停止工作线程，未被 wait 取走的任务异常被丢弃
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    ~WorkStealPool();
+
+    WorkStealPool(const WorkStealPool &) = delete;
+    WorkStealPool &operator=(const WorkStealPool &) = delete;
+
+    /************************************************************************
+    * 功能描述：提交任务。在工作线程中提交时放入本线程队尾，否则放入公共队列队尾；
+    *           任务抛出的异常被捕获，由 wait 重新抛出
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void submit(Task task);
+
+    /************************************************************************
+    * 功能描述：等待所有已提交的任务完成（调用线程不参与执行，不可在池内任务中调用），
+    *           之后若有任务抛出过异常，重新抛出其中第一个并清除
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void wait();
+
+    /************************************************************************
+    * 功能描述：在池中并行执行循环，与 ComParallelFor 相同地将 [begin, end) 平均划分为 chunkNum 块，
+    *           func(chunkId, first, last) 处理子区间 [first, last)。块由调用线程与 chunkNum - 1 个
+    *           提交到池中的辅助任务共同认领；调用线程等待期间只执行本次调用的块，不执行池中
+    *           其他任务，因此可在池内任务中嵌套调用，且不会在自己的栈上执行其他作业。
+    *           各块抛出的异常被捕获，全部块结束后在调用线程重新抛出块编号最小的异常
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void parallelFor(int begin, int end, int chunkNum, const std::function<void(int, int, int)> &func);
+
+    /************************************************************************
+    * 功能描述：当前线程在本池中的工作线程编号，非本池工作线程返回 -1
+    * 返回值：int
+    * 作者：邓龙威
+    /************************************************************************/
+    int workerIndex() const;
+
+    int threadNum() const { return static_cast<int>(threads_.size()); }
+    long long taskNum() const { return taskNum_.load(std::memory_order_relaxed); }
+    long long stealNum() const { return stealNum_.load(std::memory_order_relaxed); }
+
+private:
+    // 工作线程的任务队列
+    struct TaskQueue
+    {
+        std::mutex mutex_;
+        std::deque<Task> tasks_;
+    };
+
+    void workerLoop(int index);            // 工作线程主循环
+    bool runOne(int index);                // 取出（本线程队尾或窃取）并执行一个任务
+    bool take(int index, Task &task);      // 依次从本线程队尾、公共队列队首取任务，最后窃取
+    void execute(Task &task);              // 执行任务并更新计数，任务异常记录到 error_
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_; // 各工作线程的任务队列
+    TaskQueue inject_;                               // 线程池外提交的任务
+    std::vector<std::thread> threads_;               // 工作线程
+    std::mutex sleepMutex_;                          // 保护休眠 / 唤醒
+    std::condition_variable sleepCv_;                // 有新任务或停止时唤醒工作线程
+    std::condition_variable doneCv_;                 // 任务全部完成时唤醒 wait
+    std::atomic<int> queuedNum_{0};                  // 队列中的任务个数
+    std::atomic<long long> pendingNum_{0};           // 已提交未完成的任务个数
+    std::atomic<bool> stop_{false};                  // 停止标志
+    std::atomic<long long> taskNum_{0};              // 已执行任务个数
+    std::atomic<long long> stealNum_{0};             // 窃取次数
+    std::mutex errorMutex_;                          // 保护 error_
+    std::exception_ptr error_;                       // 任务抛出的第一个异常，由 wait 取走
+};
+
+#endif // EMMPMESH_COMMON_COMTHREADPOOL_H_
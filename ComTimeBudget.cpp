@@ -0,0 +1,270 @@
+#include "pch.h"
+
+#include "ComTimeBudget.h"
+#include "ComOptiTelemetry.h"
+
+#include <algorithm>
+#include <utility>
+
+double ComQualityLevelCost(MeshQualityLevel level)
+{
+    auto rawCost = [](MeshQualityLevel l) {
+        ComOptionsManager manager;
+        manager.setQualityLevel(l);
+        const MeshOptiOptions &mo = manager.getMeshOptiOptions();
+        int maxIter = manager.getConjugateGradientOptions().maxIter_;
+        double typeCost = 1.2;
+        if (mo.smoothType_ == MeshSmoothType::GD)
+        {
+            maxIter = manager.getGradientDescentOptions().maxIter_;
+            typeCost = 1.;
+        }
+        else if (mo.smoothType_ == MeshSmoothType::LBFGS || mo.smoothType_ == MeshSmoothType::QN)
+        {
+            maxIter = manager.getQuasiNewtonOptions().maxIter_;
+            typeCost = 1.5;
+        }
+        // 按 patch 优化时每次求解的变量更多，线搜索与 L-BFGS 更新的代价约为单顶点的 2 倍
+        double wayCost = mo.smoothWay_ == MeshSmoothWay::SIGLE_VERT ? 1. : 2.;
+        return static_cast<double>(std::max(1, maxIter)) * std::max(1, mo.ConsecuIterNum_) * typeCost * wayCost;
+    };
+    return rawCost(level) / rawCost(MeshQualityLevel::Balanced);
+}
+
+MeshTimeBudget::MeshTimeBudget(const MeshTimeBudgetOptions &opts, ComOptionsManager &manager)
+    : opts_(opts), manager_(manager)
+{
+    for (int i = 0; i < MeshQualityLevelNum; ++i)
+        levelCost_[i] = ComQualityLevelCost(static_cast<MeshQualityLevel>(i));
+    start();
+}
+
+void MeshTimeBudget::setPhaseWeight(MeshPhase phase, double weight)
+{
+    weight_[static_cast<int>(phase)] = std::max(0., weight);
+}
+
+void MeshTimeBudget::setLevelCost(MeshQualityLevel level, double cost)
+{
+    levelCost_[static_cast<int>(level)] = std::max(0., cost);
+}
+
+void MeshTimeBudget::start()
+{
+    start_ = std::chrono::steady_clock::now();
+    phaseStart_ = start_;
+    startLevel_ = manager_.getQualityLevel();
+    level_ = startLevel_;
+    scale_ = 0.;
+    doneCost_ = 0.;
+    doneSeconds_ = 0.;
+    for (int p = 0; p < MeshPhaseNum; ++p)
+        done_[p] = false;
+    phase_ = -1;
+    degradeNum_ = 0;
+    records_.clear();
+    cancel_.store(false, std::memory_order_relaxed);
+    overBudget_.store(false, std::memory_order_relaxed);
+}
+
+double MeshTimeBudget::phaseCost(int phase, MeshQualityLevel level) const
+{
+    // 质量级别只影响优化阶段的代价，剖分阶段与级别无关
+    bool opti = phase == static_cast<int>(MeshPhase::SURF_OPTI) || phase == static_cast<int>(MeshPhase::VOLUM_OPTI);
+    return weight_[phase] * (opti ? levelCost_[static_cast<int>(level)] : 1.);
+}
+
+double MeshTimeBudget::predict(MeshPhase phase, MeshQualityLevel level) const
+{
+    double scale = scale_;
+    if (scale <= 0. && expectedSeconds_ > 0.)
+    {
+        double total = 0.;
+        for (int p = 0; p < MeshPhaseNum; ++p)
+            total += phaseCost(p, MeshQualityLevel::Balanced);
+        scale = total > 0. ? expectedSeconds_ / total : 0.;
+    }
+
+    double cost = 0.;
+    for (int p = static_cast<int>(phase); p < MeshPhaseNum; ++p)
+    {
+        if (!done_[p])
+            cost += phaseCost(p, level);
+    }
+    return scale * cost;
+}
+
+double MeshTimeBudget::elapsed() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+}
+
+MeshQualityLevel MeshTimeBudget::beginPhase(MeshPhase phase)
+{
+    if (phase_ >= 0)
+        endPhase();
+    phase_ = static_cast<int>(phase);
+    phaseStart_ = std::chrono::steady_clock::now();
+
+    if (opts_.timeBudget_ > 0. && opts_.autoDegrade_)
+    {
+        double target = opts_.timeBudget_ * (1. - opts_.budgetMargin_) - elapsed();
+        int level = static_cast<int>(level_);
+        while (level > 0)
+        {
+            double cur = predict(phase, static_cast<MeshQualityLevel>(level));
+            // 满足预算，或更低的级别不再节省时间（剩余阶段均与级别无关）时停止降级
+            if (cur <= target || predict(phase, static_cast<MeshQualityLevel>(level - 1)) >= cur)
+                break;
+            --level;
+        }
+        if (level != static_cast<int>(level_))
+        {
+            level_ = static_cast<MeshQualityLevel>(level);
+            ++degradeNum_;
+            manager_.applyQualityLevel(level_);
+        }
+    }
+    return level_;
+}
+
+void MeshTimeBudget::endPhase()
+{
+    if (phase_ < 0)
+        return;
+
+    MeshPhaseRecord record;
+    record.phase_ = static_cast<MeshPhase>(phase_);
+    record.level_ = level_;
+    record.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - phaseStart_).count();
+    double cost = phaseCost(phase_, level_);
+    record.plannedSeconds_ = cost > 0. ? record.seconds_ * phaseCost(phase_, startLevel_) / cost : record.seconds_;
+    record.stopped_ = checkpoint();
+    records_.push_back(record);
+    done_[phase_] = true;
+
+    // 提前结束的阶段耗时不代表其完整代价，不参与校准
+    if (!record.stopped_ && cost > 0.)
+    {
+        doneCost_ += cost;
+        doneSeconds_ += record.seconds_;
+        scale_ = doneSeconds_ / doneCost_;
+    }
+    phase_ = -1;
+}
+
+bool MeshTimeBudget::checkpoint() const
+{
+    if (cancel_.load(std::memory_order_relaxed) || overBudget_.load(std::memory_order_relaxed))
+        return true;
+    if (!opts_.hardDeadline_ || opts_.timeBudget_ <= 0. || elapsed() <= opts_.timeBudget_)
+        return false;
+    overBudget_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+ComEdgeDiscretize MeshTimeBudget::cancellableEdgeDiscretize(const ComEdgeDiscretize &inner) const
+{
+    return [this, inner](int edgeId, EdgeDiscretization &out) {
+        return !checkpoint() && inner(edgeId, out);
+    };
+}
+
+ComFaceMesher MeshTimeBudget::cancellableFaceMesher(const ComFaceMesher &inner) const
+{
+    return [this, inner](int faceId, const FaceBoundary &boundary, FaceMeshResult &out) {
+        return !checkpoint() && inner(faceId, boundary, out);
+    };
+}
+
+TimeBudgetReport MeshTimeBudget::report() const
+{
+    TimeBudgetReport report;
+    report.budget_ = opts_.timeBudget_;
+    report.elapsed_ = elapsed();
+    report.startLevel_ = startLevel_;
+    report.finalLevel_ = level_;
+    report.degradeNum_ = degradeNum_;
+    report.cancelled_ = cancelled();
+    report.overBudget_ = overBudget_.load(std::memory_order_relaxed) ||
+                         (opts_.timeBudget_ > 0. && report.elapsed_ > opts_.timeBudget_);
+    report.phases_ = records_;
+    for (const auto &r : records_)
+        report.savedSeconds_ += r.plannedSeconds_ - r.seconds_;
+    return report;
+}
+
+std::string MeshTimeBudget::phaseToString(MeshPhase phase)
+{
+    switch (phase)
+    {
+    case MeshPhase::SIZING:
+        return "sizing";
+    case MeshPhase::EDGE:
+        return "edge";
+    case MeshPhase::SURF:
+        return "surf";
+    case MeshPhase::SURF_OPTI:
+        return "surfOpti";
+    case MeshPhase::VOLUM:
+        return "volum";
+    case MeshPhase::VOLUM_OPTI:
+        return "volumOpti";
+    default:
+        return "unknown";
+    }
+}
+
+std::string MeshTimeBudget::levelToString(MeshQualityLevel level)
+{
+    switch (level)
+    {
+    case MeshQualityLevel::VeryFast:
+        return "VeryFast";
+    case MeshQualityLevel::Fast:
+        return "Fast";
+    case MeshQualityLevel::Balanced:
+        return "Balanced";
+    case MeshQualityLevel::HighQuality:
+        return "HighQuality";
+    case MeshQualityLevel::VeryHighQuality:
+        return "VeryHighQuality";
+    default:
+        return "unknown";
+    }
+}
+
+std::string MeshTimeBudget::reportToString(const TimeBudgetReport &report, LogFileFormat format)
+{
+    // 依次使用过的质量级别，如 HighQuality>Fast
+    std::string levels = levelToString(report.startLevel_);
+    MeshQualityLevel last = report.startLevel_;
+    for (const auto &r : report.phases_)
+    {
+        if (r.level_ != last)
+        {
+            levels += ">" + levelToString(r.level_);
+            last = r.level_;
+        }
+    }
+
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"budget", ComTelemetryValue(report.budget_)},
+        {"elapsed", ComTelemetryValue(report.elapsed_)},
+        {"saved", ComTelemetryValue(report.savedSeconds_)},
+        {"levels", levels},
+        {"finalLevel", levelToString(report.finalLevel_)},
+        {"degrades", ComTelemetryValue(report.degradeNum_)},
+        {"cancelled", report.cancelled_ ? "true" : "false"},
+        {"overBudget", report.overBudget_ ? "true" : "false"},
+    };
+    for (const auto &r : report.phases_)
+    {
+        std::string name = phaseToString(r.phase_);
+        fields.push_back({name + ".level", levelToString(r.level_)});
+        fields.push_back({name + ".seconds", ComTelemetryValue(r.seconds_)});
+        if (r.stopped_)
+            fields.push_back({name + ".stopped", "true"});
+    }
+    return ComTelemetryFields(fields, format);
+}
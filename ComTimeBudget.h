@@ -0,0 +1,189 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComTimeBudget.h
+// 摘    要：按时间预算生成网格：以已完成阶段的实测耗时校准各阶段代价模型，在阶段之间
+//           逐级降低质量级别（VeryHighQuality → … → VeryFast），并提供协作式取消
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMTIMEBUDGET_H_
+#define EMMPMESH_COMMON_COMTIMEBUDGET_H_
+
+#include "ComOptionsManager.h"
+#include "ComSurfParallel.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// 网格生成阶段，按执行顺序排列
+enum class MeshPhase
+{
+    SIZING = 0,     // 背景尺寸场
+    EDGE = 1,       // 线网格生成
+    SURF = 2,       // 面网格生成
+    SURF_OPTI = 3,  // 面网格优化
+    VOLUM = 4,      // 体网格生成
+    VOLUM_OPTI = 5, // 体网格优化
+};
+inline const int MeshPhaseNum = 6;
+inline const int MeshQualityLevelNum = 5;
+
+/************************************************************************
+* 功能描述：质量级别的优化代价（相对于 Balanced）：由 setQualityLevel 的预设估计为
+*           maxIter_ × ConsecuIterNum_ × 光滑化方法系数 × 光滑化方式系数
+* 返回值：double
+* 作者：邓龙威
+/************************************************************************/
+double ComQualityLevelCost(MeshQualityLevel level);
+
+// 一个阶段的执行记录
+struct MeshPhaseRecord
+{
+    MeshPhase phase_ = MeshPhase::SIZING;                 // 阶段
+    MeshQualityLevel level_ = MeshQualityLevel::Balanced; // 执行时的质量级别
+    double seconds_ = 0.;                                 // 实际耗时（秒）
+    double plannedSeconds_ = 0.;                          // 以起始级别执行的预计耗时（秒），由实际耗时按级别代价换算
+    bool stopped_ = false;                                // 是否因取消或超出预算提前结束
+};
+
+// 时间预算执行报告
+struct TimeBudgetReport
+{
+    double budget_ = 0.;                                       // 时间预算（秒）
+    double elapsed_ = 0.;                                      // 总耗时（秒）
+    double savedSeconds_ = 0.;                                 // 降级节省的时间（秒）：Σ(plannedSeconds_ - seconds_)
+    MeshQualityLevel startLevel_ = MeshQualityLevel::Balanced; // 起始质量级别
+    MeshQualityLevel finalLevel_ = MeshQualityLevel::Balanced; // 最终实际应用的质量级别
+    int degradeNum_ = 0;                                       // 降级次数
+    bool cancelled_ = false;                                   // 是否被外部取消
+    bool overBudget_ = false;                                  // 是否超出预算
+    std::vector<MeshPhaseRecord> phases_;                      // 各阶段记录，按执行顺序
+};
+
+// 时间预算控制器。由生成流程的主线程在阶段之间调用 beginPhase / endPhase，
+// 各工作线程在循环中调用 checkpoint 实现协作式取消；cancel 可由任意线程调用
+class MeshTimeBudget
+{
+public:
+    /************************************************************************
+    * 功能描述：构造函数，manager 为生成流程使用的选项管理器，降级时调用其 applyQualityLevel
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    MeshTimeBudget(const MeshTimeBudgetOptions &opts, ComOptionsManager &manager);
+
+    /************************************************************************
+    * 功能描述：设置阶段在 Balanced 级别下的相对耗时（先验），0 表示本作业不执行该阶段。
+    *           默认 SIZING 0.05、EDGE 0.05、SURF 0.25、SURF_OPTI 0.15、VOLUM 0.2、VOLUM_OPTI 0.3
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setPhaseWeight(MeshPhase phase, double weight);
+
+    /************************************************************************
+    * 功能描述：设置质量级别的优化代价（相对于 Balanced），默认取 ComQualityLevelCost
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setLevelCost(MeshQualityLevel level, double cost);
+
+    /************************************************************************
+    * 功能描述：设置以 Balanced 级别执行全部阶段的预计耗时（秒），用于第一个阶段开始前的降级判断；
+    *           0（默认）表示等第一个阶段完成后再由实测耗时估计
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void setExpectedSeconds(double seconds) { expectedSeconds_ = seconds; }
+
+    /************************************************************************
+    * 功能描述：开始计时，起始级别取 manager 当前的质量级别
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void start();
+
+    /************************************************************************
+    * 功能描述：开始一个阶段（上一阶段未调用 endPhase 时先结束之）。
+    *           timeBudget_ > 0 且 autoDegrade_ 时，若以当前级别执行剩余阶段的预计耗时超过
+    *           剩余预算 × (1 - budgetMargin_)，则逐级降低到满足预算的最高级别（最低为 VeryFast），
+    *           并调用 manager 的 applyQualityLevel；级别只降不升
+    * 返回值：MeshQualityLevel - 本阶段实际应用的质量级别
+    * 作者：邓龙威
+    /************************************************************************/
+    MeshQualityLevel beginPhase(MeshPhase phase);
+
+    /************************************************************************
+    * 功能描述：结束当前阶段，记录耗时并以累计实测耗时校准代价模型
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void endPhase();
+
+    /************************************************************************
+    * 功能描述：协作式取消检查点，可由多个线程同时调用
+    * 返回值：bool - true 表示应尽快停止：已被取消，或 hardDeadline_ 时已超出预算
+    * 作者：邓龙威
+    /************************************************************************/
+    bool checkpoint() const;
+
+    void cancel() { cancel_.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return cancel_.load(std::memory_order_relaxed); }
+
+    /************************************************************************
+    * 功能描述：包装模型边离散 / 模型面剖分回调：checkpoint 为 true 时不再调用 inner 并返回失败，
+    *           可直接传给 ComParallelSurfMesh，取消后未剖分的模型面计入 failedFace_
+    * 返回值：ComEdgeDiscretize / ComFaceMesher
+    * 作者：邓龙威
+    /************************************************************************/
+    ComEdgeDiscretize cancellableEdgeDiscretize(const ComEdgeDiscretize &inner) const;
+    ComFaceMesher cancellableFaceMesher(const ComFaceMesher &inner) const;
+
+    /************************************************************************
+    * 功能描述：以质量级别 level 执行从 phase 开始的未完成阶段的预计耗时（秒），
+    *           代价模型尚未校准时返回 0
+    * 返回值：double
+    * 作者：邓龙威
+    /************************************************************************/
+    double predict(MeshPhase phase, MeshQualityLevel level) const;
+
+    double elapsed() const;
+    MeshQualityLevel level() const { return level_; }
+
+    /************************************************************************
+    * 功能描述：执行报告，可在任意阶段之间调用
+    * 返回值：TimeBudgetReport
+    * 作者：邓龙威
+    /************************************************************************/
+    TimeBudgetReport report() const;
+
+    static std::string phaseToString(MeshPhase phase);
+    static std::string levelToString(MeshQualityLevel level);
+    static std::string reportToString(const TimeBudgetReport &report, LogFileFormat format);
+
+private:
+    double phaseCost(int phase, MeshQualityLevel level) const; // 阶段在指定级别下的相对代价
+
+    MeshTimeBudgetOptions opts_;                                       // 时间预算选项
+    ComOptionsManager &manager_;                                       // 选项管理器
+    double weight_[MeshPhaseNum] = {0.05, 0.05, 0.25, 0.15, 0.2, 0.3}; // 各阶段相对耗时（Balanced）
+    double levelCost_[MeshQualityLevelNum] = {};                       // 各级别优化代价
+    double expectedSeconds_ = 0.;                                      // 先验总耗时
+    double scale_ = 0.;                                                // 每单位代价的耗时（秒），0 表示未校准
+    double doneCost_ = 0.;                                             // 已完成阶段的代价
+    double doneSeconds_ = 0.;                                          // 已完成阶段的耗时
+    bool done_[MeshPhaseNum] = {};                                     // 阶段是否已完成
+    int phase_ = -1;                                                   // 当前阶段，-1 表示不在阶段内
+    MeshQualityLevel startLevel_ = MeshQualityLevel::Balanced;         // 起始级别
+    MeshQualityLevel level_ = MeshQualityLevel::Balanced;              // 当前级别
+    int degradeNum_ = 0;                                               // 降级次数
+    std::chrono::steady_clock::time_point start_;                      // 起始时间
+    std::chrono::steady_clock::time_point phaseStart_;                 // 当前阶段起始时间
+    std::vector<MeshPhaseRecord> records_;                             // 阶段记录
+    std::atomic<bool> cancel_{false};                                  // 外部取消标志
+    mutable std::atomic<bool> overBudget_{false};                      // 超出预算标志
+};
+
+#endif // EMMPMESH_COMMON_COMTIMEBUDGET_H_
@@ -0,0 +1,576 @@
+#include "pch.h"
+
+#include "ComTopoFlip.h"
+#include "ComParallel.h"
+#include "ComPredicates.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+static const double ComTopoWorst = -std::numeric_limits<double>::max();
+
+static inline const double *ComTopoVert(const double *coords, int v)
+{
+    return coords + 3 * static_cast<size_t>(v);
+}
+
+// 正向单元返回质量，翻转或退化单元返回最差值
+static double ComTopoTetQuality(const double *coords, int a, int b, int c, int d, const ComTetQuality &quality)
+{
+    const double *pa = ComTopoVert(coords, a), *pb = ComTopoVert(coords, b);
+    const double *pc = ComTopoVert(coords, c), *pd = ComTopoVert(coords, d);
+    if (ComOrient3d(pa, pb, pc, pd) <= 0)
+        return ComTopoWorst;
+    return quality(pa, pb, pc, pd);
+}
+
+void VertexClaim::init(int vertNum)
+{
+    vertNum_ = vertNum;
+    owner_.reset(new std::atomic<int>[vertNum]);
+    for (int v = 0; v < vertNum; ++v)
+        owner_[v].store(-1, std::memory_order_relaxed);
+}
+
+bool VertexClaim::tryClaim(const int *verts, int num, int tid)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        int expected = -1;
+        if (owner_[verts[i]].compare_exchange_strong(expected, tid, std::memory_order_acquire))
+            continue;
+        if (expected == tid)
+            continue; // 同一顶点在列表中重复出现
+
+        // 回滚本次已占用的顶点
+        for (int k = 0; k < i; ++k)
+        {
+            int mine = tid;
+            owner_[verts[k]].compare_exchange_strong(mine, -1, std::memory_order_release);
+        }
+        return false;
+    }
+    return true;
+}
+
+void VertexClaim::release(const int *verts, int num, int tid)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        int mine = tid;
+        owner_[verts[i]].compare_exchange_strong(mine, -1, std::memory_order_release);
+    }
+}
+
+TopoFlipResult ComTryFlip23(const double *coords, int a, int b, int c, int d, int e,
+                            const ComTetQuality &quality, double minImprove)
+{
+    TopoFlipResult result;
+
+    // 调整面 abc 的方向，使 d 位于正侧
+    if (ComOrient3d(ComTopoVert(coords, a), ComTopoVert(coords, b), ComTopoVert(coords, c), ComTopoVert(coords, d)) < 0)
+        std::swap(b, c);
+
+    result.oldMinQuality_ = std::min(ComTopoTetQuality(coords, a, b, c, d, quality),
+                                     ComTopoTetQuality(coords, a, c, b, e, quality));
+
+    // 新单元围绕边 de，环绕顶点为 a、b、c；三者方向必须一致，即 de 穿过三角形 abc 内部
+    int ring[3] = {a, b, c};
+    int sign[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        sign[i] = ComOrient3d(ComTopoVert(coords, d), ComTopoVert(coords, e),
+                              ComTopoVert(coords, ring[i]), ComTopoVert(coords, ring[(i + 1) % 3]));
+        if (sign[i] == 0 || sign[i] != sign[0])
+            return result;
+    }
+
+    double newMin = std::numeric_limits<double>::max();
+    for (int i = 0; i < 3; ++i)
+    {
+        int t[4] = {d, e, ring[i], ring[(i + 1) % 3]};
+        if (sign[0] < 0)
+            std::swap(t[0], t[1]);
+        newMin = std::min(newMin, ComTopoTetQuality(coords, t[0], t[1], t[2], t[3], quality));
+        result.newTets_.insert(result.newTets_.end(), t, t + 4);
+    }
+
+    result.newMinQuality_ = newMin;
+    result.improved_ = newMin > result.oldMinQuality_ + minImprove;
+    if (!result.improved_)
+        result.newTets_.clear();
+    return result;
+}
+
+TopoFlipResult ComTryEdgeRemoval(const double *coords, int a, int b, const std::vector<int> &ringIn,
+                                 const ComTetQuality &quality, double minImprove, int maxRing)
+{
+    TopoFlipResult result;
+    int m = static_cast<int>(ringIn.size());
+    if (m < 3 || m > maxRing)
+        return result;
+
+    // 调整环绕方向，使旧单元 (a, b, r_i, r_i+1) 为正向
+    std::vector<int> ring = ringIn;
+    if (ComOrient3d(ComTopoVert(coords, a), ComTopoVert(coords, b),
+                    ComTopoVert(coords, ring[0]), ComTopoVert(coords, ring[1])) < 0)
+        std::reverse(ring.begin(), ring.end());
+
+    double oldMin = std::numeric_limits<double>::max();
+    for (int i = 0; i < m; ++i)
+        oldMin = std::min(oldMin, ComTopoTetQuality(coords, a, b, ring[i], ring[(i + 1) % m], quality));
+    result.oldMinQuality_ = oldMin;
+
+    // 三角形 (r_i, r_k, r_j)（i < k < j）对应新单元 (r_i, r_k, r_j, b) 与 (r_i, r_j, r_k, a)
+    auto triQuality = [&](int i, int k, int j) {
+        return std::min(ComTopoTetQuality(coords, ring[i], ring[k], ring[j], b, quality),
+                        ComTopoTetQuality(coords, ring[i], ring[j], ring[k], a, quality));
+    };
+
+    // 动态规划：best[i][j] 为子多边形 r_i..r_j 三角剖分的最大最差质量，split[i][j] 为对应分割点
+    std::vector<double> best(static_cast<size_t>(m) * m, std::numeric_limits<double>::max());
+    std::vector<int> split(static_cast<size_t>(m) * m, -1);
+    for (int len = 2; len < m; ++len)
+    {
+        for (int i = 0; i + len < m; ++i)
+        {
+            int j = i + len;
+            double bestQ = ComTopoWorst;
+            for (int k = i + 1; k < j; ++k)
+            {
+                double q = std::min({best[i * m + k], best[k * m + j], triQuality(i, k, j)});
+                if (q > bestQ || split[i * m + j] < 0)
+                {
+                    bestQ = q;
+                    split[i * m + j] = k;
+                }
+            }
+            best[i * m + j] = bestQ;
+        }
+    }
+
+    result.newMinQuality_ = best[m - 1];
+    result.improved_ = result.newMinQuality_ > oldMin + minImprove;
+    if (!result.improved_)
+        return result;
+
+    // 回溯三角剖分
+    std::vector<std::pair<int, int>> stack = {{0, m - 1}};
+    while (!stack.empty())
+    {
+        auto [i, j] = stack.back();
+        stack.pop_back();
+        if (j - i < 2)
+            continue;
+        int k = split[i * m + j];
+        int tb[4] = {ring[i], ring[k], ring[j], b};
+        int ta[4] = {ring[i], ring[j], ring[k], a};
+        result.newTets_.insert(result.newTets_.end(), tb, tb + 4);
+        result.newTets_.insert(result.newTets_.end(), ta, ta + 4);
+        stack.push_back({i, k});
+        stack.push_back({k, j});
+    }
+    return result;
+}
+
+void ComCompactTets(std::vector<int> &tets, std::vector<int> &neig, std::vector<double> &quality,
+                    const std::vector<char> &dead)
+{
+    int allTetNum = static_cast<int>(dead.size());
+    std::vector<int> newID(allTetNum, -1);
+    int keep = 0;
+    for (int t = 0; t < allTetNum; ++t)
+    {
+        if (!dead[t])
+            newID[t] = keep++;
+    }
+    if (keep == allTetNum)
+        return;
+    for (int t = 0; t < allTetNum; ++t)
+    {
+        if (dead[t])
+            continue;
+        int id = newID[t];
+        for (int i = 0; i < 4; ++i)
+        {
+            tets[4 * id + i] = tets[4 * t + i];
+            int n = neig[4 * t + i];
+            neig[4 * id + i] = n < 0 ? -1 : newID[n];
+        }
+        quality[id] = quality[t];
+    }
+    tets.resize(4 * static_cast<size_t>(keep));
+    neig.resize(4 * static_cast<size_t>(keep));
+    quality.resize(keep);
+}
+
+void TopoOptiStat::merge(const TopoOptiStat &other)
+{
+    roundNum_ += other.roundNum_;
+    candidateNum_ += other.candidateNum_;
+    conflictNum_ += other.conflictNum_;
+    flip23Num_ += other.flip23Num_;
+    flip32Num_ += other.flip32Num_;
+    flip44Num_ += other.flip44Num_;
+    edgeRemovalNum_ += other.edgeRemovalNum_;
+    minQualityAfter_ = other.minQualityAfter_;
+}
+
+// 一次拓扑操作，在本轮开始时的网格上求得，执行时只写入
+struct TopoOp
+{
+    int source_ = -1;                // 触发该操作的劣质单元
+    int ring_ = 0;                   // 0 为 2-3 翻转，否则为边删除的环绕顶点数
+    std::vector<int> oldTets_;       // 被替换的单元
+    std::vector<int> verts_;         // 需占用的顶点（去重）
+    std::vector<int> newTets_;       // 新单元，每 4 个顶点一个
+    std::vector<double> newQuality_; // 新单元质量
+    std::vector<int> newNeig_;       // 新单元各面的相邻：>= 0 为外侧单元，-1 为网格边界，<= -2 为第 (-2 - k) 个新单元
+    std::vector<int> outerFace_;     // 外侧单元中对应面的局部编号
+};
+
+// 补全操作的占用顶点与新单元邻接：新单元的外表面必须与被替换单元的外表面逐一对应
+static bool ComTopoBuildOp(const int *tets, const int *neig, const double *coords, const ComTetQuality &qualityFunc,
+                           TopoOp &op)
+{
+    std::map<std::array<int, 3>, std::pair<int, int>> outer; // 外表面 -> (外侧单元, 外侧局部面)
+    for (int o : op.oldTets_)
+    {
+        const int *tet = tets + 4 * static_cast<size_t>(o);
+        op.verts_.insert(op.verts_.end(), tet, tet + 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            int n = neig[4 * static_cast<size_t>(o) + i];
+            if (n >= 0 && std::find(op.oldTets_.begin(), op.oldTets_.end(), n) != op.oldTets_.end())
+                continue;
+            std::array<int, 3> key = ComTetFace(tet, i);
+            int j = -1;
+            if (n >= 0)
+            {
+                std::array<int, 3> outerKey = ComFaceReverse(key);
+                for (j = 0; j < 4 && ComTetFace(tets + 4 * static_cast<size_t>(n), j) != outerKey; ++j)
+                    ;
+                if (j == 4)
+                    return false;
+            }
+            outer[key] = {n, j};
+        }
+    }
+    std::sort(op.verts_.begin(), op.verts_.end());
+    op.verts_.erase(std::unique(op.verts_.begin(), op.verts_.end()), op.verts_.end());
+
+    int newTetNum = static_cast<int>(op.newTets_.size() / 4);
+    std::map<std::array<int, 3>, int> inner; // 新单元内部面 -> 新单元序号
+    op.newNeig_.assign(4 * static_cast<size_t>(newTetNum), -1);
+    op.outerFace_.assign(4 * static_cast<size_t>(newTetNum), -1);
+    for (int k = 0; k < newTetNum; ++k)
+    {
+        const int *tet = op.newTets_.data() + 4 * k;
+        for (int i = 0; i < 4; ++i)
+        {
+            std::array<int, 3> key = ComTetFace(tet, i);
+            auto it = outer.find(key);
+            if (it != outer.end())
+            {
+                op.newNeig_[4 * k + i] = it->second.first;
+                op.outerFace_[4 * k + i] = it->second.second;
+                outer.erase(it);
+            }
+            else
+            {
+                inner[key] = k;
+            }
+        }
+    }
+    if (!outer.empty())
+        return false;
+    for (int k = 0; k < newTetNum; ++k)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            if (op.outerFace_[4 * k + i] >= 0 || op.newNeig_[4 * k + i] >= 0)
+                continue;
+            std::array<int, 3> key = ComTetFace(op.newTets_.data() + 4 * k, i);
+            if (inner.count(key) == 0)
+                continue; // 对应网格边界的外表面
+            auto it = inner.find(ComFaceReverse(key));
+            if (it == inner.end())
+                return false;
+            op.newNeig_[4 * k + i] = -2 - it->second;
+        }
+    }
+
+    op.newQuality_.resize(newTetNum);
+    for (int k = 0; k < newTetNum; ++k)
+    {
+        const int *tet = op.newTets_.data() + 4 * k;
+        op.newQuality_[k] = qualityFunc(ComTopoVert(coords, tet[0]), ComTopoVert(coords, tet[1]),
+                                        ComTopoVert(coords, tet[2]), ComTopoVert(coords, tet[3]));
+    }
+    return true;
+}
+
+// 环绕边 ab 的顶点与单元，从单元 t（另两个顶点为 c、d）出发绕行一周；遇到网格边界或超过 maxRing 返回 false
+static bool ComTopoEdgeRing(const int *tets, const int *neig, int t, int a, int b, int c, int d, int maxRing,
+                            std::vector<int> &ring, std::vector<int> &around)
+{
+    ring.assign({c, d});
+    around.assign(1, t);
+    int cur = t, u = c, w = d;
+    while (true)
+    {
+        const int *tet = tets + 4 * static_cast<size_t>(cur);
+        int li = static_cast<int>(std::find(tet, tet + 4, u) - tet);
+        int n = neig[4 * static_cast<size_t>(cur) + li];
+        if (n < 0)
+            return false;
+        const int *nt = tets + 4 * static_cast<size_t>(n);
+        int z = -1;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (nt[i] != a && nt[i] != b && nt[i] != w)
+                z = nt[i];
+        }
+        around.push_back(n);
+        if (z == ring[0])
+            return true;
+        if (static_cast<int>(ring.size()) >= maxRing || n == t)
+            return false;
+        ring.push_back(z);
+        u = w;
+        w = z;
+        cur = n;
+    }
+}
+
+// 在本轮开始时的网格上为劣质单元 t 求改善最多的操作
+static bool ComTopoBestOp(const double *coords, const int *tets, const int *neig, int t,
+                          const MeshTopoOptiOptions &opts, const ComTetQuality &qualityFunc, TopoOp &op)
+{
+    const int *tet = tets + 4 * static_cast<size_t>(t);
+    double bestQ = ComTopoWorst;
+    TopoFlipResult best;
+    std::vector<int> bestOld;
+    int bestRing = 0;
+
+    if (opts.useFlip23_)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            int n = neig[4 * static_cast<size_t>(t) + i];
+            if (n < 0)
+                continue;
+            int a = tet[ComTetFaceVert[i][0]], b = tet[ComTetFaceVert[i][1]], c = tet[ComTetFaceVert[i][2]];
+            const int *nt = tets + 4 * static_cast<size_t>(n);
+            int e = -1;
+            for (int k = 0; k < 4; ++k)
+            {
+                if (nt[k] != a && nt[k] != b && nt[k] != c)
+                    e = nt[k];
+            }
+            TopoFlipResult r = ComTryFlip23(coords, a, b, c, tet[i], e, qualityFunc, opts.minImprove_);
+            if (r.improved_ && r.newMinQuality_ > bestQ)
+            {
+                bestQ = r.newMinQuality_;
+                best = std::move(r);
+                bestOld = {t, n};
+                bestRing = 0;
+            }
+        }
+    }
+
+    if (opts.useEdgeRemoval_ && opts.maxEdgeRing_ >= 3)
+    {
+        static const int edge[6][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 2, 0, 3}, {1, 3, 2, 0}, {2, 3, 0, 1}};
+        std::vector<int> ring, around;
+        for (const auto &ed : edge)
+        {
+            int a = tet[ed[0]], b = tet[ed[1]];
+            if (!ComTopoEdgeRing(tets, neig, t, a, b, tet[ed[2]], tet[ed[3]], opts.maxEdgeRing_, ring, around))
+                continue;
+            TopoFlipResult r = ComTryEdgeRemoval(coords, a, b, ring, qualityFunc, opts.minImprove_, opts.maxEdgeRing_);
+            if (r.improved_ && r.newMinQuality_ > bestQ)
+            {
+                bestQ = r.newMinQuality_;
+                best = std::move(r);
+                bestOld = around;
+                bestRing = static_cast<int>(ring.size());
+            }
+        }
+    }
+
+    if (bestOld.empty())
+        return false;
+    op.source_ = t;
+    op.ring_ = bestRing;
+    op.oldTets_ = std::move(bestOld);
+    op.newTets_ = std::move(best.newTets_);
+    return ComTopoBuildOp(tets, neig, coords, qualityFunc, op);
+}
+
+static double ComTopoMinQuality(const std::vector<double> &quality)
+{
+    return quality.empty() ? 0. : *std::min_element(quality.begin(), quality.end());
+}
+
+TopoOptiStat ComTopoOptimize(const std::vector<double> &coords, std::vector<int> &tets, std::vector<int> &neig,
+                             std::vector<double> &quality, double badQuality, const MeshTopoOptiOptions &opts,
+                             const ComTetQuality &qualityFunc, int threadNum, int maxRound)
+{
+    TopoOptiStat stat;
+    stat.minQualityBefore_ = ComTopoMinQuality(quality);
+    stat.minQualityAfter_ = stat.minQualityBefore_;
+    threadNum = ComThreadNum(threadNum);
+    int vertNum = static_cast<int>(coords.size() / 3);
+    VertexClaim claim;
+
+    for (int round = 0; round < maxRound; ++round)
+    {
+        int tetNum = static_cast<int>(tets.size() / 4);
+        std::vector<int> bad;
+        for (int t = 0; t < tetNum; ++t)
+        {
+            if (quality[t] < badQuality)
+                bad.push_back(t);
+        }
+        if (bad.empty())
+            break;
+        std::stable_sort(bad.begin(), bad.end(), [&quality](int a, int b) { return quality[a] < quality[b]; });
+
+        // 1. 并行求各劣质单元的最佳操作，只读网格
+        std::vector<TopoOp> ops(bad.size());
+        std::vector<char> found(bad.size(), 0);
+        ComParallelFor(0, static_cast<int>(bad.size()), threadNum, [&](int, int first, int last) {
+            for (int i = first; i < last; ++i)
+                found[i] = ComTopoBestOp(coords.data(), tets.data(), neig.data(), bad[i], opts, qualityFunc, ops[i]);
+        });
+        std::vector<int> live;
+        int extra = 0;
+        for (int i = 0; i < static_cast<int>(ops.size()); ++i)
+        {
+            if (!found[i])
+                continue;
+            live.push_back(i);
+            extra += std::max(0, static_cast<int>(ops[i].newTets_.size() / 4 - ops[i].oldTets_.size()));
+        }
+        stat.candidateNum_ += static_cast<int>(live.size());
+        if (live.empty())
+            break;
+        ++stat.roundNum_;
+
+        // 2. 为新增单元预留编号，最差优先并行占用顶点并执行；占用在本轮内不释放
+        tets.resize(tets.size() + 4 * static_cast<size_t>(extra), -1);
+        neig.resize(neig.size() + 4 * static_cast<size_t>(extra), -1);
+        quality.resize(quality.size() + extra, 0.);
+        std::vector<char> dead(tetNum + extra, 0);
+        std::fill(dead.begin() + tetNum, dead.end(), 1);
+        std::atomic<int> nextSlot(tetNum);
+        std::atomic<int> conflict(0);
+        std::vector<char> done(ops.size(), 0);
+        claim.init(vertNum);
+
+        ComParallelFor(0, static_cast<int>(live.size()), threadNum, [&](int, int first, int last) {
+            std::vector<int> ids;
+            for (int li = first; li < last; ++li)
+            {
+                int i = live[li];
+                TopoOp &op = ops[i];
+                if (!claim.tryClaim(op.verts_.data(), static_cast<int>(op.verts_.size()), i))
+                {
+                    conflict.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                int oldNum = static_cast<int>(op.oldTets_.size());
+                int newNum = static_cast<int>(op.newTets_.size() / 4);
+                ids.assign(op.oldTets_.begin(), op.oldTets_.begin() + std::min(oldNum, newNum));
+                if (newNum > oldNum)
+                {
+                    int slot = nextSlot.fetch_add(newNum - oldNum, std::memory_order_relaxed);
+                    for (int k = 0; k < newNum - oldNum; ++k)
+                    {
+                        ids.push_back(slot + k);
+                        dead[slot + k] = 0;
+                    }
+                }
+                for (int k = newNum; k < oldNum; ++k)
+                    dead[op.oldTets_[k]] = 1;
+
+                for (int k = 0; k < newNum; ++k)
+                {
+                    int id = ids[k];
+                    quality[id] = op.newQuality_[k];
+                    for (int f = 0; f < 4; ++f)
+                    {
+                        tets[4 * static_cast<size_t>(id) + f] = op.newTets_[4 * k + f];
+                        int n = op.newNeig_[4 * k + f];
+                        neig[4 * static_cast<size_t>(id) + f] = n <= -2 ? ids[-2 - n] : n;
+                        if (n >= 0)
+                            neig[4 * static_cast<size_t>(n) + op.outerFace_[4 * k + f]] = id;
+                    }
+                }
+                done[i] = 1;
+            }
+        });
+        stat.conflictNum_ += conflict.load();
+
+        for (int i : live)
+        {
+            if (!done[i])
+                continue;
+            int ring = ops[i].ring_;
+            if (ring == 0)
+                ++stat.flip23Num_;
+            else if (ring == 3)
+                ++stat.flip32Num_;
+            else if (ring == 4)
+                ++stat.flip44Num_;
+            else
+                ++stat.edgeRemovalNum_;
+        }
+
+        // 3. 压缩删除多余单元与未使用的预留编号
+        ComCompactTets(tets, neig, quality, dead);
+    }
+
+    stat.minQualityAfter_ = ComTopoMinQuality(quality);
+    return stat;
+}
+
+TopoOptiStat ComSmoothWithTopoOpti(const MeshOptiOptions &opts, std::vector<double> &coords, std::vector<int> &tets,
+                                   std::vector<int> &neig, std::vector<double> &quality,
+                                   const ComTetQuality &qualityFunc, const ComSmoothPass &smooth)
+{
+    TopoOptiStat stat;
+    bool topoChanged = false;
+    bool firstPass = true;
+    for (int iter = 0; iter < opts.ConsecuIterNum_; ++iter)
+    {
+        if (!smooth(iter, topoChanged))
+            break;
+        topoChanged = false;
+        if (opts.topoOptiInterval_ <= 0 || (iter + 1) % opts.topoOptiInterval_ != 0)
+            continue;
+
+        // 光滑移动了顶点，先按当前坐标重算单元质量
+        int tetNum = static_cast<int>(tets.size() / 4);
+        quality.resize(tetNum);
+        ComParallelFor(0, tetNum, opts.threadNum_, [&](int, int first, int last) {
+            for (int t = first; t < last; ++t)
+            {
+                const int *tet = tets.data() + 4 * static_cast<size_t>(t);
+                quality[t] = ComTopoTetQuality(coords.data(), tet[0], tet[1], tet[2], tet[3], qualityFunc);
+            }
+        });
+
+        TopoOptiStat pass = ComTopoOptimize(coords, tets, neig, quality, opts.badRegionQuality_, opts.topoOptiOptions_,
+                                            qualityFunc, opts.threadNum_);
+        topoChanged = pass.opNum() > 0;
+        if (firstPass)
+            stat.minQualityBefore_ = pass.minQualityBefore_;
+        firstPass = false;
+        stat.merge(pass);
+    }
+    return stat;
+}
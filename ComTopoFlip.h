@@ -0,0 +1,150 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComTopoFlip.h
+// 摘    要：四面体网格拓扑优化局部算子（2-3 翻转、边删除，含 3-2 与 4-4 翻转），
+//           并行处理时使用的无锁顶点占用标记，以及并行拓扑优化驱动与光滑交替执行
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMTOPOFLIP_H_
+#define EMMPMESH_COMMON_COMTOPOFLIP_H_
+
+#include "ComConstants.h"
+#include "ComTetFace.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// 单元质量函数：输入正向四面体的 4 个顶点坐标，返回质量（越大越好，由 MeshQualityMetric 决定）
+using ComTetQuality = std::function<double(const double *pa, const double *pb, const double *pc, const double *pd)>;
+
+// 拓扑操作结果
+struct TopoFlipResult
+{
+    bool improved_ = false;       // 是否改善（新单元最差质量 > 旧单元最差质量 + minImprove）
+    double oldMinQuality_ = 0.;   // 旧单元最差质量
+    double newMinQuality_ = 0.;   // 新单元最差质量
+    std::vector<int> newTets_;    // 新单元（每 4 个顶点一个，均为正向）
+};
+
+// 无锁顶点占用标记：拓扑操作前原子地占用操作涉及的全部顶点，占用失败则放弃该操作，
+// 保证并行执行的操作互不重叠
+class VertexClaim
+{
+public:
+    VertexClaim() = default;
+
+    /************************************************************************
+    * 功能描述：初始化顶点个数，全部置为未占用
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void init(int vertNum);
+
+    /************************************************************************
+    * 功能描述：以线程 tid 占用 verts 中的 num 个顶点（CAS），任一顶点已被其他线程占用则
+    *           回滚已占用部分并返回 false
+    * 返回值：bool - 是否全部占用成功
+    * 作者：邓龙威
+    /************************************************************************/
+    bool tryClaim(const int *verts, int num, int tid);
+
+    /************************************************************************
+    * 功能描述：释放线程 tid 占用的 verts
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void release(const int *verts, int num, int tid);
+
+private:
+    int vertNum_ = 0;                          // 顶点个数
+    std::unique_ptr<std::atomic<int>[]> owner_; // 占用线程，-1 表示未占用
+};
+
+/************************************************************************
+* 功能描述：2-3 翻转（面删除）。共享面 abc 的两个单元 abcd、abce（d、e 位于面两侧）
+*           替换为 abde、bcde、cade，要求 de 穿过三角形 abc 内部
+* 返回值：TopoFlipResult
+* 作者：邓龙威
+/************************************************************************/
+TopoFlipResult ComTryFlip23(const double *coords, int a, int b, int c, int d, int e,
+                            const ComTetQuality &quality, double minImprove);
+
+/************************************************************************
+* 功能描述：边删除。删除边 ab，其环绕顶点 ring（按环绕顺序，m 个）构成的多边形以
+*           动态规划求最差质量最大的三角剖分，每个三角形与 a、b 各组成一个新单元。
+*           m = 3 即 3-2 翻转，m = 4 即 4-4 翻转；m 超过 maxRing 时直接放弃
+* 返回值：TopoFlipResult
+* 作者：邓龙威
+/************************************************************************/
+TopoFlipResult ComTryEdgeRemoval(const double *coords, int a, int b, const std::vector<int> &ring,
+                                 const ComTetQuality &quality, double minImprove, int maxRing);
+
+/************************************************************************
+* 功能描述：压缩删除 dead 标记的单元，同步更新 tets、neig（按新编号重映射）与 quality，
+*           保留单元的相对顺序不变
+* 返回值：无
+* 作者：邓龙威
+/************************************************************************/
+void ComCompactTets(std::vector<int> &tets, std::vector<int> &neig, std::vector<double> &quality,
+                    const std::vector<char> &dead);
+
+// 并行拓扑优化统计
+struct TopoOptiStat
+{
+    int roundNum_ = 0;             // 执行轮数
+    int candidateNum_ = 0;         // 找到改善操作的劣质单元个数（各轮之和）
+    int conflictNum_ = 0;          // 顶点占用失败而推迟到下一轮的操作个数
+    int flip23Num_ = 0;            // 2-3 翻转次数
+    int flip32Num_ = 0;            // 3-2 翻转次数（环绕 3 个顶点的边删除）
+    int flip44Num_ = 0;            // 4-4 翻转次数（环绕 4 个顶点的边删除）
+    int edgeRemovalNum_ = 0;       // 环绕 5 个及以上顶点的边删除次数
+    double minQualityBefore_ = 0.; // 优化前最差单元质量
+    double minQualityAfter_ = 0.;  // 优化后最差单元质量
+
+    int opNum() const { return flip23Num_ + flip32Num_ + flip44Num_ + edgeRemovalNum_; }
+
+    /************************************************************************
+    * 功能描述：累加之后的另一次拓扑优化的统计，优化后最差质量取 other 的值
+    * 返回值：无
+    * 作者：邓龙威
+    /************************************************************************/
+    void merge(const TopoOptiStat &other);
+};
+
+/************************************************************************
+* 功能描述：并行拓扑优化。每一轮：
+*           1. 并行为每个质量低于 badQuality 的单元在本轮开始时的网格上求改善最多的操作
+*              （经各面的 2-3 翻转、各边的边删除，按 opts 开关与 maxEdgeRing_），只读网格；
+*           2. 操作按原单元质量升序（最差优先）并行执行：以 VertexClaim 无锁占用被替换单元的全部顶点，
+*              占用成功即写入新单元、质量与邻接（包括外侧相邻单元的 neig），顶点在本轮内不释放，
+*              因此同一轮执行的操作互不重叠；占用失败的操作推迟到下一轮；
+*           3. 压缩删除多余单元。
+*           没有可执行的操作或达到 maxRound 轮时结束。quality 须与 qualityFunc 一致，
+*           单元须为正向，neig 为 neigRegionID 格式
+* 返回值：TopoOptiStat
+* 作者：邓龙威
+/************************************************************************/
+TopoOptiStat ComTopoOptimize(const std::vector<double> &coords, std::vector<int> &tets, std::vector<int> &neig,
+                             std::vector<double> &quality, double badQuality, const MeshTopoOptiOptions &opts,
+                             const ComTetQuality &qualityFunc, int threadNum, int maxRound = 8);
+
+// 光滑回调：执行第 iter 次连续迭代（一遍光滑，移动 coords），topoChanged 表示上一遍之后
+// tets / neig 已被拓扑优化改变，调用方需据此重建顶点-单元关联等缓存；返回 false 时提前结束
+using ComSmoothPass = std::function<bool(int iter, bool topoChanged)>;
+
+/************************************************************************
+* 功能描述：光滑与拓扑优化交替执行。执行 opts.ConsecuIterNum_ 次连续迭代，topoOptiInterval_ > 0 时
+*           每 topoOptiInterval_ 次迭代后并行重算单元质量，并以 badRegionQuality_ 与 topoOptiOptions_
+*           调用 ComTopoOptimize（线程数为 threadNum_）；topoOptiInterval_ 为 0 时只做光滑
+* 返回值：TopoOptiStat - 各次拓扑优化的累计统计
+* 作者：邓龙威
+/************************************************************************/
+TopoOptiStat ComSmoothWithTopoOpti(const MeshOptiOptions &opts, std::vector<double> &coords, std::vector<int> &tets,
+                                   std::vector<int> &neig, std::vector<double> &quality,
+                                   const ComTetQuality &qualityFunc, const ComSmoothPass &smooth);
+
+#endif // EMMPMESH_COMMON_COMTOPOFLIP_H_
@@ -0,0 +1,493 @@
+#include "pch.h"
+
+#include "ComVTUWriter.h"
+#include "ComParallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <vector>
+
+#ifdef EMMPMESH_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef EMMPMESH_WITH_LZ4
+#include <lz4.h>
+#endif
+
+// DataArray 的一段数据：直接引用网格缓冲区（不复制），或由 generate_ 按值区间生成
+struct VTUSegment
+{
+    const char *data_ = nullptr;                                        // 引用的缓冲区，为空时使用 generate_
+    size_t bytes_ = 0;                                                  // 字节数
+    std::function<void(size_t first, size_t num, char *out)> generate_; // 生成第 [first, first + num) 个值
+};
+
+// 一个 appended DataArray
+struct VTUArray
+{
+    std::string name_;              // 名称，Points 的坐标数组为空
+    const char *type_ = "Float64";  // VTK 数据类型
+    int compNum_ = 1;               // 分量个数
+    size_t valueSize_ = 8;          // 单个值的字节数
+    std::vector<VTUSegment> segs_;  // 按顺序拼接的数据段
+    size_t bytes_ = 0;              // 总字节数
+    std::streamoff offsetPos_ = 0;  // XML 中 offset 占位符的位置
+    uint64_t offset_ = 0;           // 相对于 appended 数据起点的偏移
+};
+
+static const int ComVTUOffsetWidth = 20; // offset 占位符宽度，足以容纳 uint64_t
+
+bool ComVTUCompressorAvailable(VTKCompressor compressor)
+{
+    switch (compressor)
+    {
+    case VTKCompressor::NONE:
+        return true;
+    case VTKCompressor::ZLIB:
+#ifdef EMMPMESH_WITH_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case VTKCompressor::LZ4:
+#ifdef EMMPMESH_WITH_LZ4
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+// 压缩后的最大字节数
+static size_t ComVTUCompressBound([[maybe_unused]] VTKCompressor compressor, size_t size)
+{
+#ifdef EMMPMESH_WITH_ZLIB
+    if (compressor == VTKCompressor::ZLIB)
+        return static_cast<size_t>(compressBound(static_cast<uLong>(size)));
+#endif
+#ifdef EMMPMESH_WITH_LZ4
+    if (compressor == VTKCompressor::LZ4)
+        return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+#endif
+    return size;
+}
+
+// 压缩一个块，返回压缩后字节数，失败返回 0（未启用压缩库时参数均不使用）
+static size_t ComVTUCompress([[maybe_unused]] VTKCompressor compressor, [[maybe_unused]] int level,
+                             [[maybe_unused]] const char *src, [[maybe_unused]] size_t size,
+                             [[maybe_unused]] char *dst, [[maybe_unused]] size_t capacity)
+{
+#ifdef EMMPMESH_WITH_ZLIB
+    if (compressor == VTKCompressor::ZLIB)
+    {
+        uLongf len = static_cast<uLongf>(capacity);
+        int ret = compress2(reinterpret_cast<Bytef *>(dst), &len, reinterpret_cast<const Bytef *>(src),
+                            static_cast<uLong>(size), std::max(1, std::min(9, level)));
+        return ret == Z_OK ? static_cast<size_t>(len) : 0;
+    }
+#endif
+#ifdef EMMPMESH_WITH_LZ4
+    if (compressor == VTKCompressor::LZ4)
+    {
+        int len = LZ4_compress_fast(src, dst, static_cast<int>(size), static_cast<int>(capacity), std::max(1, level));
+        return len > 0 ? static_cast<size_t>(len) : 0;
+    }
+#endif
+    return 0;
+}
+
+// 读取 [offset, offset + size) 的数据：落在一个引用段内时直接返回其指针，否则拼接到 scratch
+static const char *ComVTUBlock(const VTUArray &a, size_t offset, size_t size, char *scratch)
+{
+    size_t segStart = 0;
+    char *out = scratch;
+    size_t end = offset + size;
+    for (const auto &seg : a.segs_)
+    {
+        size_t segEnd = segStart + seg.bytes_;
+        if (segEnd > offset && segStart < end)
+        {
+            size_t first = std::max(offset, segStart);
+            size_t last = std::min(end, segEnd);
+            if (seg.data_ && first == offset && last == end)
+                return seg.data_ + (first - segStart);
+            if (seg.data_)
+                std::memcpy(out, seg.data_ + (first - segStart), last - first);
+            else
+                seg.generate_((first - segStart) / a.valueSize_, (last - first) / a.valueSize_, out);
+            out += last - first;
+        }
+        segStart = segEnd;
+        if (segStart >= end)
+            break;
+    }
+    return scratch;
+}
+
+template <typename T>
+static const TypedVectorHolder<T> *ComVTUHolder(const VectorHolder *holder)
+{
+    return dynamic_cast<const TypedVectorHolder<T> *>(holder);
+}
+
+template <typename T>
+static VTUSegment ComVTUSegment(const TypedVectorHolder<T> *holder)
+{
+    VTUSegment seg;
+    seg.data_ = reinterpret_cast<const char *>(holder->data_typed());
+    seg.bytes_ = holder->size() * sizeof(T);
+    return seg;
+}
+
+int ComWriteVTU(const std::string &filePath, const Mesh &mesh, const MeshAttr *attr, const MeshVTKIOOptions &opts,
+                VTUWriteStat *stat)
+{
+    auto start = std::chrono::steady_clock::now();
+    VTUWriteStat s;
+
+    auto vertIt = mesh.find(MeshElementType::Vertex);
+    const auto *verts = vertIt == mesh.end() ? nullptr : ComVTUHolder<double>(vertIt->second.get());
+    if (!verts)
+        return 2;
+    size_t pointNum = verts->size() / 3;
+
+    // 输出单元类型：按 Edge、Face、Region 顺序
+    static const MeshElementType cellOrder[] = {MeshElementType::Edge, MeshElementType::Face, MeshElementType::Region};
+    static const unsigned char cellVTKType[] = {3, 5, 10}; // VTK_LINE / VTK_TRIANGLE / VTK_TETRA
+    auto cellHolder = [&mesh](MeshElementType type) -> const TypedVectorHolder<int> * {
+        auto it = mesh.find(type);
+        return it == mesh.end() || !it->second ? nullptr : ComVTUHolder<int>(it->second.get());
+    };
+    std::vector<int> cellKinds;
+    for (int k = 0; k < 3; ++k)
+    {
+        bool wanted = std::find(opts.meshEleOut_.begin(), opts.meshEleOut_.end(), cellOrder[k]) != opts.meshEleOut_.end();
+        if (wanted && cellHolder(cellOrder[k]))
+            cellKinds.push_back(k);
+    }
+    if (cellKinds.empty())
+    {
+        for (int k : {2, 1})
+        {
+            const auto *h = cellHolder(cellOrder[k]);
+            if (h && !h->empty())
+            {
+                cellKinds.push_back(k);
+                break;
+            }
+        }
+    }
+
+    std::vector<size_t> cellNums;
+    size_t cellNum = 0;
+    for (int k : cellKinds)
+    {
+        cellNums.push_back(cellHolder(cellOrder[k])->size() / MeshElementSize.at(cellOrder[k]));
+        cellNum += cellNums.back();
+    }
+
+    // 属性数组
+    auto attrArray = [attr](MeshElementType type, const std::string &name, size_t count, VTUArray &a) -> bool {
+        if (!attr || count == 0)
+            return false;
+        auto typeIt = attr->find(type);
+        if (typeIt == attr->end())
+            return false;
+        auto it = typeIt->second.find(name);
+        if (it == typeIt->second.end() || !it->second.first)
+            return false;
+        VTUSegment seg;
+        const char *vtkType = "Float64";
+        size_t valueSize = sizeof(double);
+        if (it->second.second == MeshAttrDataType::Int)
+        {
+            const auto *h = ComVTUHolder<int>(it->second.first.get());
+            if (!h)
+                return false;
+            seg = ComVTUSegment(h);
+            vtkType = "Int32";
+            valueSize = sizeof(int);
+        }
+        else
+        {
+            const auto *h = ComVTUHolder<double>(it->second.first.get());
+            if (!h)
+                return false;
+            seg = ComVTUSegment(h);
+        }
+        size_t valueNum = seg.bytes_ / valueSize;
+        int compNum = static_cast<int>(valueNum / count);
+        if (compNum <= 0 || valueNum != static_cast<size_t>(compNum) * count)
+            return false;
+        // 多种单元类型拼接时数据类型与分量数须一致
+        if (!a.segs_.empty() && (compNum != a.compNum_ || valueSize != a.valueSize_))
+            return false;
+        a.type_ = vtkType;
+        a.valueSize_ = valueSize;
+        a.compNum_ = compNum;
+        a.name_ = name;
+        a.bytes_ += seg.bytes_;
+        a.segs_.push_back(seg);
+        return true;
+    };
+
+    std::vector<std::pair<std::string, MeshElementType>> attrNames;
+    if (!opts.meshAttrOut_.empty())
+    {
+        for (const auto &entry : opts.meshAttrOut_)
+            attrNames.push_back({std::get<0>(entry), std::get<3>(entry)});
+    }
+    else if (attr)
+    {
+        // 按名称排序，输出与哈希表遍历顺序无关
+        std::map<std::string, int> names[MeshElementTypeNum];
+        for (const auto &typeAttrs : *attr)
+        {
+            for (const auto &kv : typeAttrs.second)
+                names[static_cast<int>(typeAttrs.first)][kv.first] = 0;
+        }
+        for (int t = 0; t < MeshElementTypeNum; ++t)
+        {
+            for (const auto &kv : names[t])
+                attrNames.push_back({kv.first, static_cast<MeshElementType>(t)});
+        }
+    }
+
+    std::vector<VTUArray> pointData;
+    std::vector<VTUArray> cellData;
+    for (const auto &an : attrNames)
+    {
+        VTUArray a;
+        if (an.second == MeshElementType::Vertex)
+        {
+            if (attrArray(MeshElementType::Vertex, an.first, pointNum, a))
+                pointData.push_back(std::move(a));
+            continue;
+        }
+        bool all = !cellKinds.empty();
+        bool used = false;
+        for (size_t i = 0; i < cellKinds.size() && all; ++i)
+        {
+            used = used || cellOrder[cellKinds[i]] == an.second;
+            all = attrArray(cellOrder[cellKinds[i]], an.first, cellNums[i], a);
+        }
+        bool duplicate = false;
+        for (const auto &c : cellData)
+            duplicate = duplicate || c.name_ == an.first;
+        if (all && used && !duplicate)
+            cellData.push_back(std::move(a));
+    }
+
+    // 坐标与单元数组：connectivity 直接引用网格缓冲区，offsets 与 types 按块生成
+    VTUArray points;
+    points.compNum_ = 3;
+    points.segs_.push_back(ComVTUSegment(verts));
+    points.bytes_ = points.segs_[0].bytes_;
+
+    VTUArray conn, offsets, types;
+    conn.name_ = "connectivity";
+    conn.type_ = "Int32";
+    conn.valueSize_ = sizeof(int);
+    offsets.name_ = "offsets";
+    offsets.type_ = "Int64";
+    types.name_ = "types";
+    types.type_ = "UInt8";
+    types.valueSize_ = 1;
+    int64_t base = 0;
+    for (size_t i = 0; i < cellKinds.size(); ++i)
+    {
+        int k = cellKinds[i];
+        int64_t nodeNum = MeshElementSize.at(cellOrder[k]);
+        VTUSegment seg = ComVTUSegment(cellHolder(cellOrder[k]));
+        seg.bytes_ = cellNums[i] * nodeNum * sizeof(int);
+        conn.segs_.push_back(seg);
+        conn.bytes_ += seg.bytes_;
+
+        VTUSegment offSeg;
+        offSeg.bytes_ = cellNums[i] * sizeof(int64_t);
+        offSeg.generate_ = [base, nodeNum](size_t first, size_t num, char *out) {
+            int64_t *v = reinterpret_cast<int64_t *>(out);
+            for (size_t j = 0; j < num; ++j)
+                v[j] = base + static_cast<int64_t>(first + j + 1) * nodeNum;
+        };
+        offsets.segs_.push_back(offSeg);
+        offsets.bytes_ += offSeg.bytes_;
+        base += static_cast<int64_t>(cellNums[i]) * nodeNum;
+
+        VTUSegment typeSeg;
+        typeSeg.bytes_ = cellNums[i];
+        unsigned char vtkType = cellVTKType[k];
+        typeSeg.generate_ = [vtkType](size_t, size_t num, char *out) { std::memset(out, vtkType, num); };
+        types.segs_.push_back(typeSeg);
+        types.bytes_ += typeSeg.bytes_;
+    }
+
+    std::vector<VTUArray *> arrays;
+    for (auto &a : pointData)
+        arrays.push_back(&a);
+    for (auto &a : cellData)
+        arrays.push_back(&a);
+    arrays.push_back(&points);
+    arrays.push_back(&conn);
+    arrays.push_back(&offsets);
+    arrays.push_back(&types);
+
+    VTKCompressor compressor = ComVTUCompressorAvailable(opts.compressor_) ? opts.compressor_ : VTKCompressor::NONE;
+    size_t blockSize = static_cast<size_t>(std::max(4096, opts.blockSize_)) / 8 * 8;
+    int threadNum = ComThreadNum(opts.threadNum_);
+    s.compressor_ = compressor;
+    s.fallback_ = compressor != opts.compressor_;
+    s.pointNum_ = static_cast<long long>(pointNum);
+    s.cellNum_ = static_cast<long long>(cellNum);
+    s.arrayNum_ = static_cast<int>(arrays.size());
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+        return 1;
+
+    // XML 部分，DataArray 的 offset 先写定宽占位符
+    const uint16_t probe = 1;
+    bool little = *reinterpret_cast<const unsigned char *>(&probe) == 1;
+    file << "<?xml version=\"1.0\"?>\n";
+    file << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << (little ? "LittleEndian" : "BigEndian")
+         << "\" header_type=\"UInt64\"";
+    if (compressor == VTKCompressor::ZLIB)
+        file << " compressor=\"vtkZLibDataCompressor\"";
+    else if (compressor == VTKCompressor::LZ4)
+        file << " compressor=\"vtkLZ4DataCompressor\"";
+    file << ">\n";
+    file << "  <UnstructuredGrid>\n";
+    file << "    <Piece NumberOfPoints=\"" << pointNum << "\" NumberOfCells=\"" << cellNum << "\">\n";
+    auto writeTag = [&file](VTUArray &a) {
+        file << "        <DataArray type=\"" << a.type_ << "\"";
+        if (!a.name_.empty())
+            file << " Name=\"" << a.name_ << "\"";
+        file << " NumberOfComponents=\"" << a.compNum_ << "\" format=\"appended\" offset=\"";
+        a.offsetPos_ = static_cast<std::streamoff>(file.tellp());
+        file << std::string(ComVTUOffsetWidth, '0') << "\"/>\n";
+    };
+    file << "      <PointData>\n";
+    for (auto &a : pointData)
+        writeTag(a);
+    file << "      </PointData>\n";
+    file << "      <CellData>\n";
+    for (auto &a : cellData)
+        writeTag(a);
+    file << "      </CellData>\n";
+    file << "      <Points>\n";
+    writeTag(points);
+    file << "      </Points>\n";
+    file << "      <Cells>\n";
+    writeTag(conn);
+    writeTag(offsets);
+    writeTag(types);
+    file << "      </Cells>\n";
+    file << "    </Piece>\n";
+    file << "  </UnstructuredGrid>\n";
+    file << "  <AppendedData encoding=\"raw\">\n   _";
+    std::streamoff appendStart = static_cast<std::streamoff>(file.tellp());
+
+    // appended 数据
+    int window = compressor == VTKCompressor::NONE ? 1 : 2 * threadNum;
+    size_t bound = ComVTUCompressBound(compressor, blockSize);
+    std::vector<std::vector<char>> inBuf(window, std::vector<char>(blockSize));
+    std::vector<std::vector<char>> outBuf(compressor == VTKCompressor::NONE ? 0 : window, std::vector<char>(bound));
+    std::vector<size_t> outSize(window, 0);
+    int status = 0;
+    for (VTUArray *a : arrays)
+    {
+        a->offset_ = static_cast<uint64_t>(static_cast<std::streamoff>(file.tellp()) - appendStart);
+        size_t blockNum = (a->bytes_ + blockSize - 1) / blockSize;
+        s.rawBytes_ += static_cast<long long>(a->bytes_);
+
+        if (compressor == VTKCompressor::NONE)
+        {
+            uint64_t header = a->bytes_;
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            for (size_t b = 0; b < blockNum; ++b)
+            {
+                size_t size = std::min(blockSize, a->bytes_ - b * blockSize);
+                file.write(ComVTUBlock(*a, b * blockSize, size, inBuf[0].data()), static_cast<std::streamsize>(size));
+            }
+            continue;
+        }
+
+        // 块头：块数、块大小、最后一块大小（整块时为 0）、各块压缩后大小
+        std::vector<uint64_t> header(3 + blockNum, 0);
+        header[0] = blockNum;
+        header[1] = blockSize;
+        header[2] = a->bytes_ % blockSize;
+        std::streamoff headerPos = static_cast<std::streamoff>(file.tellp());
+        file.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size() * sizeof(uint64_t)));
+
+        for (size_t w0 = 0; w0 < blockNum && status == 0; w0 += window)
+        {
+            int wn = static_cast<int>(std::min(static_cast<size_t>(window), blockNum - w0));
+            auto t0 = std::chrono::steady_clock::now();
+            std::atomic<int> cursor(0);
+            std::atomic<bool> failed(false);
+            ComParallelFor(0, std::min(threadNum, wn), threadNum, [&](int, int, int) {
+                for (int i = cursor.fetch_add(1); i < wn; i = cursor.fetch_add(1))
+                {
+                    size_t b = w0 + i;
+                    size_t size = std::min(blockSize, a->bytes_ - b * blockSize);
+                    const char *src = ComVTUBlock(*a, b * blockSize, size, inBuf[i].data());
+                    outSize[i] = ComVTUCompress(compressor, opts.compressLevel_, src, size, outBuf[i].data(), bound);
+                    if (outSize[i] == 0)
+                        failed.store(true);
+                }
+            });
+            s.compressSeconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            if (failed.load())
+            {
+                status = 3;
+                break;
+            }
+            for (int i = 0; i < wn; ++i)
+            {
+                header[3 + w0 + i] = outSize[i];
+                file.write(outBuf[i].data(), static_cast<std::streamsize>(outSize[i]));
+            }
+            s.blockNum_ += wn;
+        }
+        if (status != 0)
+            break;
+
+        std::streamoff endPos = static_cast<std::streamoff>(file.tellp());
+        file.seekp(headerPos);
+        file.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size() * sizeof(uint64_t)));
+        file.seekp(endPos);
+    }
+    if (status != 0)
+        return status;
+
+    s.dataBytes_ = static_cast<long long>(static_cast<std::streamoff>(file.tellp()) - appendStart);
+    file << "\n  </AppendedData>\n";
+    file << "</VTKFile>\n";
+
+    // 回填 offset
+    for (VTUArray *a : arrays)
+    {
+        char digits[ComVTUOffsetWidth + 1];
+        std::snprintf(digits, sizeof(digits), "%0*llu", ComVTUOffsetWidth, static_cast<unsigned long long>(a->offset_));
+        file.seekp(a->offsetPos_);
+        file.write(digits, ComVTUOffsetWidth);
+    }
+    file.close();
+    if (file.fail())
+        return 4;
+
+    s.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (stat)
+        *stat = s;
+    return 0;
+}
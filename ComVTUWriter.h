@@ -0,0 +1,55 @@
+// Copyright (c) 2024, 电子科技大学电子科学与工程学院，计算机仿真技术实验室
+// All rights reserved.
+// 文件名称：ComVTUWriter.h
+// 摘    要：VTK XML 非结构网格（.vtu）二进制输出：appended raw 编码，数据按块并行压缩（zlib / LZ4），
+//           坐标、单元顶点编号与属性直接从 TypedVectorHolder 缓冲区分块读取，不复制整个数组
+// 当前版本：1.0
+// 作    者：邓龙威
+// 完成日期：2025年10月20日
+
+#ifndef EMMPMESH_COMMON_COMVTUWRITER_H_
+#define EMMPMESH_COMMON_COMVTUWRITER_H_
+
+#include "ComConstants.h"
+
+#include <string>
+
+// .vtu 输出统计
+struct VTUWriteStat
+{
+    VTKCompressor compressor_ = VTKCompressor::NONE; // 实际使用的压缩方式
+    bool fallback_ = false;                          // 所选压缩库未编译，改为不压缩
+    long long pointNum_ = 0;                         // 顶点个数
+    long long cellNum_ = 0;                          // 单元个数
+    int arrayNum_ = 0;                               // DataArray 个数
+    long long blockNum_ = 0;                         // 压缩块个数
+    long long rawBytes_ = 0;                         // appended 数据压缩前字节数
+    long long dataBytes_ = 0;                        // appended 数据写入字节数（含块头）
+    double compressSeconds_ = 0.;                    // 压缩耗时（秒）
+    double seconds_ = 0.;                            // 总耗时（秒）
+};
+
+/************************************************************************
+* 功能描述：压缩方式是否已编译（EMMPMESH_WITH_ZLIB / EMMPMESH_WITH_LZ4），NONE 总是可用
+* 返回值：bool
+* 作者：邓龙威
+/************************************************************************/
+bool ComVTUCompressorAvailable(VTKCompressor compressor);
+
+/************************************************************************
+* 功能描述：以 appended raw 编码写出 .vtu 文件（header_type 为 UInt64）。
+*           1. 单元类型取 opts.meshEleOut_ 中的 Edge / Face / Region（为空时取 Region，没有则取 Face），
+*              多种类型按 Edge、Face、Region 顺序拼接；connectivity 为 Int32，offsets 为 Int64，
+*              offsets 与 types 按块生成；
+*           2. 属性取 opts.meshAttrOut_（为空时取 attr 中顶点与输出单元类型的全部属性），
+*              Int 为 Int32、Dbl 为 Float64，分量数由数据长度确定，缺少任一输出单元类型数据的单元属性跳过；
+*           3. 压缩时每个 DataArray 按 blockSize_ 分块，每 2 × 线程数个块为一个窗口并行压缩后顺序写出，
+*              块头与 XML 中的 offset 先写占位再回填，内存占用与网格规模无关；不压缩时直接写出缓冲区。
+*           所选压缩库未编译时不压缩，stat 中记录实际使用的压缩方式并置 fallback_
+* 返回值：0 表示成功，非 0 表示失败（1-文件无法打开，2-缺少顶点，3-压缩失败，4-写入失败）
+* 作者：邓龙威
+/************************************************************************/
+int ComWriteVTU(const std::string &filePath, const Mesh &mesh, const MeshAttr *attr, const MeshVTKIOOptions &opts,
+                VTUWriteStat *stat = nullptr);
+
+#endif // EMMPMESH_COMMON_COMVTUWRITER_H_